@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "time.hpp"
+
+using namespace std::chrono;
+
+TEST(Clock, virtualOnlyMovesWhenTold) {
+    const RJ::Time start = RJ::Time(seconds(1000));
+    RJ::VirtualClock clock(start);
+    EXPECT_EQ(start, clock.now());
+
+    clock.sleepUntil(start + 50ms);
+    EXPECT_EQ(start + 50ms, clock.now());
+
+    // Sleeping until a time that has passed doesn't go back
+    clock.sleepUntil(start);
+    EXPECT_EQ(start + 50ms, clock.now());
+
+    clock.advance(RJ::Seconds(0.25));
+    EXPECT_EQ(start + 300ms, clock.now());
+
+    clock.set(start);
+    EXPECT_EQ(start, clock.now());
+}
+
+TEST(Clock, setClock) {
+    const RJ::Time start = RJ::Time(seconds(1000));
+    RJ::VirtualClock clock(start);
+
+    RJ::setClock(&clock);
+    EXPECT_EQ(start, RJ::now());
+    EXPECT_EQ(RJ::timestamp(start), RJ::timestamp());
+
+    // A loop sleeping out its period doesn't wait in real time
+    const auto realStart = steady_clock::now();
+    for (int i = 0; i < 600; i++) {
+        RJ::sleepUntil(RJ::now() + RJ::Seconds(1) / 60);
+    }
+    EXPECT_LT(steady_clock::now() - realStart, 1s);
+    EXPECT_NEAR(10, RJ::numSeconds(RJ::now() - start), 1e-6);
+
+    RJ::setClock(nullptr);
+    EXPECT_EQ(&RJ::realTimeClock(), &RJ::clock());
+}
+
+TEST(Clock, realTime) {
+    RJ::RealTimeClock clock;
+
+    // On the system clock's epoch
+    EXPECT_LT(abs(RJ::numSeconds(clock.now() - system_clock::now())), 1.0);
+
+    RJ::Time last = clock.now();
+    for (int i = 0; i < 1000; i++) {
+        RJ::Time t = clock.now();
+        EXPECT_GE(t, last);
+        last = t;
+    }
+
+    const RJ::Time wake = clock.now() + 10ms;
+    clock.sleepUntil(wake);
+    EXPECT_GE(clock.now(), wake);
+}
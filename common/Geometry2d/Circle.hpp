@@ -22,6 +22,7 @@ public:
     Circle(const Circle& other) {
         center = other.center;
         _r = other.radius();
+        _rsq = other._rsq;
     }
 
     Shape* clone() const override;
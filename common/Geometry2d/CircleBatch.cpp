@@ -0,0 +1,288 @@
+#include "CircleBatch.hpp"
+#include <Constants.hpp>
+
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace Geometry2d {
+
+namespace {
+
+// Each Lanes type wraps one register of floats and the handful of operations
+// the kernels need, so every kernel is written once and compiled for the
+// widest instruction set available.
+
+struct ScalarLanes {
+    static constexpr size_t Width = 1;
+    using Mask = bool;
+
+    float v;
+
+    static ScalarLanes load(const float* p) { return {*p}; }
+    static ScalarLanes set(float f) { return {f}; }
+    static ScalarLanes index(size_t i) { return {static_cast<float>(i)}; }
+
+    friend ScalarLanes operator+(ScalarLanes a, ScalarLanes b) {
+        return {a.v + b.v};
+    }
+    friend ScalarLanes operator-(ScalarLanes a, ScalarLanes b) {
+        return {a.v - b.v};
+    }
+    friend ScalarLanes operator*(ScalarLanes a, ScalarLanes b) {
+        return {a.v * b.v};
+    }
+    friend ScalarLanes min(ScalarLanes a, ScalarLanes b) {
+        return {b.v < a.v ? b.v : a.v};
+    }
+    friend ScalarLanes max(ScalarLanes a, ScalarLanes b) {
+        return {b.v > a.v ? b.v : a.v};
+    }
+    friend ScalarLanes sqrt(ScalarLanes a) { return {std::sqrt(a.v)}; }
+
+    friend Mask lessEqual(ScalarLanes a, ScalarLanes b) { return a.v <= b.v; }
+    friend Mask less(ScalarLanes a, ScalarLanes b) { return a.v < b.v; }
+    friend ScalarLanes select(Mask m, ScalarLanes a, ScalarLanes b) {
+        return m ? a : b;
+    }
+    static int bits(Mask m) { return m; }
+
+    void store(float* p) const { *p = v; }
+};
+
+#if defined(__AVX2__)
+struct Lanes {
+    static constexpr size_t Width = 8;
+    using Mask = __m256;
+
+    __m256 v;
+
+    static Lanes load(const float* p) { return {_mm256_loadu_ps(p)}; }
+    static Lanes set(float f) { return {_mm256_set1_ps(f)}; }
+    static Lanes index(size_t i) {
+        const float f = i;
+        return {_mm256_setr_ps(f, f + 1, f + 2, f + 3, f + 4, f + 5, f + 6,
+                               f + 7)};
+    }
+
+    friend Lanes operator+(Lanes a, Lanes b) {
+        return {_mm256_add_ps(a.v, b.v)};
+    }
+    friend Lanes operator-(Lanes a, Lanes b) {
+        return {_mm256_sub_ps(a.v, b.v)};
+    }
+    friend Lanes operator*(Lanes a, Lanes b) {
+        return {_mm256_mul_ps(a.v, b.v)};
+    }
+    friend Lanes min(Lanes a, Lanes b) { return {_mm256_min_ps(a.v, b.v)}; }
+    friend Lanes max(Lanes a, Lanes b) { return {_mm256_max_ps(a.v, b.v)}; }
+    friend Lanes sqrt(Lanes a) { return {_mm256_sqrt_ps(a.v)}; }
+
+    friend Mask lessEqual(Lanes a, Lanes b) {
+        return _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ);
+    }
+    friend Mask less(Lanes a, Lanes b) {
+        return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ);
+    }
+    friend Lanes select(Mask m, Lanes a, Lanes b) {
+        return {_mm256_blendv_ps(b.v, a.v, m)};
+    }
+    static int bits(Mask m) { return _mm256_movemask_ps(m); }
+
+    void store(float* p) const { _mm256_storeu_ps(p, v); }
+};
+#elif defined(__SSE2__)
+struct Lanes {
+    static constexpr size_t Width = 4;
+    using Mask = __m128;
+
+    __m128 v;
+
+    static Lanes load(const float* p) { return {_mm_loadu_ps(p)}; }
+    static Lanes set(float f) { return {_mm_set1_ps(f)}; }
+    static Lanes index(size_t i) {
+        const float f = i;
+        return {_mm_setr_ps(f, f + 1, f + 2, f + 3)};
+    }
+
+    friend Lanes operator+(Lanes a, Lanes b) { return {_mm_add_ps(a.v, b.v)}; }
+    friend Lanes operator-(Lanes a, Lanes b) { return {_mm_sub_ps(a.v, b.v)}; }
+    friend Lanes operator*(Lanes a, Lanes b) { return {_mm_mul_ps(a.v, b.v)}; }
+    friend Lanes min(Lanes a, Lanes b) { return {_mm_min_ps(a.v, b.v)}; }
+    friend Lanes max(Lanes a, Lanes b) { return {_mm_max_ps(a.v, b.v)}; }
+    friend Lanes sqrt(Lanes a) { return {_mm_sqrt_ps(a.v)}; }
+
+    friend Mask lessEqual(Lanes a, Lanes b) { return _mm_cmple_ps(a.v, b.v); }
+    friend Mask less(Lanes a, Lanes b) { return _mm_cmplt_ps(a.v, b.v); }
+    friend Lanes select(Mask m, Lanes a, Lanes b) {
+        // SSE2 has no blend instruction
+        return {_mm_or_ps(_mm_and_ps(m, a.v), _mm_andnot_ps(m, b.v))};
+    }
+    static int bits(Mask m) { return _mm_movemask_ps(m); }
+
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+};
+#else
+using Lanes = ScalarLanes;
+#endif
+
+static_assert(CircleBatch::Padding % Lanes::Width == 0,
+              "The circle arrays must fill whole registers");
+
+/// Hit test of a point against the circles starting at index i
+struct PointQuery {
+    Lanes x, y;
+
+    explicit PointQuery(Point pt)
+        : x(Lanes::set(pt.x())), y(Lanes::set(pt.y())) {}
+
+    Lanes::Mask hits(const float* cx, const float* cy, const float* r,
+                     size_t i) const {
+        const Lanes dx = Lanes::load(cx + i) - x;
+        const Lanes dy = Lanes::load(cy + i) - y;
+        const Lanes hitRadius = Lanes::load(r + i) + Lanes::set(Robot_Radius);
+        return lessEqual(dx * dx + dy * dy, hitRadius * hitRadius);
+    }
+};
+
+/// Hit test of a segment against the circles starting at index i
+struct SegmentQuery {
+    // Segment start, direction, and the inverse of the direction's squared
+    // length (zero for a degenerate segment, which makes it a point)
+    Lanes x, y, dx, dy, invLengthSq;
+
+    explicit SegmentQuery(const Segment& seg)
+        : x(Lanes::set(seg.pt[0].x())), y(Lanes::set(seg.pt[0].y())) {
+        const Point delta = seg.delta();
+        const float deltaX = delta.x();
+        const float deltaY = delta.y();
+        const float lengthSq = deltaX * deltaX + deltaY * deltaY;
+        dx = Lanes::set(deltaX);
+        dy = Lanes::set(deltaY);
+        invLengthSq = Lanes::set(lengthSq > 0 ? 1 / lengthSq : 0);
+    }
+
+    Lanes::Mask hits(const float* cx, const float* cy, const float* r,
+                     size_t i) const {
+        const Lanes px = Lanes::load(cx + i) - x;
+        const Lanes py = Lanes::load(cy + i) - y;
+
+        // Nearest point on the segment, as a fraction of its length
+        const Lanes t = min(
+            max((px * dx + py * dy) * invLengthSq, Lanes::set(0)),
+            Lanes::set(1));
+        const Lanes ex = px - dx * t;
+        const Lanes ey = py - dy * t;
+        const Lanes hitRadius = Lanes::load(r + i) + Lanes::set(Robot_Radius);
+        return lessEqual(ex * ex + ey * ey, hitRadius * hitRadius);
+    }
+};
+
+template <typename Query>
+bool anyHit(const Query& query, const float* cx, const float* cy,
+            const float* r, size_t count) {
+    for (size_t i = 0; i < count; i += Lanes::Width) {
+        if (Lanes::bits(query.hits(cx, cy, r, i))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Query>
+void appendHits(const Query& query, const float* cx, const float* cy,
+                const float* r, size_t count, std::vector<uint32_t>* hits,
+                uint32_t offset) {
+    for (size_t i = 0; i < count; i += Lanes::Width) {
+        int bits = Lanes::bits(query.hits(cx, cy, r, i));
+        while (bits) {
+            const int lane = __builtin_ctz(bits);
+            hits->push_back(offset + i + lane);
+            bits &= bits - 1;
+        }
+    }
+}
+
+}  // namespace
+
+void CircleBatch::add(Point center, float radius) {
+    if (_count == _x.size()) {
+        // Far enough away that no query hits them or finds them nearest, but
+        // close enough that squaring their coordinates doesn't overflow
+        const float far = 1e18f;
+        _x.resize(_count + Padding, far);
+        _y.resize(_count + Padding, far);
+        _r.resize(_count + Padding, 0);
+    }
+
+    _x[_count] = center.x();
+    _y[_count] = center.y();
+    _r[_count] = radius;
+    _count++;
+}
+
+bool CircleBatch::hit(Point pt) const {
+    return anyHit(PointQuery(pt), _x.data(), _y.data(), _r.data(), _x.size());
+}
+
+bool CircleBatch::hit(const Segment& seg) const {
+    return anyHit(SegmentQuery(seg), _x.data(), _y.data(), _r.data(),
+                  _x.size());
+}
+
+void CircleBatch::hitIndices(Point pt, std::vector<uint32_t>* hits,
+                             uint32_t offset) const {
+    appendHits(PointQuery(pt), _x.data(), _y.data(), _r.data(), _x.size(),
+               hits, offset);
+}
+
+void CircleBatch::hitIndices(const Segment& seg, std::vector<uint32_t>* hits,
+                             uint32_t offset) const {
+    appendHits(SegmentQuery(seg), _x.data(), _y.data(), _r.data(), _x.size(),
+               hits, offset);
+}
+
+float CircleBatch::nearestDistance(Point pt, int* index) const {
+    const Lanes x = Lanes::set(pt.x());
+    const Lanes y = Lanes::set(pt.y());
+    const Lanes step = Lanes::set(Lanes::Width);
+
+    // Nearest circle seen by each lane
+    Lanes best = Lanes::set(std::numeric_limits<float>::infinity());
+    Lanes bestAt = Lanes::set(-1);
+    Lanes at = Lanes::index(0);
+    for (size_t i = 0; i < _x.size(); i += Lanes::Width) {
+        const Lanes dx = Lanes::load(&_x[i]) - x;
+        const Lanes dy = Lanes::load(&_y[i]) - y;
+        const Lanes distance = sqrt(dx * dx + dy * dy) - Lanes::load(&_r[i]);
+        const Lanes::Mask closer = less(distance, best);
+        best = select(closer, distance, best);
+        bestAt = select(closer, at, bestAt);
+        at = at + step;
+    }
+
+    float lanes[Lanes::Width];
+    float lanesAt[Lanes::Width];
+    best.store(lanes);
+    bestAt.store(lanesAt);
+    float bestDistance = lanes[0];
+    float bestIndex = lanesAt[0];
+    for (size_t lane = 1; lane < Lanes::Width; lane++) {
+        // Ties go to the lower index, as in a scalar loop
+        const bool closer =
+            lanes[lane] < bestDistance ||
+            (lanes[lane] == bestDistance && lanesAt[lane] < bestIndex);
+        bestDistance = closer ? lanes[lane] : bestDistance;
+        bestIndex = closer ? lanesAt[lane] : bestIndex;
+    }
+
+    if (index) {
+        *index = static_cast<int>(bestIndex);
+    }
+    return bestDistance;
+}
+
+}  // namespace Geometry2d
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Circle.hpp"
+#include "Point.hpp"
+#include "Segment.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Geometry2d {
+
+/**
+ * A set of circles stored as separate arrays of center x, center y and
+ * radius, so that one query can be tested against several circles at once
+ * with SIMD instructions.
+ *
+ * The kernels use AVX2 or SSE2 when the compiler targets them (release builds
+ * use -march=native) and plain loops otherwise.  Coordinates are single
+ * precision, so results can differ from Circle::hit() for queries within a
+ * few micrometers of a circle's boundary.
+ *
+ * The arrays are padded to a multiple of Padding with circles far outside the
+ * field, so the kernels always work on whole registers.
+ *
+ * hit() has the same meaning as Circle::hit(): the query comes within one
+ * robot radius of the circle.
+ */
+class CircleBatch {
+public:
+    /// The arrays' length is always a multiple of this many circles
+    static constexpr size_t Padding = 8;
+
+    CircleBatch() {}
+
+    size_t size() const { return _count; }
+
+    bool empty() const { return _count == 0; }
+
+    void add(const Circle& circle) { add(circle.center, circle.radius()); }
+
+    void add(Point center, float radius);
+
+    /// Remove all circles, keeping the arrays' memory
+    void clear() {
+        _count = 0;
+        _x.clear();
+        _y.clear();
+        _r.clear();
+    }
+
+    /// Returns the circle at @index
+    Circle circle(size_t index) const {
+        return Circle(Point(_x[index], _y[index]), _r[index]);
+    }
+
+    /// True if @pt is within one robot radius of any circle
+    bool hit(Point pt) const;
+
+    /// True if @seg comes within one robot radius of any circle
+    bool hit(const Segment& seg) const;
+
+    /**
+     * Appends the index plus @offset of every circle that @obj hits to @hits,
+     * in increasing order.
+     */
+    void hitIndices(Point pt, std::vector<uint32_t>* hits,
+                    uint32_t offset = 0) const;
+    void hitIndices(const Segment& seg, std::vector<uint32_t>* hits,
+                    uint32_t offset = 0) const;
+
+    /**
+     * Distance from @pt to the edge of the nearest circle, which is negative
+     * if @pt is inside it.
+     *
+     * @param index If not null, set to the index of the nearest circle, or -1
+     *     if the batch is empty
+     * @return The distance, or infinity if the batch is empty
+     */
+    float nearestDistance(Point pt, int* index = nullptr) const;
+
+private:
+    size_t _count = 0;
+
+    // Center and radius of each circle, followed by padding
+    std::vector<float> _x;
+    std::vector<float> _y;
+    std::vector<float> _r;
+};
+
+}  // namespace Geometry2d
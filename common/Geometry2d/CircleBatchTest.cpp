@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "Circle.hpp"
+#include "CircleBatch.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Geometry2d;
+using namespace std;
+
+namespace {
+
+Point randomPoint(mt19937& rng) {
+    uniform_real_distribution<float> x(-3.0f, 3.0f);
+    uniform_real_distribution<float> y(0.0f, 9.0f);
+    return Point(x(rng), y(rng));
+}
+
+vector<Circle> randomCircles(mt19937& rng, int count) {
+    uniform_real_distribution<float> radius(0.02f, 0.5f);
+    vector<Circle> circles;
+    for (int i = 0; i < count; i++) {
+        circles.emplace_back(randomPoint(rng), radius(rng));
+    }
+    return circles;
+}
+
+CircleBatch makeBatch(const vector<Circle>& circles) {
+    CircleBatch batch;
+    for (const Circle& circle : circles) {
+        batch.add(circle);
+    }
+    return batch;
+}
+
+}  // namespace
+
+TEST(CircleBatch, empty) {
+    CircleBatch batch;
+    EXPECT_TRUE(batch.empty());
+    EXPECT_FALSE(batch.hit(Point(0, 0)));
+    EXPECT_FALSE(batch.hit(Segment(Point(0, 0), Point(1, 1))));
+
+    int index = 0;
+    EXPECT_TRUE(std::isinf(batch.nearestDistance(Point(0, 0), &index)));
+    EXPECT_EQ(-1, index);
+}
+
+// Every size up to a few registers wide, so the last register is anywhere
+// from full to almost all padding, which must never hit or be nearest
+TEST(CircleBatch, matchesCircleHit) {
+    mt19937 rng(0);
+    for (int count = 0; count < 20; count++) {
+        const vector<Circle> circles = randomCircles(rng, count);
+        const CircleBatch batch = makeBatch(circles);
+        ASSERT_EQ(circles.size(), batch.size());
+
+        for (int q = 0; q < 200; q++) {
+            const Point pt = randomPoint(rng);
+            Point end = randomPoint(rng);
+            if (q % 10 == 0) {
+                // Degenerate segment
+                end = pt;
+            }
+            const Segment seg(pt, end);
+
+            vector<uint32_t> pointHits;
+            vector<uint32_t> segmentHits;
+            for (uint32_t i = 0; i < circles.size(); i++) {
+                if (circles[i].hit(pt)) {
+                    pointHits.push_back(i + 100);
+                }
+                if (circles[i].hit(seg)) {
+                    segmentHits.push_back(i + 100);
+                }
+            }
+
+            EXPECT_EQ(!pointHits.empty(), batch.hit(pt));
+            EXPECT_EQ(!segmentHits.empty(), batch.hit(seg));
+
+            vector<uint32_t> hits;
+            batch.hitIndices(pt, &hits, 100);
+            EXPECT_EQ(pointHits, hits);
+
+            hits.clear();
+            batch.hitIndices(seg, &hits, 100);
+            EXPECT_EQ(segmentHits, hits);
+        }
+    }
+}
+
+TEST(CircleBatch, nearestDistance) {
+    mt19937 rng(1);
+    for (int count = 1; count < 20; count++) {
+        const vector<Circle> circles = randomCircles(rng, count);
+        const CircleBatch batch = makeBatch(circles);
+
+        for (int q = 0; q < 50; q++) {
+            const Point pt = randomPoint(rng);
+
+            float expected = INFINITY;
+            for (const Circle& circle : circles) {
+                expected = min(expected, static_cast<float>(
+                                             pt.distTo(circle.center) -
+                                             circle.radius()));
+            }
+
+            int index = -1;
+            const float distance = batch.nearestDistance(pt, &index);
+            EXPECT_NEAR(expected, distance, 1e-5);
+            ASSERT_GE(index, 0);
+            ASSERT_LT(index, count);
+            EXPECT_NEAR(expected,
+                        pt.distTo(circles[index].center) -
+                            circles[index].radius(),
+                        1e-5);
+        }
+    }
+
+    CircleBatch batch;
+    batch.add(Point(0, 0), 1);
+    EXPECT_NEAR(-0.5, batch.nearestDistance(Point(0.5, 0)), 1e-6);
+}
@@ -209,7 +209,7 @@ public:
      * Called deltaFixed because it operates fixed to the origin frame.
      */
     Pose deltaFixed(double t) const {
-        return Pose(linear().x(), linear().y(), angular());
+        return Pose(linear() * t, angular() * t);
     }
 
     /**
@@ -146,6 +146,15 @@ TEST(Twist, ExponentialMapping) {
     }
 }
 
+TEST(Twist, FixedMapping) {
+    // Linear velocity stays fixed in the world frame while turning
+    Twist twist(Point(1, 2), 1);
+    Pose applied = twist.deltaFixed(0.5);
+    EXPECT_NEAR(applied.position().x(), 0.5, 1e-6);
+    EXPECT_NEAR(applied.position().y(), 1, 1e-6);
+    EXPECT_NEAR(applied.heading(), 0.5, 1e-6);
+}
+
 TEST(Twist, Curvature) {
     // Standard
     {
@@ -0,0 +1,239 @@
+#include <benchmark/benchmark.h>
+#include "Circle.hpp"
+#include "CircleBatch.hpp"
+#include "CompositeShape.hpp"
+#include "Polygon.hpp"
+#include "Rect.hpp"
+#include "ShapeSet.hpp"
+
+#include <Constants.hpp>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Geometry2d;
+using namespace std;
+
+namespace {
+
+// Query points and segments are drawn from a fixed seed so runs are comparable
+constexpr int NumQueries = 1024;
+
+Point randomPoint(mt19937& rng) {
+    uniform_real_distribution<float> x(-3.0f, 3.0f);
+    uniform_real_distribution<float> y(0.0f, 9.0f);
+    return Point(x(rng), y(rng));
+}
+
+vector<Point> makePoints() {
+    mt19937 rng(0);
+    vector<Point> points;
+    for (int i = 0; i < NumQueries; i++) {
+        points.push_back(randomPoint(rng));
+    }
+    return points;
+}
+
+vector<Segment> makeSegments() {
+    mt19937 rng(1);
+    vector<Segment> segments;
+    for (int i = 0; i < NumQueries; i++) {
+        Point a = randomPoint(rng);
+        segments.emplace_back(a, a + (randomPoint(rng) - a) * 0.2f);
+    }
+    return segments;
+}
+
+/// Robot-sized circles scattered over the field, as the planner sees them
+ShapeSet makeObstacleField(int count) {
+    mt19937 rng(2);
+    ShapeSet set;
+    for (int i = 0; i < count; i++) {
+        set.add(Circle(randomPoint(rng), Robot_Radius));
+    }
+    set.add(make_shared<Rect>(Point(-1, 0), Point(1, 1)));
+    set.add(make_shared<Rect>(Point(-1, 8), Point(1, 9)));
+    return set;
+}
+
+vector<Circle> makeCircles(int count) {
+    mt19937 rng(2);
+    vector<Circle> circles;
+    for (int i = 0; i < count; i++) {
+        circles.emplace_back(randomPoint(rng), Robot_Radius);
+    }
+    return circles;
+}
+
+template <typename Query>
+void runHits(benchmark::State& state, const Shape& shape,
+             const vector<Query>& queries) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(shape.hit(queries[i++ % queries.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+static void BM_CircleHitPoint(benchmark::State& state) {
+    runHits(state, Circle(Point(0, 4.5), 1), makePoints());
+}
+BENCHMARK(BM_CircleHitPoint);
+
+static void BM_CircleHitSegment(benchmark::State& state) {
+    runHits(state, Circle(Point(0, 4.5), 1), makeSegments());
+}
+BENCHMARK(BM_CircleHitSegment);
+
+static void BM_PolygonHitPoint(benchmark::State& state) {
+    Polygon polygon(vector<Point>{Point(-1, 3), Point(1, 3), Point(1.5, 5),
+                                  Point(0, 6), Point(-1.5, 5)});
+    runHits(state, polygon, makePoints());
+}
+BENCHMARK(BM_PolygonHitPoint);
+
+static void BM_PolygonHitSegment(benchmark::State& state) {
+    Polygon polygon(vector<Point>{Point(-1, 3), Point(1, 3), Point(1.5, 5),
+                                  Point(0, 6), Point(-1.5, 5)});
+    runHits(state, polygon, makeSegments());
+}
+BENCHMARK(BM_PolygonHitSegment);
+
+static void BM_CompositeShapeHitPoint(benchmark::State& state) {
+    mt19937 rng(3);
+    CompositeShape composite;
+    for (int i = 0; i < state.range(0); i++) {
+        composite.add(make_shared<Circle>(randomPoint(rng), Robot_Radius));
+    }
+    runHits(state, composite, makePoints());
+}
+BENCHMARK(BM_CompositeShapeHitPoint)->Arg(6)->Arg(12)->Arg(24);
+
+// ShapeSet queries, with and without the grid index from buildIndex()
+static void BM_ShapeSetHitPoint(benchmark::State& state) {
+    ShapeSet set = makeObstacleField(state.range(0));
+    if (state.range(1)) {
+        set.buildIndex();
+    }
+    const vector<Point> points = makePoints();
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(set.hit(points[i++ % points.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ShapeSetHitPoint)
+    ->ArgNames({"obstacles", "indexed"})
+    ->ArgsProduct({{12, 24, 48}, {0, 1}});
+
+static void BM_ShapeSetHitSegment(benchmark::State& state) {
+    ShapeSet set = makeObstacleField(state.range(0));
+    if (state.range(1)) {
+        set.buildIndex();
+    }
+    const vector<Segment> segments = makeSegments();
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(set.hit(segments[i++ % segments.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ShapeSetHitSegment)
+    ->ArgNames({"obstacles", "indexed"})
+    ->ArgsProduct({{12, 24, 48}, {0, 1}});
+
+static void BM_ShapeSetBuildIndex(benchmark::State& state) {
+    ShapeSet set = makeObstacleField(state.range(0));
+    for (auto _ : state) {
+        set.buildIndex();
+    }
+}
+BENCHMARK(BM_ShapeSetBuildIndex)->Arg(12)->Arg(24)->Arg(48);
+
+// The same robot circles tested one at a time with Circle::hit() and together
+// with CircleBatch
+template <typename Query>
+void runCircleLoop(benchmark::State& state, const vector<Query>& queries) {
+    const vector<Circle> circles = makeCircles(state.range(0));
+    size_t i = 0;
+    for (auto _ : state) {
+        const Query& query = queries[i++ % queries.size()];
+        bool hit = false;
+        for (const Circle& circle : circles) {
+            if (circle.hit(query)) {
+                hit = true;
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(hit);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Query>
+void runCircleBatch(benchmark::State& state, const vector<Query>& queries) {
+    CircleBatch batch;
+    for (const Circle& circle : makeCircles(state.range(0))) {
+        batch.add(circle);
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(batch.hit(queries[i++ % queries.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_CircleLoopHitPoint(benchmark::State& state) {
+    runCircleLoop(state, makePoints());
+}
+BENCHMARK(BM_CircleLoopHitPoint)->Arg(12)->Arg(24)->Arg(48);
+
+static void BM_CircleBatchHitPoint(benchmark::State& state) {
+    runCircleBatch(state, makePoints());
+}
+BENCHMARK(BM_CircleBatchHitPoint)->Arg(12)->Arg(24)->Arg(48);
+
+static void BM_CircleLoopHitSegment(benchmark::State& state) {
+    runCircleLoop(state, makeSegments());
+}
+BENCHMARK(BM_CircleLoopHitSegment)->Arg(12)->Arg(24)->Arg(48);
+
+static void BM_CircleBatchHitSegment(benchmark::State& state) {
+    runCircleBatch(state, makeSegments());
+}
+BENCHMARK(BM_CircleBatchHitSegment)->Arg(12)->Arg(24)->Arg(48);
+
+static void BM_CircleLoopNearestDistance(benchmark::State& state) {
+    const vector<Circle> circles = makeCircles(state.range(0));
+    const vector<Point> points = makePoints();
+    size_t i = 0;
+    for (auto _ : state) {
+        const Point pt = points[i++ % points.size()];
+        float best = numeric_limits<float>::infinity();
+        for (const Circle& circle : circles) {
+            best = min(best, static_cast<float>(pt.distTo(circle.center) -
+                                                circle.radius()));
+        }
+        benchmark::DoNotOptimize(best);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CircleLoopNearestDistance)->Arg(12)->Arg(24)->Arg(48);
+
+static void BM_CircleBatchNearestDistance(benchmark::State& state) {
+    CircleBatch batch;
+    for (const Circle& circle : makeCircles(state.range(0))) {
+        batch.add(circle);
+    }
+    const vector<Point> points = makePoints();
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            batch.nearestDistance(points[i++ % points.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CircleBatchNearestDistance)->Arg(12)->Arg(24)->Arg(48);
@@ -0,0 +1,147 @@
+#include "ShapeSet.hpp"
+#include "Circle.hpp"
+#include "CompositeShape.hpp"
+#include "Polygon.hpp"
+#include <Constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Geometry2d {
+
+namespace {
+
+// Upper bound on the number of cells along one axis so that a set containing a
+// very large shape doesn't produce a huge grid
+constexpr int MaxCellsPerAxis = 64;
+
+// Margin added to every bound to absorb float rounding in the hit tests
+constexpr float BoundsEpsilon = 1e-3f;
+
+/**
+ * Computes a rect that contains every point or segment that can "hit" the
+ * given shape.
+ *
+ * @return False if the shape type is unknown and can't be bounded
+ */
+bool hitBounds(const Shape& shape, Rect* out) {
+    if (auto circle = dynamic_cast<const Circle*>(&shape)) {
+        const float r = circle->radius() + Robot_Radius;
+        *out = Rect(circle->center - Point(r, r), circle->center + Point(r, r));
+    } else if (auto rect = dynamic_cast<const Rect*>(&shape)) {
+        *out = Rect(Point(rect->minx(), rect->miny()),
+                    Point(rect->maxx(), rect->maxy()));
+        out->pad(Robot_Radius);
+    } else if (auto polygon = dynamic_cast<const Polygon*>(&shape)) {
+        if (polygon->vertices.empty()) {
+            return false;
+        }
+        *out = polygon->bbox();
+        out->pad(Robot_Radius);
+    } else if (auto composite = dynamic_cast<const CompositeShape*>(&shape)) {
+        if (composite->size() == 0) {
+            return false;
+        }
+        for (unsigned int i = 0; i < composite->size(); i++) {
+            Rect sub;
+            if (!hitBounds(*composite->subshapes()[i], &sub)) {
+                return false;
+            }
+            if (i == 0) {
+                *out = sub;
+            } else {
+                out->expand(sub);
+            }
+        }
+        return true;
+    } else {
+        return false;
+    }
+
+    out->pad(BoundsEpsilon);
+    return true;
+}
+
+}  // namespace
+
+void ShapeSet::buildIndex(float cellSize) {
+    invalidateIndex();
+
+    const uint32_t count = size();
+    _shapeBounds.resize(count);
+    std::vector<bool> bounded(count, false);
+    bool haveBounds = false;
+    for (uint32_t i = 0; i < count; i++) {
+        if (!hitBounds(shape(i), &_shapeBounds[i])) {
+            _unindexed.push_back(i);
+            continue;
+        }
+        bounded[i] = true;
+
+        if (haveBounds) {
+            _gridBounds.expand(_shapeBounds[i]);
+        } else {
+            _gridBounds = _shapeBounds[i];
+            haveBounds = true;
+        }
+    }
+    _indexed = true;
+
+    if (!haveBounds) {
+        return;
+    }
+
+    const float width = _gridBounds.maxx() - _gridBounds.minx();
+    const float height = _gridBounds.maxy() - _gridBounds.miny();
+    _cellSize = std::max({cellSize, width / MaxCellsPerAxis,
+                          height / MaxCellsPerAxis});
+    _cols = std::max(1, static_cast<int>(std::ceil(width / _cellSize)));
+    _rows = std::max(1, static_cast<int>(std::ceil(height / _cellSize)));
+
+    // Counting sort of (cell, shape) pairs into a flat array
+    _cellStart.assign(_cols * _rows + 1, 0);
+    for (uint32_t i = 0; i < count; i++) {
+        if (!bounded[i]) {
+            continue;
+        }
+        int x0, y0, x1, y1;
+        cellRange(_shapeBounds[i], &x0, &y0, &x1, &y1);
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                _cellStart[y * _cols + x + 1]++;
+            }
+        }
+    }
+    for (size_t c = 1; c < _cellStart.size(); c++) {
+        _cellStart[c] += _cellStart[c - 1];
+    }
+
+    _cellItems.resize(_cellStart.back());
+    std::vector<uint32_t> fill(_cellStart.begin(), _cellStart.end() - 1);
+    for (uint32_t i = 0; i < count; i++) {
+        if (!bounded[i]) {
+            continue;
+        }
+        int x0, y0, x1, y1;
+        cellRange(_shapeBounds[i], &x0, &y0, &x1, &y1);
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                _cellItems[fill[y * _cols + x]++] = i;
+            }
+        }
+    }
+}
+
+void ShapeSet::cellRange(const Rect& bounds, int* x0, int* y0, int* x1,
+                         int* y1) const {
+    auto clampCell = [](float v, int count) {
+        return std::min(std::max(static_cast<int>(std::floor(v)), 0),
+                        count - 1);
+    };
+    *x0 = clampCell((bounds.minx() - _gridBounds.minx()) / _cellSize, _cols);
+    *x1 = clampCell((bounds.maxx() - _gridBounds.minx()) / _cellSize, _cols);
+    *y0 = clampCell((bounds.miny() - _gridBounds.miny()) / _cellSize, _rows);
+    *y1 = clampCell((bounds.maxy() - _gridBounds.miny()) / _cellSize, _rows);
+}
+
+}  // namespace Geometry2d
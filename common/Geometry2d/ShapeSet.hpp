@@ -1,7 +1,13 @@
 #pragma once
 
+#include "Circle.hpp"
+#include "CircleBatch.hpp"
+#include "Rect.hpp"
+#include "Segment.hpp"
 #include "Shape.hpp"
 
+#include <cassert>
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <sstream>
@@ -9,7 +15,25 @@
 
 namespace Geometry2d {
 
-/// This class maintains a collection of Shape objects.
+/**
+ * This class maintains a collection of Shape objects.
+ *
+ * Circles and rects, which are most of the obstacles made every frame, can be
+ * added by value.  They are kept in contiguous arrays and tested without
+ * virtual calls, and clearing the set keeps the arrays' memory for the next
+ * frame.  Other shapes are shared with whoever else holds them.  The circles
+ * are also mirrored into a CircleBatch so that unindexed queries test them
+ * several at a time.
+ *
+ * Each shape has an id from 0 to size() - 1, which shape() maps back to the
+ * shape.  Ids stay the same until the set is modified.
+ *
+ * Collision queries are a linear scan over the contained shapes by default.
+ * Calling buildIndex() once the set is fully populated (typically once per
+ * frame before planning) buckets the shapes into a uniform grid so that point
+ * and segment queries only test shapes whose bounds are nearby. Any call to
+ * add() or clear() drops the index again.
+ */
 class ShapeSet {
 public:
     ShapeSet() {}
@@ -23,35 +47,124 @@ public:
         }
     }
 
-    std::vector<std::shared_ptr<Shape>> shapes() { return _shapes; }
-    const std::vector<std::shared_ptr<Shape>> shapes() const { return _shapes; }
+    /// Shapes that were added by pointer
+    const std::vector<std::shared_ptr<Shape>>& shapes() const {
+        return _shapes;
+    }
+
+    /// Circles that were added by value
+    const std::vector<Circle>& circles() const { return _circles; }
+
+    /// The circles() as a CircleBatch, in the same order
+    const CircleBatch& circleBatch() const { return _circleBatch; }
+
+    /// Rects that were added by value
+    const std::vector<Rect>& rects() const { return _rects; }
+
+    /// Number of shapes of every kind
+    size_t size() const {
+        return _shapes.size() + _circles.size() + _rects.size();
+    }
+
+    bool empty() const { return size() == 0; }
+
+    /// Returns the shape with the given id
+    const Shape& shape(uint32_t id) const {
+        if (id < _shapes.size()) {
+            return *_shapes[id];
+        }
+        id -= _shapes.size();
+        if (id < _circles.size()) {
+            return _circles[id];
+        }
+        return _rects[id - _circles.size()];
+    }
 
     void add(std::shared_ptr<Shape> shape) {
         assert(shape != nullptr);
-        _shapes.push_back(shape);
+        _shapes.push_back(std::move(shape));
+        invalidateIndex();
+    }
+
+    void add(const Circle& circle) {
+        _circles.push_back(circle);
+        _circleBatch.add(circle);
+        invalidateIndex();
+    }
+
+    void add(const Rect& rect) {
+        _rects.push_back(rect);
+        invalidateIndex();
     }
 
     void add(const ShapeSet& other) {
-        for (auto shape : other.shapes()) {
-            add(shape);
+        _shapes.insert(_shapes.end(), other._shapes.begin(),
+                       other._shapes.end());
+        _circles.insert(_circles.end(), other._circles.begin(),
+                        other._circles.end());
+        for (const Circle& circle : other._circles) {
+            _circleBatch.add(circle);
         }
+        _rects.insert(_rects.end(), other._rects.begin(), other._rects.end());
+        invalidateIndex();
     }
 
     /// Remove all shapes
-    void clear() { _shapes.clear(); }
+    void clear() {
+        _shapes.clear();
+        _circles.clear();
+        _circleBatch.clear();
+        _rects.clear();
+        invalidateIndex();
+    }
 
     /**
-     * Get a set of which shapes "hit" the given object.
+     * Bucket the current shapes into a uniform grid used to accelerate hit
+     * queries. Shapes whose hit bounds can't be determined are always tested.
+     *
+     * @param cellSize Side length of a grid cell in meters
+     */
+    void buildIndex(float cellSize = 0.5f);
+
+    /// True if buildIndex() has been called since the last modification
+    bool hasIndex() const { return _indexed; }
+
+    /**
+     * Call @pred on each shape that might hit @obj until it returns true.
+     * With an index built, only shapes in grid cells overlapping @obj are
+     * visited (a shape may be visited more than once); otherwise every shape
+     * is visited. No allocation is performed.
+     *
+     * @param obj The Point or Segment being queried
+     * @param pred Callable taking a const Shape& and returning bool
+     * @return True if @pred returned true for any visited shape
+     */
+    template <typename T, typename Pred>
+    bool anyCandidate(const T& obj, Pred&& pred) const {
+        return anyCandidateId(
+            obj, [this, &pred](uint32_t id) { return pred(shape(id)); });
+    }
+
+    /**
+     * Get the ids of the shapes that "hit" the given object.
      *
      * @param obj The object to collision test
-     * @return A set of all shapes that collide with the given object
+     * @return The ids of all shapes that collide with the given object, in
+     *     increasing order
      */
     template <typename T>
-    std::set<std::shared_ptr<Shape>> hitSet(const T& obj) const {
-        std::set<std::shared_ptr<Shape>> hits;
-        for (const auto& shape : _shapes) {
-            if (shape->hit(obj)) {
-                hits.insert(shape);
+    std::vector<uint32_t> hitSet(const T& obj) const {
+        std::vector<uint32_t> hits;
+        for (uint32_t id = 0; id < _shapes.size(); id++) {
+            if (_shapes[id]->hit(obj)) {
+                hits.push_back(id);
+            }
+        }
+        _circleBatch.hitIndices(obj, &hits, _shapes.size());
+        const uint32_t rectStart = _shapes.size() + _circles.size();
+        for (uint32_t i = 0; i < _rects.size(); i++) {
+            if (_rects[i].Rect::hit(obj)) {
+                hits.push_back(rectStart + i);
             }
         }
         return hits;
@@ -65,7 +178,39 @@ public:
      */
     template <typename T>
     bool hit(const T& obj) const {
-        return !hitSet<T>(obj).empty();
+        if (_indexed) {
+            return anyCandidateId(
+                obj, [this, &obj](uint32_t id) { return hit(id, obj); });
+        }
+
+        // Without an index, test each kind of shape in one pass over its array
+        if (_circleBatch.hit(obj)) {
+            return true;
+        }
+        for (const Rect& rect : _rects) {
+            if (rect.Rect::hit(obj)) {
+                return true;
+            }
+        }
+        for (const auto& shape : _shapes) {
+            if (shape->hit(obj)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Check if the shape with the given id "hits" @obj
+    template <typename T>
+    bool hit(uint32_t id, const T& obj) const {
+        if (id < _shapes.size()) {
+            return _shapes[id]->hit(obj);
+        }
+        id -= _shapes.size();
+        if (id < _circles.size()) {
+            return _circles[id].Circle::hit(obj);
+        }
+        return _rects[id - _circles.size()].Rect::hit(obj);
     }
 
     friend std::ostream& operator<<(std::ostream& out,
@@ -74,12 +219,97 @@ public:
         for (const auto& shape : shapeSet.shapes()) {
             out << shape->toString() << ", ";
         }
+        for (Circle circle : shapeSet.circles()) {
+            out << circle.toString() << ", ";
+        }
+        for (Rect rect : shapeSet.rects()) {
+            out << rect.toString() << ", ";
+        }
         out << "}";
         return out;
     }
 
 private:
+    /// Like anyCandidate(), but calls @pred with shape ids
+    template <typename T, typename Pred>
+    bool anyCandidateId(const T& obj, Pred&& pred) const {
+        if (!_indexed) {
+            for (uint32_t id = 0; id < size(); id++) {
+                if (pred(id)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        for (uint32_t id : _unindexed) {
+            if (pred(id)) {
+                return true;
+            }
+        }
+
+        Rect bounds = queryBounds(obj);
+        if (_cellStart.empty() || !_gridBounds.intersects(bounds)) {
+            return false;
+        }
+
+        int x0, y0, x1, y1;
+        cellRange(bounds, &x0, &y0, &x1, &y1);
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                const int cell = y * _cols + x;
+                for (uint32_t j = _cellStart[cell]; j < _cellStart[cell + 1];
+                     j++) {
+                    const uint32_t id = _cellItems[j];
+                    if (_shapeBounds[id].intersects(bounds) && pred(id)) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    static Rect queryBounds(Point pt) { return Rect(pt); }
+
+    static Rect queryBounds(const Segment& seg) {
+        return Rect(seg.pt[0], seg.pt[1]);
+    }
+
+    void invalidateIndex() {
+        if (_indexed) {
+            _indexed = false;
+            _shapeBounds.clear();
+            _unindexed.clear();
+            _cellStart.clear();
+            _cellItems.clear();
+        }
+    }
+
+    /// Grid cell indices (clamped to the grid) covered by @bounds
+    void cellRange(const Rect& bounds, int* x0, int* y0, int* x1,
+                   int* y1) const;
+
+    // Shapes by id: _shapes, then _circles, then _rects
     std::vector<std::shared_ptr<Shape>> _shapes;
+    std::vector<Circle> _circles;
+    CircleBatch _circleBatch;
+    std::vector<Rect> _rects;
+
+    // Broad-phase index, only valid while _indexed is true
+    bool _indexed = false;
+    float _cellSize = 0;
+    int _cols = 0;
+    int _rows = 0;
+    Rect _gridBounds;
+    // Padded hit bounds of each shape, by id
+    std::vector<Rect> _shapeBounds;
+    // Shapes that are tested on every query
+    std::vector<uint32_t> _unindexed;
+    // Shape indices bucketed by cell: cell c holds
+    // _cellItems[_cellStart[c] .. _cellStart[c + 1])
+    std::vector<uint32_t> _cellStart;
+    std::vector<uint32_t> _cellItems;
 };
 
 }  // namespace Geometry2d
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "Circle.hpp"
+#include "CompositeShape.hpp"
+#include "Polygon.hpp"
+#include "Rect.hpp"
+#include "ShapeSet.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+using namespace Geometry2d;
+using namespace std;
+
+namespace {
+
+ShapeSet makeObstacleField() {
+    ShapeSet set;
+    for (int i = 0; i < 20; i++) {
+        set.add(make_shared<Circle>(Point(-4 + 0.4 * i, 3 + 0.3 * (i % 5)),
+                                    0.09));
+    }
+    set.add(make_shared<Rect>(Point(-1, 7), Point(1, 8)));
+    set.add(make_shared<Polygon>(
+        vector<Point>{Point(3, 1), Point(4, 1), Point(3.5, 2)}));
+
+    auto composite = make_shared<CompositeShape>();
+    composite->add(make_shared<Circle>(Point(-3, 0), 0.5));
+    composite->add(make_shared<Rect>(Point(2, 5), Point(3, 6)));
+    set.add(composite);
+
+    return set;
+}
+
+}  // namespace
+
+TEST(ShapeSet, hit) {
+    ShapeSet set;
+    set.add(make_shared<Circle>(Point(0, 0), 1));
+    set.add(make_shared<Rect>(Point(3, 3), Point(4, 4)));
+
+    EXPECT_TRUE(set.hit(Point(0.5, 0)));
+    EXPECT_TRUE(set.hit(Point(3.5, 3.5)));
+    EXPECT_FALSE(set.hit(Point(2, -2)));
+    EXPECT_TRUE(set.hit(Segment(Point(-2, 0), Point(2, 0))));
+    EXPECT_FALSE(set.hit(Segment(Point(-2, 2), Point(-2, 4))));
+}
+
+TEST(ShapeSet, indexInvalidatedOnModify) {
+    ShapeSet set;
+    set.add(make_shared<Circle>(Point(0, 0), 1));
+    set.buildIndex();
+    EXPECT_TRUE(set.hasIndex());
+    EXPECT_FALSE(set.hit(Point(5, 5)));
+
+    set.add(make_shared<Circle>(Point(5, 5), 1));
+    EXPECT_FALSE(set.hasIndex());
+    EXPECT_TRUE(set.hit(Point(5, 5)));
+
+    set.buildIndex();
+    EXPECT_TRUE(set.hit(Point(5, 5)));
+
+    set.clear();
+    EXPECT_FALSE(set.hasIndex());
+    EXPECT_FALSE(set.hit(Point(5, 5)));
+}
+
+TEST(ShapeSet, indexMatchesLinearScan) {
+    const ShapeSet linear = makeObstacleField();
+    ShapeSet indexed = linear;
+    indexed.buildIndex(0.25f);
+    ASSERT_TRUE(indexed.hasIndex());
+
+    srand(42);
+    auto randomPoint = []() {
+        return Point(10.0 * rand() / RAND_MAX - 5, 10.0 * rand() / RAND_MAX);
+    };
+
+    for (int i = 0; i < 2000; i++) {
+        Point pt = randomPoint();
+        EXPECT_EQ(linear.hit(pt), indexed.hit(pt)) << pt;
+
+        Segment seg(pt, randomPoint());
+        EXPECT_EQ(linear.hit(seg), indexed.hit(seg)) << seg;
+    }
+}
+
+TEST(ShapeSet, valueShapes) {
+    ShapeSet set;
+    set.add(make_shared<Polygon>(
+        vector<Point>{Point(3, 1), Point(4, 1), Point(3.5, 2)}));
+    set.add(Circle(Point(0, 0), 1));
+    set.add(Rect(Point(-4, -4), Point(-3, -3)));
+    ASSERT_EQ(set.size(), 3);
+
+    // Ids are pointer shapes, then circles, then rects
+    EXPECT_NE(dynamic_cast<const Polygon*>(&set.shape(0)), nullptr);
+    EXPECT_NE(dynamic_cast<const Circle*>(&set.shape(1)), nullptr);
+    EXPECT_NE(dynamic_cast<const Rect*>(&set.shape(2)), nullptr);
+
+    EXPECT_TRUE(set.hit(Point(0.5, 0)));
+    EXPECT_TRUE(set.hit(Point(-3.5, -3.5)));
+    EXPECT_FALSE(set.hit(Point(2, -2)));
+
+    EXPECT_EQ(set.hitSet(Point(0.5, 0)), vector<uint32_t>{1});
+    EXPECT_EQ(set.hitSet(Segment(Point(-4, -3.5), Point(3.5, 1.5))),
+              (vector<uint32_t>{0, 1, 2}));
+
+    set.buildIndex();
+    EXPECT_TRUE(set.hit(Point(-3.5, -3.5)));
+    EXPECT_FALSE(set.hit(Point(2, -2)));
+
+    ShapeSet copy;
+    copy.add(set);
+    EXPECT_EQ(copy.size(), 3);
+    EXPECT_TRUE(copy.hit(Point(0.5, 0)));
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.hit(Point(0.5, 0)));
+}
+
+TEST(ShapeSet, valueIndexMatchesLinearScan) {
+    ShapeSet linear = makeObstacleField();
+    for (int i = 0; i < 20; i++) {
+        linear.add(Circle(Point(-4 + 0.4 * i, 1 + 0.3 * (i % 5)), 0.09));
+    }
+    linear.add(Rect(Point(-2, 4), Point(-1.5, 6)));
+
+    ShapeSet indexed = linear;
+    indexed.buildIndex(0.25f);
+
+    srand(7);
+    auto randomPoint = []() {
+        return Point(10.0 * rand() / RAND_MAX - 5, 10.0 * rand() / RAND_MAX);
+    };
+
+    for (int i = 0; i < 2000; i++) {
+        Point pt = randomPoint();
+        EXPECT_EQ(linear.hit(pt), indexed.hit(pt)) << pt;
+
+        Segment seg(pt, randomPoint());
+        EXPECT_EQ(linear.hit(seg), indexed.hit(seg)) << seg;
+    }
+}
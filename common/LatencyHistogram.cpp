@@ -0,0 +1,46 @@
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+void LatencyHistogram::add(int64_t microseconds) {
+    microseconds = std::max<int64_t>(microseconds, 0);
+    const size_t i =
+        std::min<size_t>(microseconds / BucketWidth, NumBuckets - 1);
+
+    // There is only one writer, so plain stores are enough
+    _buckets[i].store(_buckets[i].load(memory_order_relaxed) + 1,
+                      memory_order_relaxed);
+    if (microseconds > _max.load(memory_order_relaxed)) {
+        _max.store(microseconds, memory_order_relaxed);
+    }
+    _count.store(_count.load(memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+int64_t LatencyHistogram::percentile(double p) const {
+    const uint64_t total = count();
+    if (total == 0) {
+        return 0;
+    }
+
+    const uint64_t rank =
+        std::max<uint64_t>(1, static_cast<uint64_t>(ceil(p / 100 * total)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < NumBuckets - 1; i++) {
+        seen += bucket(i);
+        if (seen >= rank) {
+            return std::min<int64_t>((i + 1) * BucketWidth, max());
+        }
+    }
+    return max();
+}
+
+void LatencyHistogram::clear() {
+    for (auto& bucket : _buckets) {
+        bucket.store(0, memory_order_relaxed);
+    }
+    _max.store(0, memory_order_relaxed);
+    _count.store(0, memory_order_relaxed);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Distribution of durations in fixed-width buckets, for latencies that are
+ * watched while they are being recorded.
+ *
+ * add() must only be called from one thread, but every other function may be
+ * called from any thread at the same time.  Readers may see a count that is
+ * one add() ahead of or behind the buckets.
+ */
+class LatencyHistogram {
+public:
+    /// Width of each bucket, in microseconds
+    static constexpr int64_t BucketWidth = 250;
+
+    /// The buckets cover 0 to 100ms.  The last one also counts anything
+    /// longer.
+    static constexpr size_t NumBuckets = 400;
+
+    LatencyHistogram() = default;
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /// Adds a duration in microseconds.  Negative durations count as zero.
+    void add(int64_t microseconds);
+
+    /// Number of durations added
+    uint64_t count() const { return _count.load(std::memory_order_relaxed); }
+
+    /// Number of durations in bucket @i, which starts at i * BucketWidth
+    uint64_t bucket(size_t i) const {
+        return _buckets[i].load(std::memory_order_relaxed);
+    }
+
+    /// Longest duration added, in microseconds
+    int64_t max() const { return _max.load(std::memory_order_relaxed); }
+
+    /**
+     * Upper bound on the @p'th percentile (0-100) in microseconds: the end of
+     * the bucket it falls in, or max() if that is smaller.  Zero if nothing
+     * has been added.
+     */
+    int64_t percentile(double p) const;
+
+    /// Starts over.  Must not be called at the same time as add().
+    void clear();
+
+private:
+    std::array<std::atomic<uint64_t>, NumBuckets> _buckets{};
+    std::atomic<uint64_t> _count{0};
+    std::atomic<int64_t> _max{0};
+};
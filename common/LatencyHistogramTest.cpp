@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include "LatencyHistogram.hpp"
+
+TEST(LatencyHistogram, percentiles) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(0, histogram.percentile(50));
+
+    // 1ms to 100ms in 1ms steps
+    for (int i = 1; i <= 100; i++) {
+        histogram.add(i * 1000);
+    }
+    EXPECT_EQ(100, histogram.count());
+    EXPECT_EQ(100000, histogram.max());
+
+    // Each percentile is rounded up to the end of its bucket
+    EXPECT_EQ(50250, histogram.percentile(50));
+    EXPECT_EQ(99250, histogram.percentile(99));
+    EXPECT_EQ(100000, histogram.percentile(100));
+}
+
+TEST(LatencyHistogram, outOfRange) {
+    LatencyHistogram histogram;
+    histogram.add(-5);
+    histogram.add(1000000);
+
+    EXPECT_EQ(1, histogram.bucket(0));
+    EXPECT_EQ(1, histogram.bucket(LatencyHistogram::NumBuckets - 1));
+    EXPECT_EQ(1000000, histogram.percentile(100));
+
+    histogram.clear();
+    EXPECT_EQ(0, histogram.count());
+    EXPECT_EQ(0, histogram.bucket(0));
+    EXPECT_EQ(0, histogram.max());
+}
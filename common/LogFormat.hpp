@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * On-disk format of LogFrame logs.
+ *
+ * A plain log is a sequence of frames, each stored as a native-endian uint32
+ * length followed by a serialized LogFrame.
+ *
+ * A compressed log starts with a LogFileHeader and is followed by chunks.
+ * Each chunk is a LogChunkHeader followed by a zstd frame which decompresses
+ * to a run of frames in the plain format.  Consecutive frames are mostly the
+ * same (vision wrappers, debug drawing), so compressing many of them together
+ * is far more effective than compressing each one.
+ *
+ * The first word of a plain log is a frame length, which is never as large as
+ * LogFileMagic, so the two formats can be told apart by the first four bytes.
+ *
+ * The index (stored next to the log as <log>.idx) is an 8 byte header
+ * (LogIndexMagic, LogIndexVersion) followed by one LogIndexEntry per frame.
+ */
+
+struct LogFileHeader {
+    uint32_t magic;
+    uint32_t version;
+};
+static_assert(sizeof(LogFileHeader) == 8, "LogFileHeader must be packed");
+
+constexpr uint32_t LogFileMagic = 0x5a4c4a52;  // "RJLZ"
+constexpr uint32_t LogFileVersion = 1;
+
+struct LogChunkHeader {
+    /// Size of the compressed data following this header
+    uint32_t compressedSize;
+    /// Size of the data after decompression
+    uint32_t rawSize;
+    /// Number of frames in the chunk
+    uint32_t frames;
+    uint32_t reserved;
+};
+static_assert(sizeof(LogChunkHeader) == 16, "LogChunkHeader must be packed");
+
+/// Number of frames a writer puts in one chunk (one second at 60Hz)
+constexpr uint32_t LogChunkFrames = 60;
+
+/// A chunk is written early if it grows past this many uncompressed bytes
+constexpr uint32_t LogChunkMaxBytes = 8 << 20;
+
+/// Largest uncompressed chunk a reader accepts.  The frame that fills a chunk
+/// can take it past LogChunkMaxBytes, but writers don't log frames larger than
+/// LogChunkMaxBytes.
+constexpr uint32_t LogChunkMaxRawBytes = 2 * LogChunkMaxBytes;
+
+struct LogIndexEntry {
+    /// Byte offset of the frame's length prefix in the log file, or of the
+    /// LogChunkHeader of the frame's chunk in a compressed log
+    uint64_t offset;
+    /// LogFrame::timestamp() of the frame
+    uint64_t timestamp;
+    /// Size of the serialized frame, not including the length prefix
+    uint32_t size;
+    /// Offset of the frame's length prefix in the decompressed chunk.
+    /// Always zero in a plain log.
+    uint32_t chunkOffset;
+};
+static_assert(sizeof(LogIndexEntry) == 24, "LogIndexEntry must be packed");
+
+constexpr uint32_t LogIndexMagic = 0x494c4a52;  // "RJLI"
+constexpr uint32_t LogIndexVersion = 2;
+
+/// Filename of the index belonging to a log file
+inline std::string logIndexFilename(const std::string& logFilename) {
+    return logFilename + ".idx";
+}
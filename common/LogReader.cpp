@@ -0,0 +1,490 @@
+#include "LogReader.hpp"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zstd.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+using namespace Packet;
+using google::protobuf::internal::WireFormatLite;
+
+namespace {
+
+/// Reads LogFrame::timestamp out of a serialized frame without parsing the
+/// rest of it
+uint64_t peekTimestamp(const uint8_t* data, uint32_t size) {
+    google::protobuf::io::CodedInputStream input(data, size);
+    while (uint32_t tag = input.ReadTag()) {
+        if (WireFormatLite::GetTagFieldNumber(tag) ==
+                LogFrame::kTimestampFieldNumber &&
+            WireFormatLite::GetTagWireType(tag) ==
+                WireFormatLite::WIRETYPE_VARINT) {
+            uint64_t timestamp = 0;
+            input.ReadVarint64(&timestamp);
+            return timestamp;
+        }
+        if (!WireFormatLite::SkipField(&input, tag)) {
+            break;
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+LogReader::LogReader(size_t cacheCapacity)
+    : _cacheCapacity(std::max<size_t>(cacheCapacity, 1)) {}
+
+LogReader::~LogReader() { close(); }
+
+bool LogReader::open(const string& filename) {
+    close();
+
+    _fd = ::open(filename.c_str(), O_RDONLY);
+    if (_fd < 0) {
+        fprintf(stderr, "Can't open %s: %m\n", filename.c_str());
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(_fd, &st) != 0) {
+        fprintf(stderr, "Can't stat %s: %m\n", filename.c_str());
+        close();
+        return false;
+    }
+    _length = st.st_size;
+
+    if (_length > 0) {
+        void* data = mmap(nullptr, _length, PROT_READ, MAP_PRIVATE, _fd, 0);
+        if (data == MAP_FAILED) {
+            fprintf(stderr, "Can't map %s: %m\n", filename.c_str());
+            close();
+            return false;
+        }
+        _data = static_cast<const uint8_t*>(data);
+    } else {
+        // Keep isOpen() true for an empty log
+        static const uint8_t empty = 0;
+        _data = &empty;
+    }
+
+    LogFileHeader fileHeader = {0, 0};
+    if (_length >= sizeof(fileHeader)) {
+        memcpy(&fileHeader, _data, sizeof(fileHeader));
+    }
+    _compressed = fileHeader.magic == LogFileMagic;
+    if (_compressed && fileHeader.version != LogFileVersion) {
+        fprintf(stderr, "%s: Unsupported log version %u\n", filename.c_str(),
+                fileHeader.version);
+        close();
+        return false;
+    }
+
+    const string indexFilename = logIndexFilename(filename);
+    const bool haveIndex = loadIndex(indexFilename);
+    const size_t indexed = _index.size();
+
+    bool ok;
+    if (_compressed) {
+        uint64_t offset = sizeof(LogFileHeader);
+        if (!_index.empty()) {
+            // Rescan the last chunk unless the index has all of its frames
+            const uint64_t last = _index.back().offset;
+            LogChunkHeader header;
+            readChunkHeader(last, &header);
+
+            size_t first = _index.size();
+            while (first > 0 && _index[first - 1].offset == last) {
+                first--;
+            }
+
+            if (_index.size() - first == header.frames) {
+                offset = last + sizeof(header) + header.compressedSize;
+            } else {
+                _index.resize(first);
+                offset = last;
+            }
+        }
+        ok = scanChunksFrom(offset);
+    } else {
+        uint64_t offset = 0;
+        if (!_index.empty()) {
+            offset =
+                _index.back().offset + sizeof(uint32_t) + _index.back().size;
+        }
+        ok = scanFrom(offset);
+    }
+    if (!haveIndex || _index.size() != indexed) {
+        saveIndex(indexFilename);
+    }
+
+    return ok;
+}
+
+void LogReader::close() {
+    {
+        lock_guard<mutex> lock(_cacheMutex);
+        _lru.clear();
+        _cache.clear();
+        _chunks.clear();
+        _spaceUsed = 0;
+    }
+
+    if (_data && _length > 0) {
+        munmap(const_cast<uint8_t*>(_data), _length);
+    }
+    _data = nullptr;
+    _length = 0;
+
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+
+    _compressed = false;
+    _index.clear();
+}
+
+bool LogReader::loadIndex(const string& indexFilename) {
+    _index.clear();
+
+    int fd = ::open(indexFilename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    uint32_t header[2] = {0, 0};
+    struct stat st;
+    bool valid = fstat(fd, &st) == 0 &&
+                 read(fd, header, sizeof(header)) == sizeof(header) &&
+                 header[0] == LogIndexMagic && header[1] == LogIndexVersion;
+
+    if (valid) {
+        const size_t count =
+            (st.st_size - sizeof(header)) / sizeof(LogIndexEntry);
+        _index.resize(count);
+        const ssize_t bytes = count * sizeof(LogIndexEntry);
+        valid = read(fd, _index.data(), bytes) == bytes;
+    }
+    ::close(fd);
+
+    // The index may belong to a truncated log, or to a different log that was
+    // copied over this one
+    if (valid && !indexMatchesLog()) {
+        fprintf(stderr, "%s doesn't match its log, rebuilding it\n",
+                indexFilename.c_str());
+        valid = false;
+    }
+
+    if (!valid) {
+        _index.clear();
+    }
+    return valid;
+}
+
+void LogReader::saveIndex(const string& indexFilename) const {
+    int fd = creat(indexFilename.c_str(), 0666);
+    if (fd < 0) {
+        // The index is only a cache, so a read-only directory is fine
+        return;
+    }
+
+    const uint32_t header[2] = {LogIndexMagic, LogIndexVersion};
+    const ssize_t bytes = _index.size() * sizeof(LogIndexEntry);
+    if (write(fd, header, sizeof(header)) != sizeof(header) ||
+        write(fd, _index.data(), bytes) != bytes) {
+        fprintf(stderr, "LogReader: Failed to write %s: %m\n",
+                indexFilename.c_str());
+        ::close(fd);
+        unlink(indexFilename.c_str());
+        return;
+    }
+    ::close(fd);
+}
+
+bool LogReader::indexMatchesLog() const {
+    if (!_compressed) {
+        // Frames are back to back from the start of the file, and each length
+        // prefix must match its entry
+        uint64_t offset = 0;
+        for (const LogIndexEntry& entry : _index) {
+            uint32_t size = 0;
+            if (entry.offset != offset || entry.chunkOffset != 0 ||
+                offset + sizeof(size) > _length) {
+                return false;
+            }
+            memcpy(&size, _data + offset, sizeof(size));
+            if (size != entry.size || offset + sizeof(size) + size > _length) {
+                return false;
+            }
+            offset += sizeof(size) + size;
+        }
+        return true;
+    }
+
+    // Chunks are back to back from the end of the file header, and each one
+    // holds header.frames consecutive entries that fill header.rawSize.  Only
+    // chunk headers are read, so nothing is decompressed.  The last chunk may
+    // be partly indexed.
+    uint64_t offset = sizeof(LogFileHeader);
+    size_t i = 0;
+    while (i < _index.size()) {
+        LogChunkHeader header;
+        if (!readChunkHeader(offset, &header) ||
+            offset + sizeof(header) + header.compressedSize > _length) {
+            return false;
+        }
+
+        uint64_t pos = 0;
+        uint32_t frames = 0;
+        for (; frames < header.frames && i < _index.size(); frames++) {
+            const LogIndexEntry& entry = _index[i++];
+            if (entry.offset != offset || entry.chunkOffset != pos ||
+                pos + sizeof(uint32_t) + entry.size > header.rawSize) {
+                return false;
+            }
+            pos += sizeof(uint32_t) + entry.size;
+        }
+        if (frames == header.frames && pos != header.rawSize) {
+            return false;
+        }
+
+        offset += sizeof(header) + header.compressedSize;
+    }
+    return true;
+}
+
+bool LogReader::readChunkHeader(uint64_t offset,
+                                LogChunkHeader* header) const {
+    if (offset < sizeof(LogFileHeader) || offset + sizeof(*header) > _length) {
+        *header = LogChunkHeader();
+        return false;
+    }
+    // Chunks aren't aligned, so copy the header out
+    memcpy(header, _data + offset, sizeof(*header));
+    return true;
+}
+
+LogReader::Chunk LogReader::decompressChunk(uint64_t offset) const {
+    LogChunkHeader header;
+    if (!readChunkHeader(offset, &header) ||
+        offset + sizeof(header) + header.compressedSize > _length) {
+        return nullptr;
+    }
+
+    // Check the size against the zstd frame before allocating, so a corrupt
+    // header can't ask for gigabytes
+    const uint8_t* compressed = _data + offset + sizeof(header);
+    const unsigned long long contentSize =
+        ZSTD_getFrameContentSize(compressed, header.compressedSize);
+    if (header.rawSize > LogChunkMaxRawBytes ||
+        contentSize != header.rawSize) {
+        fprintf(stderr, "Bad chunk size at %lu: %u bytes\n",
+                (unsigned long)offset, header.rawSize);
+        return nullptr;
+    }
+
+    auto raw = make_shared<string>(header.rawSize, '\0');
+    const size_t size = ZSTD_decompress(&(*raw)[0], raw->size(), compressed,
+                                        header.compressedSize);
+    if (ZSTD_isError(size) || size != header.rawSize) {
+        fprintf(stderr, "Failed to decompress chunk at %lu: %s\n",
+                (unsigned long)offset,
+                ZSTD_isError(size) ? ZSTD_getErrorName(size) : "wrong size");
+        return nullptr;
+    }
+    return raw;
+}
+
+LogReader::Chunk LogReader::chunk(uint64_t offset) const {
+    auto find = [&]() {
+        return find_if(_chunks.begin(), _chunks.end(),
+                       [&](const pair<uint64_t, Chunk>& c) {
+                           return c.first == offset;
+                       });
+    };
+
+    {
+        lock_guard<mutex> lock(_cacheMutex);
+        auto cached = find();
+        if (cached != _chunks.end()) {
+            _chunks.splice(_chunks.begin(), _chunks, cached);
+            return cached->second;
+        }
+    }
+
+    Chunk raw = decompressChunk(offset);
+    if (!raw) {
+        return nullptr;
+    }
+
+    lock_guard<mutex> lock(_cacheMutex);
+    auto cached = find();
+    if (cached != _chunks.end()) {
+        _chunks.splice(_chunks.begin(), _chunks, cached);
+        return cached->second;
+    }
+
+    _chunks.emplace_front(offset, raw);
+    _spaceUsed += raw->size();
+    while (_chunks.size() > ChunkCacheCapacity) {
+        _spaceUsed -= _chunks.back().second->size();
+        _chunks.pop_back();
+    }
+    return raw;
+}
+
+bool LogReader::scanChunksFrom(uint64_t offset) {
+    while (offset < _length) {
+        LogChunkHeader header;
+        if (!readChunkHeader(offset, &header) ||
+            offset + sizeof(header) + header.compressedSize > _length) {
+            // Chunk cut off at end of file
+            printf("Broken chunk\n");
+            return false;
+        }
+
+        Chunk raw = decompressChunk(offset);
+        if (!raw) {
+            return false;
+        }
+
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(raw->data());
+        uint32_t pos = 0;
+        while (pos < raw->size()) {
+            uint32_t size = 0;
+            if (pos + sizeof(size) > raw->size()) {
+                printf("Broken length\n");
+                return false;
+            }
+            memcpy(&size, data + pos, sizeof(size));
+
+            if (pos + sizeof(size) + size > raw->size()) {
+                printf("Broken packet\n");
+                return false;
+            }
+
+            LogIndexEntry entry;
+            entry.offset = offset;
+            entry.size = size;
+            entry.timestamp = peekTimestamp(data + pos + sizeof(size), size);
+            entry.chunkOffset = pos;
+            _index.push_back(entry);
+
+            pos += sizeof(size) + size;
+        }
+
+        offset += sizeof(header) + header.compressedSize;
+    }
+    return true;
+}
+
+bool LogReader::scanFrom(uint64_t offset) {
+    while (offset < _length) {
+        uint32_t size = 0;
+        if (offset + sizeof(size) > _length) {
+            // Broken length
+            printf("Broken length\n");
+            return false;
+        }
+        memcpy(&size, _data + offset, sizeof(size));
+
+        if (offset + sizeof(size) + size > _length) {
+            // Broken packet at end of file
+            printf("Broken packet\n");
+            return false;
+        }
+
+        LogIndexEntry entry;
+        entry.offset = offset;
+        entry.size = size;
+        entry.timestamp = peekTimestamp(_data + offset + sizeof(size), size);
+        entry.chunkOffset = 0;
+        _index.push_back(entry);
+
+        offset += sizeof(size) + size;
+    }
+    return true;
+}
+
+size_t LogReader::frameAtTime(uint64_t timestamp) const {
+    auto it = upper_bound(_index.begin(), _index.end(), timestamp,
+                          [](uint64_t t, const LogIndexEntry& entry) {
+                              return t < entry.timestamp;
+                          });
+    if (it == _index.begin()) {
+        return 0;
+    }
+    return (it - _index.begin()) - 1;
+}
+
+shared_ptr<LogFrame> LogReader::frame(size_t i) const {
+    if (i >= _index.size()) {
+        return nullptr;
+    }
+
+    {
+        lock_guard<mutex> lock(_cacheMutex);
+        auto cached = _cache.find(i);
+        if (cached != _cache.end()) {
+            _lru.splice(_lru.begin(), _lru, cached->second);
+            return cached->second->second;
+        }
+    }
+
+    // Parse outside the lock so other threads can hit the cache meanwhile
+    const LogIndexEntry& entry = _index[i];
+    const uint8_t* data = _data + entry.offset + sizeof(uint32_t);
+
+    // Keeps the decompressed chunk alive while the frame is parsed
+    Chunk raw;
+    if (_compressed) {
+        raw = chunk(entry.offset);
+        if (!raw) {
+            return nullptr;
+        }
+        data = reinterpret_cast<const uint8_t*>(raw->data()) +
+               entry.chunkOffset + sizeof(uint32_t);
+    }
+
+    auto frame = make_shared<LogFrame>();
+    // Parse partial so we can recover from corrupt data
+    if (!frame->ParsePartialFromArray(data, entry.size)) {
+        printf("Failed: %s\n", frame->InitializationErrorString().c_str());
+        return nullptr;
+    }
+
+    lock_guard<mutex> lock(_cacheMutex);
+    auto cached = _cache.find(i);
+    if (cached != _cache.end()) {
+        // Another thread parsed it first
+        _lru.splice(_lru.begin(), _lru, cached->second);
+        return cached->second->second;
+    }
+
+    _lru.emplace_front(i, frame);
+    _cache[i] = _lru.begin();
+    _spaceUsed += frame->SpaceUsed();
+
+    while (_lru.size() > _cacheCapacity) {
+        _spaceUsed -= _lru.back().second->SpaceUsed();
+        _cache.erase(_lru.back().first);
+        _lru.pop_back();
+    }
+
+    return frame;
+}
+
+size_t LogReader::spaceUsed() const {
+    lock_guard<mutex> lock(_cacheMutex);
+    return _spaceUsed;
+}
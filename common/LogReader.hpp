@@ -0,0 +1,127 @@
+#pragma once
+
+#include <protobuf/LogFrame.pb.h>
+#include "LogFormat.hpp"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Random-access reader for LogFrame log files, plain or compressed (see
+ * LogFormat.hpp).
+ *
+ * The log is memory mapped and frames are only parsed when requested. Recently
+ * parsed frames are kept in an LRU cache, so memory use is bounded by the
+ * cache capacity rather than by the length of the log.  In a compressed log,
+ * the last few decompressed chunks are cached too, so reading frames in order
+ * decompresses each chunk once.
+ *
+ * Frame offsets and timestamps come from the sidecar index written by Logger.
+ * If the index is missing, doesn't match the log (e.g. it was left behind by
+ * another log with the same name), or is shorter than the log, the rest is
+ * built by walking the length prefixes (decompressing chunks as needed), and
+ * the index is rewritten so the next open is cheap.
+ *
+ * All methods are safe to call from multiple threads.
+ */
+class LogReader {
+public:
+    /// @param cacheCapacity Maximum number of parsed frames kept in memory
+    explicit LogReader(size_t cacheCapacity = 256);
+    ~LogReader();
+
+    LogReader(const LogReader&) = delete;
+    LogReader& operator=(const LogReader&) = delete;
+
+    /// Map @filename and load or build its index.
+    /// On failure, the frames that could be indexed before the error are
+    /// still available.
+    bool open(const std::string& filename);
+
+    void close();
+
+    bool isOpen() const { return _data != nullptr; }
+
+    /// True if the log is in the compressed format
+    bool compressed() const { return _compressed; }
+
+    /// Number of frames in the log
+    size_t size() const { return _index.size(); }
+
+    /// Timestamp of frame @i, taken from the index without parsing the frame
+    uint64_t timestamp(size_t i) const { return _index[i].timestamp; }
+
+    /// Index of the last frame with a timestamp <= @timestamp, or 0 if there
+    /// is none
+    size_t frameAtTime(uint64_t timestamp) const;
+
+    /**
+     * Returns frame @i, parsing it if it isn't cached.
+     *
+     * @return nullptr if @i is out of range or the frame is corrupt
+     */
+    std::shared_ptr<Packet::LogFrame> frame(size_t i) const;
+
+    size_t cacheCapacity() const { return _cacheCapacity; }
+
+    /// Memory used by the cached frames and chunks, in bytes
+    size_t spaceUsed() const;
+
+private:
+    typedef std::shared_ptr<const std::string> Chunk;
+
+    /// Number of decompressed chunks kept in memory
+    static constexpr size_t ChunkCacheCapacity = 4;
+
+    /// Walk length prefixes from @offset to the end of the file, appending to
+    /// the index.
+    bool scanFrom(uint64_t offset);
+
+    /// Walk chunks from @offset to the end of a compressed file, appending
+    /// every frame in them to the index.
+    bool scanChunksFrom(uint64_t offset);
+
+    /// Copies the chunk header at @offset into @header.
+    /// Returns false (and zeroes @header) if it doesn't fit in the file.
+    bool readChunkHeader(uint64_t offset, LogChunkHeader* header) const;
+
+    /// Decompresses the chunk at @offset, or returns nullptr if it is corrupt.
+    Chunk decompressChunk(uint64_t offset) const;
+
+    /// Returns the decompressed chunk at @offset from the cache, or
+    /// decompresses it.
+    Chunk chunk(uint64_t offset) const;
+
+    /// True if every index entry is where a scan of the log would put it
+    bool indexMatchesLog() const;
+
+    bool loadIndex(const std::string& indexFilename);
+    void saveIndex(const std::string& indexFilename) const;
+
+    const uint8_t* _data = nullptr;
+    size_t _length = 0;
+    int _fd = -1;
+    bool _compressed = false;
+
+    std::vector<LogIndexEntry> _index;
+
+    // LRU cache of parsed frames, most recently used at the front
+    size_t _cacheCapacity;
+    mutable std::mutex _cacheMutex;
+    mutable std::list<std::pair<size_t, std::shared_ptr<Packet::LogFrame>>>
+        _lru;
+    mutable std::unordered_map<
+        size_t, std::list<std::pair<size_t,
+                                    std::shared_ptr<Packet::LogFrame>>>::iterator>
+        _cache;
+    mutable size_t _spaceUsed = 0;
+
+    // Recently decompressed chunks by file offset, most recently used at the
+    // front.  Protected by _cacheMutex.
+    mutable std::list<std::pair<uint64_t, Chunk>> _chunks;
+};
@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+#include "LogReader.hpp"
+#include "LogWriter.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+using namespace Packet;
+using namespace std;
+
+namespace {
+
+/// Writes @count frames in the on-disk log format and returns the filename
+string writeLog(int count) {
+    char filename[] = "/tmp/LogReaderTestXXXXXX";
+    int fd = mkstemp(filename);
+    EXPECT_GE(fd, 0);
+
+    for (int i = 0; i < count; i++) {
+        LogFrame frame;
+        frame.set_timestamp(1000 + 10 * i);
+        frame.set_command_time(i);
+        string bytes = frame.SerializeAsString();
+        uint32_t size = bytes.size();
+        EXPECT_EQ(sizeof(size), write(fd, &size, sizeof(size)));
+        EXPECT_EQ(bytes.size(), write(fd, bytes.data(), bytes.size()));
+    }
+    close(fd);
+
+    return filename;
+}
+
+/// Writes @count frames with LogWriter and returns the filename.
+/// Frame i has command_time @first + i.
+string writeCompressedLog(int count, int first = 0) {
+    char filename[] = "/tmp/LogReaderTestXXXXXX";
+    close(mkstemp(filename));
+
+    LogWriter writer;
+    EXPECT_TRUE(writer.open(filename));
+    for (int i = 0; i < count; i++) {
+        LogFrame frame;
+        frame.set_timestamp(1000 + 10 * i);
+        frame.set_command_time(first + i);
+        EXPECT_TRUE(writer.write(frame));
+    }
+    EXPECT_TRUE(writer.close());
+
+    return filename;
+}
+
+}  // namespace
+
+TEST(LogReader, randomAccess) {
+    const string filename = writeLog(50);
+
+    // Without an index, the first open builds one
+    for (int pass = 0; pass < 2; pass++) {
+        LogReader reader(8);
+        ASSERT_TRUE(reader.open(filename));
+        ASSERT_EQ(50, reader.size());
+
+        EXPECT_EQ(1000 + 10 * 37, reader.timestamp(37));
+        EXPECT_EQ(37, reader.frameAtTime(1000 + 10 * 37 + 5));
+        EXPECT_EQ(0, reader.frameAtTime(0));
+
+        for (int i : {49, 3, 27, 3}) {
+            auto frame = reader.frame(i);
+            ASSERT_NE(nullptr, frame);
+            EXPECT_EQ(i, frame->command_time());
+        }
+        EXPECT_EQ(nullptr, reader.frame(50));
+    }
+    EXPECT_EQ(0, access(logIndexFilename(filename).c_str(), F_OK));
+
+    unlink(logIndexFilename(filename).c_str());
+    unlink(filename.c_str());
+}
+
+TEST(LogReader, cacheIsBounded) {
+    const string filename = writeLog(100);
+
+    LogReader reader(4);
+    ASSERT_TRUE(reader.open(filename));
+    auto first = reader.frame(0);
+    for (int i = 0; i < 100; i++) {
+        reader.frame(i);
+    }
+    // Frame 0 was evicted, so a new copy is parsed
+    EXPECT_NE(first, reader.frame(0));
+    EXPECT_EQ(first->command_time(), reader.frame(0)->command_time());
+
+    unlink(logIndexFilename(filename).c_str());
+    unlink(filename.c_str());
+}
+
+TEST(LogReader, truncatedLog) {
+    const string filename = writeLog(10);
+    // Cut the log off partway through a frame
+    truncate(filename.c_str(), 23);
+
+    LogReader reader;
+    EXPECT_FALSE(reader.open(filename));
+    EXPECT_TRUE(reader.isOpen());
+    EXPECT_LT(reader.size(), 10);
+
+    unlink(logIndexFilename(filename).c_str());
+    unlink(filename.c_str());
+}
+
+TEST(LogReader, compressed) {
+    // Several full chunks and a partial one
+    const int count = 3 * LogChunkFrames + 7;
+    const int chunk = LogChunkFrames;
+    const string filename = writeCompressedLog(count);
+
+    // The first pass uses the index from LogWriter, the second rebuilds it
+    for (int pass = 0; pass < 2; pass++) {
+        LogReader reader(8);
+        ASSERT_TRUE(reader.open(filename));
+        EXPECT_TRUE(reader.compressed());
+        ASSERT_EQ(count, reader.size());
+
+        EXPECT_EQ(1000 + 10 * 100, reader.timestamp(100));
+        EXPECT_EQ(100, reader.frameAtTime(1000 + 10 * 100 + 5));
+
+        for (int i : {count - 1, 0, chunk, 100, 0}) {
+            auto frame = reader.frame(i);
+            ASSERT_NE(nullptr, frame);
+            EXPECT_EQ(i, frame->command_time());
+        }
+        EXPECT_EQ(nullptr, reader.frame(count));
+
+        unlink(logIndexFilename(filename).c_str());
+    }
+
+    unlink(logIndexFilename(filename).c_str());
+    unlink(filename.c_str());
+}
+
+TEST(LogReader, compressedIsSmaller) {
+    // Frames that repeat, like vision and debug drawing in a real log
+    char filename[] = "/tmp/LogReaderTestXXXXXX";
+    close(mkstemp(filename));
+
+    LogWriter writer;
+    ASSERT_TRUE(writer.open(filename));
+    size_t plainSize = 0;
+    for (int i = 0; i < 600; i++) {
+        LogFrame frame;
+        frame.set_timestamp(1000 + 10 * i);
+        frame.set_command_time(i);
+        for (int j = 0; j < 20; j++) {
+            DebugText* text = frame.add_debug_texts();
+            text->set_text("Robot " + to_string(j) + " is doing something");
+            text->set_color(0xff00ff);
+            text->set_layer(j % 4);
+        }
+        plainSize += sizeof(uint32_t) + frame.ByteSize();
+        ASSERT_TRUE(writer.write(frame));
+    }
+    ASSERT_TRUE(writer.close());
+
+    EXPECT_LT(writer.bytesWritten() * 10, plainSize);
+
+    unlink(logIndexFilename(filename).c_str());
+    unlink(filename);
+}
+
+TEST(LogReader, truncatedCompressedLog) {
+    const string filename = writeCompressedLog(2 * LogChunkFrames);
+    unlink(logIndexFilename(filename).c_str());
+
+    // Cut the log off partway through the second chunk
+    struct stat st;
+    ASSERT_EQ(0, stat(filename.c_str(), &st));
+    truncate(filename.c_str(), st.st_size - 5);
+
+    LogReader reader;
+    EXPECT_FALSE(reader.open(filename));
+    EXPECT_TRUE(reader.isOpen());
+    ASSERT_EQ(LogChunkFrames, reader.size());
+    EXPECT_EQ(LogChunkFrames - 1,
+              reader.frame(LogChunkFrames - 1)->command_time());
+
+    unlink(logIndexFilename(filename).c_str());
+    unlink(filename.c_str());
+}
+
+TEST(LogReader, indexFromOtherLog) {
+    // A log copied over an older one with the same name keeps the old index.
+    // Both logs are one chunk at the same offset, and the old frames are
+    // smaller, so every old entry fits in the new chunk.
+    const int count = LogChunkFrames;
+    const string oldLog = writeCompressedLog(count);
+    const string newLog = writeCompressedLog(count, 100000);
+    unlink(logIndexFilename(newLog).c_str());
+    rename(logIndexFilename(oldLog).c_str(), logIndexFilename(newLog).c_str());
+
+    LogReader reader;
+    ASSERT_TRUE(reader.open(newLog));
+    ASSERT_EQ(count, reader.size());
+    for (int i : {0, count / 2, count - 1}) {
+        ASSERT_NE(nullptr, reader.frame(i));
+        EXPECT_EQ(100000 + i, reader.frame(i)->command_time());
+    }
+
+    unlink(logIndexFilename(newLog).c_str());
+    unlink(oldLog.c_str());
+    unlink(newLog.c_str());
+}
+
+TEST(LogReader, corruptChunkSize) {
+    const string filename = writeCompressedLog(LogChunkFrames);
+    unlink(logIndexFilename(filename).c_str());
+
+    // Claim the first chunk decompresses to almost 4GB
+    LogChunkHeader header;
+    FILE* f = fopen(filename.c_str(), "r+b");
+    ASSERT_NE(nullptr, f);
+    fseek(f, sizeof(LogFileHeader), SEEK_SET);
+    ASSERT_EQ(1, fread(&header, sizeof(header), 1, f));
+    header.rawSize = 0xfffffff0;
+    fseek(f, sizeof(LogFileHeader), SEEK_SET);
+    ASSERT_EQ(1, fwrite(&header, sizeof(header), 1, f));
+    fclose(f);
+
+    LogReader reader;
+    EXPECT_FALSE(reader.open(filename));
+    EXPECT_EQ(0, reader.size());
+
+    unlink(logIndexFilename(filename).c_str());
+    unlink(filename.c_str());
+}
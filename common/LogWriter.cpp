@@ -0,0 +1,179 @@
+#include "LogWriter.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <zstd.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+using namespace Packet;
+
+namespace {
+
+// writev() all of @iov, retrying after partial writes
+bool writeFully(int fd, struct iovec* iov, int count) {
+    while (count > 0) {
+        ssize_t written = writev(fd, iov, min(count, IOV_MAX));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        while (count > 0 && (size_t)written >= iov->iov_len) {
+            written -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char*)iov->iov_base + written;
+            iov->iov_len -= written;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+LogWriter::LogWriter(int compressionLevel)
+    : _compressionLevel(compressionLevel), _cctx(ZSTD_createCCtx()) {}
+
+LogWriter::~LogWriter() {
+    close();
+    ZSTD_freeCCtx(_cctx);
+}
+
+bool LogWriter::open(const string& filename) {
+    close();
+
+    _fd = creat(filename.c_str(), 0666);
+    if (_fd < 0) {
+        printf("Can't create %s: %m\n", filename.c_str());
+        return false;
+    }
+
+    LogFileHeader fileHeader = {LogFileMagic, LogFileVersion};
+    struct iovec iov = {&fileHeader, sizeof(fileHeader)};
+    if (!writeFully(_fd, &iov, 1)) {
+        printf("Can't write %s: %m\n", filename.c_str());
+        ::close(_fd);
+        _fd = -1;
+        return false;
+    }
+    _fileOffset = sizeof(fileHeader);
+
+    _indexFd = creat(logIndexFilename(filename).c_str(), 0666);
+    const uint32_t indexHeader[2] = {LogIndexMagic, LogIndexVersion};
+    if (_indexFd >= 0 &&
+        ::write(_indexFd, indexHeader, sizeof(indexHeader)) !=
+            sizeof(indexHeader)) {
+        ::close(_indexFd);
+        _indexFd = -1;
+    }
+
+    _chunk.clear();
+    _chunkEntries.clear();
+
+    return true;
+}
+
+bool LogWriter::close() {
+    bool ok = true;
+    if (_fd >= 0) {
+        ok = flush();
+        ::close(_fd);
+        _fd = -1;
+    }
+    if (_indexFd >= 0) {
+        ::close(_indexFd);
+        _indexFd = -1;
+    }
+    return ok;
+}
+
+bool LogWriter::write(const LogFrame& frame) {
+    if (!frame.IsInitialized()) {
+        printf("LogWriter: Not writing frame missing fields: %s\n",
+               frame.InitializationErrorString().c_str());
+        return true;
+    }
+
+    // Readers reject chunks much larger than LogChunkMaxBytes
+    const uint32_t size = frame.ByteSize();
+    if (size > LogChunkMaxBytes) {
+        printf("LogWriter: Not writing %u byte frame\n", size);
+        return true;
+    }
+
+    // Serialize straight into the chunk after the size prefix
+    const size_t pos = _chunk.size();
+    _chunk.resize(pos + sizeof(size) + size);
+    memcpy(&_chunk[pos], &size, sizeof(size));
+    frame.SerializeWithCachedSizesToArray(
+        reinterpret_cast<uint8_t*>(&_chunk[pos + sizeof(size)]));
+
+    LogIndexEntry entry;
+    entry.offset = _fileOffset;
+    entry.timestamp = frame.timestamp();
+    entry.size = size;
+    entry.chunkOffset = pos;
+    _chunkEntries.push_back(entry);
+
+    if (_chunkEntries.size() >= LogChunkFrames ||
+        _chunk.size() >= LogChunkMaxBytes) {
+        return flush();
+    }
+    return true;
+}
+
+bool LogWriter::flush() {
+    if (_chunkEntries.empty() || _fd < 0) {
+        return true;
+    }
+
+    _compressed.resize(ZSTD_compressBound(_chunk.size()));
+    const size_t compressedSize =
+        ZSTD_compressCCtx(_cctx, &_compressed[0], _compressed.size(),
+                          _chunk.data(), _chunk.size(), _compressionLevel);
+    if (ZSTD_isError(compressedSize)) {
+        printf("LogWriter: Failed to compress chunk: %s\n",
+               ZSTD_getErrorName(compressedSize));
+        return false;
+    }
+
+    LogChunkHeader header;
+    header.compressedSize = compressedSize;
+    header.rawSize = _chunk.size();
+    header.frames = _chunkEntries.size();
+    header.reserved = 0;
+
+    struct iovec iov[2] = {{&header, sizeof(header)},
+                           {&_compressed[0], compressedSize}};
+    if (!writeFully(_fd, iov, 2)) {
+        printf("LogWriter: Failed to write chunk: %m\n");
+        return false;
+    }
+    _fileOffset += sizeof(header) + compressedSize;
+
+    // Index entries are only written once their chunk is on disk
+    if (_indexFd >= 0) {
+        struct iovec indexIov = {_chunkEntries.data(),
+                                 _chunkEntries.size() * sizeof(LogIndexEntry)};
+        if (!writeFully(_indexFd, &indexIov, 1)) {
+            printf("LogWriter: Failed to write index: %m\n");
+            ::close(_indexFd);
+            _indexFd = -1;
+        }
+    }
+
+    _chunk.clear();
+    _chunkEntries.clear();
+    return true;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <protobuf/LogFrame.pb.h>
+#include "LogFormat.hpp"
+
+#include <string>
+#include <vector>
+
+typedef struct ZSTD_CCtx_s ZSTD_CCtx;
+
+/**
+ * Writes LogFrames to a compressed log and its index (see LogFormat.hpp).
+ *
+ * Frames are serialized into an in-memory chunk, which is compressed and
+ * written once it holds LogChunkFrames frames or LogChunkMaxBytes bytes, or
+ * when flush() or close() is called.  Frames in the pending chunk are lost if
+ * the process dies before then.
+ *
+ * Not thread-safe: each LogWriter must only be used by one thread at a time.
+ */
+class LogWriter {
+public:
+    /// @param compressionLevel zstd compression level.  Low levels are fast
+    ///        and already do well on logs, since frames repeat a lot.
+    explicit LogWriter(int compressionLevel = 3);
+    ~LogWriter();
+
+    LogWriter(const LogWriter&) = delete;
+    LogWriter& operator=(const LogWriter&) = delete;
+
+    /// Creates @filename and its index, replacing any existing files.
+    bool open(const std::string& filename);
+
+    /// Flushes the pending chunk and closes the files
+    bool close();
+
+    bool isOpen() const { return _fd >= 0; }
+
+    /**
+     * Adds a frame to the pending chunk, writing the chunk if it is full.
+     * Frames that are missing required fields are skipped.
+     *
+     * @return false if the log could not be written
+     */
+    bool write(const Packet::LogFrame& frame);
+
+    /// Compresses and writes the pending chunk, if any
+    bool flush();
+
+    /// Number of bytes written to the log so far
+    uint64_t bytesWritten() const { return _fileOffset; }
+
+private:
+    int _compressionLevel;
+    ZSTD_CCtx* _cctx;
+
+    int _fd = -1;
+
+    // The index is only an accelerator for readers, so it is dropped if it
+    // can't be written
+    int _indexFd = -1;
+
+    // Offset in the log file of the next chunk
+    uint64_t _fileOffset = 0;
+
+    // Frames in the plain format, waiting to be compressed
+    std::string _chunk;
+    std::vector<LogIndexEntry> _chunkEntries;
+
+    std::string _compressed;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+/**
+ * Bounded, lock-free, single-producer single-consumer FIFO.
+ *
+ * Exactly one thread may call tryPush() and exactly one (possibly different)
+ * thread may call tryPop() at a time. Neither call blocks or allocates, which
+ * makes this suitable for handing data out of the realtime control loop.
+ */
+template <typename T>
+class SpscQueue {
+public:
+    /// @param capacity Maximum number of queued elements
+    explicit SpscQueue(size_t capacity) : _slots(capacity + 1) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    size_t capacity() const { return _slots.size() - 1; }
+
+    /**
+     * Append @value to the queue.
+     *
+     * @return False (and leave @value untouched) if the queue is full
+     */
+    bool tryPush(T&& value) {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        const size_t next = increment(tail);
+        if (next == _head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        _slots[tail].emplace(std::move(value));
+        _tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPush(const T& value) {
+        T copy = value;
+        return tryPush(std::move(copy));
+    }
+
+    /// Remove and return the oldest element, or nothing if the queue is empty
+    std::optional<T> tryPop() {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        std::optional<T> value(std::move(_slots[head]));
+        _slots[head].reset();
+        _head.store(increment(head), std::memory_order_release);
+        return value;
+    }
+
+    /// Approximate when called concurrently with push or pop
+    bool empty() const {
+        return _head.load(std::memory_order_acquire) ==
+               _tail.load(std::memory_order_acquire);
+    }
+
+private:
+    size_t increment(size_t i) const {
+        return i + 1 == _slots.size() ? 0 : i + 1;
+    }
+
+    // Empty slots hold nothing, so T needn't be default constructible and
+    // popped elements are destroyed right away
+    std::vector<std::optional<T>> _slots;
+
+    // Keep the indices on separate cache lines so the producer and consumer
+    // don't contend
+    alignas(64) std::atomic<size_t> _head{0};
+    alignas(64) std::atomic<size_t> _tail{0};
+};
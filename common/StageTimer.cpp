@@ -0,0 +1,61 @@
+#include "StageTimer.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace std;
+
+StageTimer::StageTimer(vector<string> stages, size_t window)
+    : _names(move(stages)),
+      _window(max<size_t>(window, 1)),
+      _current(_names.size() + 1),
+      _history((_names.size() + 1) * _window),
+      _stats(_names.size() + 1) {
+    _sorted.reserve(_window);
+}
+
+void StageTimer::start() {
+    _start = Clock::now();
+    _lastMark = _start;
+    fill(_current.begin(), _current.end(), 0);
+}
+
+void StageTimer::mark(size_t stage) {
+    const Clock::time_point now = Clock::now();
+    add(stage, now - _lastMark);
+    _lastMark = now;
+}
+
+void StageTimer::add(size_t stage, Clock::duration duration) {
+    _current[stage] +=
+        chrono::duration_cast<chrono::microseconds>(duration).count();
+}
+
+void StageTimer::finish() {
+    _current.back() =
+        chrono::duration_cast<chrono::microseconds>(Clock::now() - _start)
+            .count();
+
+    const size_t slot = _iterations % _window;
+    _iterations++;
+    const size_t count = min<uint64_t>(_iterations, _window);
+
+    for (size_t i = 0; i < _current.size(); i++) {
+        int64_t* history = &_history[i * _window];
+        history[slot] = _current[i];
+
+        Stats& stats = _stats[i];
+        stats.last = _current[i];
+
+        const auto minMax = minmax_element(history, history + count);
+        stats.min = *minMax.first;
+        stats.max = *minMax.second;
+        stats.mean = accumulate(history, history + count, int64_t(0)) / count;
+
+        // Nearest-rank 99th percentile
+        _sorted.assign(history, history + count);
+        const size_t rank = (count * 99 + 99) / 100 - 1;
+        nth_element(_sorted.begin(), _sorted.begin() + rank, _sorted.end());
+        stats.p99 = _sorted[rank];
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Measures how long each stage of a loop takes and keeps rolling statistics
+ * over the last few iterations.
+ *
+ * Call start() at the top of each iteration, mark() at the end of each stage
+ * and finish() at the end of the iteration.  A stage may be marked more than
+ * once in an iteration, in which case its times are added up.  Stages that
+ * aren't marked count as taking no time.
+ *
+ * Times are taken from a monotonic clock, not the RJ clock, so they are real
+ * even when running on a virtual clock.
+ *
+ * Not thread-safe.
+ */
+class StageTimer {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /// Durations in microseconds
+    struct Stats {
+        /// The most recent finished iteration
+        int64_t last = 0;
+        int64_t min = 0;
+        int64_t mean = 0;
+        int64_t p99 = 0;
+        int64_t max = 0;
+    };
+
+    /**
+     * @param stages Names of the stages, in the order they run
+     * @param window Number of iterations the statistics cover
+     */
+    explicit StageTimer(std::vector<std::string> stages, size_t window = 600);
+
+    size_t numStages() const { return _names.size(); }
+
+    const std::string& name(size_t stage) const { return _names[stage]; }
+
+    /// Begins an iteration
+    void start();
+
+    /// Ends @stage, which is charged the time since the last call to start()
+    /// or mark()
+    void mark(size_t stage);
+
+    /// Adds @duration to @stage in the current iteration
+    void add(size_t stage, Clock::duration duration);
+
+    /// Ends the iteration and updates the statistics
+    void finish();
+
+    /// Statistics for @stage over the last window iterations
+    const Stats& stats(size_t stage) const { return _stats[stage]; }
+
+    /// Statistics for whole iterations, from start() to finish()
+    const Stats& total() const { return _stats.back(); }
+
+    /// Number of finished iterations
+    uint64_t iterations() const { return _iterations; }
+
+private:
+    std::vector<std::string> _names;
+    size_t _window;
+
+    Clock::time_point _start;
+    Clock::time_point _lastMark;
+
+    // Durations of the current iteration, with the total last
+    std::vector<int64_t> _current;
+
+    // _history[i * _window + n] is the duration of stage i in the n'th
+    // iteration (mod _window), with the total last
+    std::vector<int64_t> _history;
+    std::vector<Stats> _stats;
+    uint64_t _iterations = 0;
+
+    // Scratch space for finding percentiles
+    std::vector<int64_t> _sorted;
+};
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "StageTimer.hpp"
+
+using namespace std::chrono;
+
+TEST(StageTimer, rollingStats) {
+    StageTimer timer({"a", "b"}, 100);
+    ASSERT_EQ(2, timer.numStages());
+
+    // Stage a takes 1..200us, stage b is never marked
+    for (int i = 1; i <= 200; i++) {
+        timer.start();
+        timer.add(0, microseconds(i));
+        timer.finish();
+    }
+    EXPECT_EQ(200, timer.iterations());
+
+    // Only the last 100 iterations count
+    const StageTimer::Stats& a = timer.stats(0);
+    EXPECT_EQ(200, a.last);
+    EXPECT_EQ(101, a.min);
+    EXPECT_EQ(150, a.mean);
+    EXPECT_EQ(199, a.p99);
+    EXPECT_EQ(200, a.max);
+
+    const StageTimer::Stats& b = timer.stats(1);
+    EXPECT_EQ(0, b.last);
+    EXPECT_EQ(0, b.max);
+}
+
+TEST(StageTimer, marks) {
+    StageTimer timer({"a", "b"});
+    timer.start();
+    timer.add(1, microseconds(5));
+    timer.add(1, microseconds(7));
+    timer.mark(0);
+    timer.finish();
+
+    // add() accumulates within an iteration
+    EXPECT_EQ(12, timer.stats(1).last);
+
+    // Marked stages fit within the total
+    EXPECT_GE(timer.stats(0).last, 0);
+    EXPECT_GE(timer.total().last, timer.stats(0).last);
+
+    // start() clears the previous iteration
+    timer.start();
+    timer.finish();
+    EXPECT_EQ(0, timer.stats(1).last);
+    EXPECT_EQ(12, timer.stats(1).max);
+}
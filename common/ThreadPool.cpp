@@ -0,0 +1,57 @@
+#include "ThreadPool.hpp"
+
+#include <atomic>
+
+namespace {
+
+std::atomic<unsigned int> evaluationThreads{0};
+
+}  // namespace
+
+ThreadPool::ThreadPool(unsigned int numThreads) {
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    _workers.reserve(numThreads);
+    for (unsigned int i = 0; i < numThreads; i++) {
+        _workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _cv.notify_all();
+
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+            if (_tasks.empty()) {
+                return;
+            }
+            task = std::move(_tasks.front());
+            _tasks.pop();
+        }
+        task();
+    }
+}
+
+ThreadPool& ThreadPool::evaluation() {
+    static ThreadPool pool(evaluationThreads.load());
+    return pool;
+}
+
+void ThreadPool::setEvaluationThreads(unsigned int numThreads) {
+    evaluationThreads.store(numThreads);
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * A fixed-size pool of worker threads that run submitted tasks in FIFO order.
+ *
+ * Tasks are handed back as std::futures, so exceptions thrown by a task are
+ * rethrown from future::get() on the submitting thread. Destroying the pool
+ * finishes every queued task before joining the workers.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param numThreads Number of worker threads. Zero uses one thread per
+     *     hardware thread.
+     */
+    explicit ThreadPool(unsigned int numThreads = 0);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Number of worker threads
+    size_t size() const { return _workers.size(); }
+
+    /**
+     * The pool shared by the evaluators' batches and parallel optimizers, so
+     * they don't each start a thread per core.  It's created on first use,
+     * with the number of threads given to setEvaluationThreads().
+     *
+     * Its tasks must not wait on other tasks in it, or they can deadlock.
+     */
+    static ThreadPool& evaluation();
+
+    /**
+     * Sets the number of threads for evaluation().  Zero uses one thread per
+     * hardware thread.  Has no effect once evaluation() has been used.
+     */
+    static void setEvaluationThreads(unsigned int numThreads);
+
+    /**
+     * Queue @task to run on a worker thread.
+     *
+     * @return A future holding the task's result
+     */
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F&& task) {
+        using Result = std::invoke_result_t<F>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(
+            std::forward<F>(task));
+        std::future<Result> result = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.emplace([packaged]() { (*packaged)(); });
+        }
+        _cv.notify_one();
+        return result;
+    }
+
+    /**
+     * Run @fn(i) for every i in [0, count) across the pool and block until all
+     * of them finish. The calling thread runs work too, so this is safe to
+     * call with a single-threaded pool.
+     */
+    template <typename F>
+    void parallelFor(size_t count, F&& fn) {
+        if (count == 0) {
+            return;
+        }
+
+        std::vector<std::future<void>> pending;
+        pending.reserve(count - 1);
+        for (size_t i = 1; i < count; i++) {
+            pending.push_back(submit([&fn, i]() { fn(i); }));
+        }
+
+        // Wait for every task before rethrowing, since they all reference fn
+        std::exception_ptr error;
+        try {
+            fn(0);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        for (auto& f : pending) {
+            try {
+                f.get();
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * Run @fn(i) for every i in [0, count), split into contiguous runs of at
+     * least @minPerTask items, one run per task.  Batches too small to split
+     * run on the calling thread without touching the workers.
+     *
+     * @param minPerTask Smallest run worth handing to another thread.  Set it
+     *     so a run takes much longer than waking a worker.
+     */
+    template <typename F>
+    void parallelBatch(size_t count, size_t minPerTask, F&& fn) {
+        const size_t tasks =
+            std::min(size(), count / std::max<size_t>(minPerTask, 1));
+        if (tasks <= 1) {
+            for (size_t i = 0; i < count; i++) {
+                fn(i);
+            }
+            return;
+        }
+
+        parallelFor(tasks, [&](size_t task) {
+            const size_t begin = count * task / tasks;
+            const size_t end = count * (task + 1) / tasks;
+            for (size_t i = begin; i < end; i++) {
+                fn(i);
+            }
+        });
+    }
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> _workers;
+    std::queue<std::function<void()>> _tasks;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _stopping = false;
+};
@@ -0,0 +1,166 @@
+#include "Trace.hpp"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+namespace Trace {
+
+namespace {
+
+struct Event {
+    const char* name;
+    int64_t begin;
+    int64_t end;
+};
+
+struct ThreadBuffer {
+    int tid;
+
+    // Guarded by registryMutex
+    string name;
+
+    // Number of events ever recorded.  Only the owning thread writes it.
+    atomic<uint64_t> head{0};
+
+    array<Event, BufferEvents> events;
+};
+
+atomic_bool traceEnabled{true};
+
+// Every thread that has recorded anything.  Buffers are kept after their
+// thread exits so its spans still show up in the trace.
+mutex registryMutex;
+vector<shared_ptr<ThreadBuffer>> registry;
+
+ThreadBuffer& threadBuffer() {
+    thread_local shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        buffer = make_shared<ThreadBuffer>();
+
+        lock_guard<mutex> lock(registryMutex);
+        buffer->tid = registry.size() + 1;
+        buffer->name = "Thread " + to_string(buffer->tid);
+        registry.push_back(buffer);
+    }
+    return *buffer;
+}
+
+// Writes @str as a JSON string
+void writeString(FILE* fp, const char* str) {
+    fputc('"', fp);
+    for (; *str; str++) {
+        if (*str == '"' || *str == '\\') {
+            fputc('\\', fp);
+        }
+        if ((unsigned char)*str >= 0x20) {
+            fputc(*str, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+}  // namespace
+
+bool enabled() { return traceEnabled.load(memory_order_relaxed); }
+
+void setEnabled(bool enabled) { traceEnabled = enabled; }
+
+void setThreadName(const string& name) {
+    ThreadBuffer& buffer = threadBuffer();
+    lock_guard<mutex> lock(registryMutex);
+    buffer.name = name;
+}
+
+void record(const char* name, int64_t begin, int64_t end) {
+    ThreadBuffer& buffer = threadBuffer();
+    const uint64_t head = buffer.head.load(memory_order_relaxed);
+    buffer.events[head % BufferEvents] = {name, begin, end};
+    buffer.head.store(head + 1, memory_order_release);
+}
+
+bool writeJson(const string& filename) {
+    vector<shared_ptr<ThreadBuffer>> buffers;
+    vector<string> names;
+    {
+        lock_guard<mutex> lock(registryMutex);
+        buffers = registry;
+        for (const auto& buffer : buffers) {
+            names.push_back(buffer->name);
+        }
+    }
+
+    // Copy out each ring, then drop the events the owner may have overwritten
+    // while they were being copied.  The owner may also be part way through
+    // writing the slot after its head.
+    vector<vector<Event>> events(buffers.size());
+    int64_t start = INT64_MAX;
+    for (size_t i = 0; i < buffers.size(); i++) {
+        const ThreadBuffer& buffer = *buffers[i];
+        const uint64_t head = buffer.head.load(memory_order_acquire);
+        const uint64_t first = head > BufferEvents ? head - BufferEvents : 0;
+        for (uint64_t n = first; n < head; n++) {
+            events[i].push_back(buffer.events[n % BufferEvents]);
+        }
+
+        atomic_thread_fence(memory_order_acquire);
+        const uint64_t newHead = buffer.head.load(memory_order_relaxed);
+        if (newHead + 1 > first + BufferEvents) {
+            const uint64_t lost = min<uint64_t>(
+                newHead + 1 - BufferEvents - first, events[i].size());
+            events[i].erase(events[i].begin(), events[i].begin() + lost);
+        }
+
+        if (!events[i].empty()) {
+            start = min(start, events[i].front().begin);
+        }
+    }
+
+    FILE* fp = fopen(filename.c_str(), "w");
+    if (!fp) {
+        printf("Can't write trace %s: %m\n", filename.c_str());
+        return false;
+    }
+
+    fprintf(fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    for (size_t i = 0; i < buffers.size(); i++) {
+        const int tid = buffers[i]->tid;
+        fprintf(fp,
+                "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                "\"tid\":%d,\"args\":{\"name\":",
+                first ? "" : ",\n", tid);
+        writeString(fp, names[i].c_str());
+        fprintf(fp, "}}");
+        first = false;
+
+        // Timestamps are in microseconds from the first span
+        for (const Event& event : events[i]) {
+            fprintf(fp, ",\n{\"name\":");
+            writeString(fp, event.name);
+            fprintf(fp,
+                    ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,"
+                    "\"dur\":%.3f}",
+                    tid, (event.begin - start) / 1000.0,
+                    (event.end - event.begin) / 1000.0);
+        }
+    }
+    fprintf(fp, "\n]}\n");
+
+    const bool ok = !ferror(fp);
+    if (fclose(fp) != 0 || !ok) {
+        printf("Can't write trace %s: %m\n", filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+}  // namespace Trace
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * Lightweight tracing of what each thread is doing, for finding out how the
+ * threads interleave and where frames get delayed.
+ *
+ * TRACE_SCOPE("name") records a span from where it appears to the end of the
+ * enclosing scope.  Each thread records into its own ring buffer without
+ * locking, so the newest BufferEvents spans of every thread are kept and
+ * older ones are overwritten.  writeJson() saves them in the Chrome
+ * trace-event format, which chrome://tracing and ui.perfetto.dev can open.
+ *
+ * Tracing is always compiled in and on by default.  A span costs two reads of
+ * the monotonic clock and a store into the ring.
+ *
+ * Span names are stored as pointers, so they must be string literals (or
+ * otherwise live until the trace is written).
+ */
+namespace Trace {
+
+/// Number of spans kept per thread
+constexpr size_t BufferEvents = 1 << 14;
+
+/// Nanoseconds on the monotonic clock
+inline int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+bool enabled();
+
+/// Turns recording on or off for all threads.  Spans already recorded are
+/// kept.
+void setEnabled(bool enabled);
+
+/// Names the calling thread in the trace
+void setThreadName(const std::string& name);
+
+/// Records a span on the calling thread
+void record(const char* name, int64_t begin, int64_t end);
+
+/**
+ * Writes the recorded spans of every thread to @filename as Chrome trace-event
+ * JSON.  Threads may keep recording while this runs; spans they overwrite in
+ * the meantime are left out.
+ *
+ * @return false if the file could not be written
+ */
+bool writeJson(const std::string& filename);
+
+/// Records a span covering its own lifetime.  Use TRACE_SCOPE instead.
+class Scope {
+public:
+    explicit Scope(const char* name)
+        : _name(name), _begin(enabled() ? now() : 0) {}
+
+    ~Scope() {
+        if (_begin) {
+            record(_name, _begin, now());
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* _name;
+    int64_t _begin;
+};
+
+}  // namespace Trace
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+/// Records a span from here to the end of the enclosing scope
+#define TRACE_SCOPE(name) \
+    Trace::Scope TRACE_CONCAT(_traceScope, __LINE__)(name)
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "Trace.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+string writeTrace() {
+    char filename[] = "/tmp/TraceTestXXXXXX";
+    close(mkstemp(filename));
+    EXPECT_TRUE(Trace::writeJson(filename));
+
+    ifstream file(filename);
+    stringstream contents;
+    contents << file.rdbuf();
+    unlink(filename);
+    return contents.str();
+}
+
+size_t count(const string& str, const string& pattern) {
+    size_t n = 0;
+    for (size_t pos = str.find(pattern); pos != string::npos;
+         pos = str.find(pattern, pos + 1)) {
+        n++;
+    }
+    return n;
+}
+
+}  // namespace
+
+TEST(Trace, threads) {
+    thread worker([]() {
+        Trace::setThreadName("TraceTest worker");
+        TRACE_SCOPE("TraceTest::worker");
+    });
+    worker.join();
+
+    {
+        TRACE_SCOPE("TraceTest::main");
+    }
+
+    // Spans from a thread that has exited are still there
+    const string json = writeTrace();
+    EXPECT_EQ(0, json.find("{\"displayTimeUnit\""));
+    EXPECT_NE(string::npos, json.find("\"TraceTest worker\""));
+    EXPECT_NE(string::npos, json.find("\"TraceTest::worker\",\"ph\":\"X\""));
+    EXPECT_NE(string::npos, json.find("\"TraceTest::main\",\"ph\":\"X\""));
+}
+
+TEST(Trace, keepsNewest) {
+    thread worker([]() {
+        for (size_t i = 0; i < Trace::BufferEvents; i++) {
+            Trace::record("TraceTest::old", 0, 1);
+        }
+        for (size_t i = 0; i < Trace::BufferEvents / 2; i++) {
+            Trace::record("TraceTest::new", 0, 1);
+        }
+    });
+    worker.join();
+
+    // The oldest span is left out of a full ring, in case the owner was
+    // overwriting it
+    const string json = writeTrace();
+    EXPECT_EQ(Trace::BufferEvents / 2 - 1,
+              count(json, "\"TraceTest::old\""));
+    EXPECT_EQ(Trace::BufferEvents / 2, count(json, "\"TraceTest::new\""));
+}
+
+TEST(Trace, disabled) {
+    Trace::setEnabled(false);
+    {
+        TRACE_SCOPE("TraceTest::disabled");
+    }
+    Trace::setEnabled(true);
+
+    EXPECT_EQ(string::npos, writeTrace().find("TraceTest::disabled"));
+}
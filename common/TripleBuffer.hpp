@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Wait-free handoff of the latest value from one writer thread to one reader
+ * thread.
+ *
+ * The writer fills in back() and calls publish().  The reader calls read() to
+ * get the most recently published value.  Values that are published while the
+ * reader isn't looking are skipped.  Neither side ever blocks or copies a
+ * value: the three buffers are rotated by swapping indices.
+ *
+ * After publish(), back() refers to an old value, so the writer must fill in
+ * all of it before publishing again.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /// The buffer the writer is filling in
+    T& back() { return _buffers[_back]; }
+
+    /// Makes the contents of back() available to the reader
+    void publish() {
+        const uint8_t old =
+            _middle.exchange(_back | NewBit, std::memory_order_acq_rel);
+        _back = old & IndexMask;
+    }
+
+    /**
+     * Returns the most recently published value, or a default constructed T if
+     * nothing has been published.
+     *
+     * The reference is valid until the next call to read().
+     */
+    const T& read() {
+        if (_middle.load(std::memory_order_relaxed) & NewBit) {
+            const uint8_t old =
+                _middle.exchange(_front, std::memory_order_acq_rel);
+            _front = old & IndexMask;
+        }
+        return _buffers[_front];
+    }
+
+private:
+    // _middle holds the index of the buffer between the writer and reader, and
+    // NewBit if the reader hasn't taken it yet
+    static constexpr uint8_t IndexMask = 3;
+    static constexpr uint8_t NewBit = 4;
+
+    std::array<T, 3> _buffers{};
+
+    // Each index is only touched by one side, except _middle.  Keep them on
+    // separate cache lines so the writer and reader don't contend.
+    alignas(64) uint8_t _back = 0;
+    alignas(64) std::atomic<uint8_t> _middle{1};
+    alignas(64) uint8_t _front = 2;
+};
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "TripleBuffer.hpp"
+
+#include <thread>
+
+namespace {
+
+struct Value {
+    int a = 0;
+    int b = 0;
+};
+
+}  // namespace
+
+TEST(TripleBuffer, readsLatest) {
+    TripleBuffer<Value> buffer;
+    EXPECT_EQ(0, buffer.read().a);
+
+    for (int i = 1; i <= 5; i++) {
+        buffer.back() = {i, i};
+        buffer.publish();
+    }
+    EXPECT_EQ(5, buffer.read().a);
+    // Nothing new was published, so the same value comes back
+    EXPECT_EQ(5, buffer.read().a);
+
+    buffer.back() = {6, 6};
+    buffer.publish();
+    EXPECT_EQ(6, buffer.read().a);
+}
+
+TEST(TripleBuffer, concurrent) {
+    TripleBuffer<Value> buffer;
+    const int count = 100000;
+
+    std::thread writer([&]() {
+        for (int i = 1; i <= count; i++) {
+            Value& value = buffer.back();
+            value.a = i;
+            value.b = -i;
+            buffer.publish();
+        }
+    });
+
+    // Every value read must be one that was published whole, and values must
+    // never go backwards
+    int last = 0;
+    while (last < count) {
+        const Value& value = buffer.read();
+        ASSERT_EQ(value.a, -value.b);
+        ASSERT_GE(value.a, last);
+        last = value.a;
+    }
+
+    writer.join();
+}
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <sys/time.h>
+#include <atomic>
 #include <chrono>
 #include <string>
 #include <iostream>
+#include <thread>
 
 using namespace std::chrono_literals;
 
@@ -20,13 +22,128 @@ constexpr int64_t numMicroseconds(Duration d) {
     return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
 }
 
-inline Time now() {
-    return std::chrono::system_clock::now();
-    // struct timeval time;
-    // gettimeofday(&time, nullptr);
-    // return (Time)time.tv_sec * 1000000 + (Time)time.tv_usec;
+/**
+ * Source of the time returned by RJ::now().
+ *
+ * Everything that reads the time or sleeps for a period goes through the
+ * active clock, so a VirtualClock can be installed with setClock() to run
+ * faster than real time (for example when replaying a log) and get the same
+ * results every run.
+ */
+class Clock {
+public:
+    virtual ~Clock() = default;
+
+    virtual Time now() const = 0;
+
+    /// Blocks until now() >= @time
+    virtual void sleepUntil(Time time) = 0;
+};
+
+/**
+ * Real time, which never goes backwards.
+ *
+ * Times are on the system clock's epoch so they can be compared with other
+ * programs and logs, but they advance with the steady clock, so adjusting the
+ * system time doesn't make periods negative.
+ */
+class RealTimeClock : public Clock {
+public:
+    RealTimeClock()
+        : _epoch(std::chrono::system_clock::now()),
+          _start(std::chrono::steady_clock::now()) {}
+
+    Time now() const override {
+        return _epoch + std::chrono::duration_cast<Time::duration>(
+                            std::chrono::steady_clock::now() - _start);
+    }
+
+    void sleepUntil(Time time) override {
+        std::this_thread::sleep_until(
+            _start + std::chrono::duration_cast<
+                         std::chrono::steady_clock::duration>(time - _epoch));
+    }
+
+private:
+    Time _epoch;
+    std::chrono::steady_clock::time_point _start;
+};
+
+/**
+ * Time that only moves when it is told to.
+ *
+ * sleepUntil() returns immediately after moving the time forward, so a loop
+ * that sleeps out the rest of its period runs as fast as the CPU allows while
+ * seeing the same times it would in real time.
+ */
+class VirtualClock : public Clock {
+public:
+    explicit VirtualClock(Time start = Time())
+        : _now(start.time_since_epoch().count()) {}
+
+    Time now() const override {
+        return Time(Time::duration(_now.load(std::memory_order_acquire)));
+    }
+
+    /// Moves the time forward to @time.  Never moves it backwards.
+    void sleepUntil(Time time) override {
+        const Time::rep target = time.time_since_epoch().count();
+        Time::rep current = _now.load(std::memory_order_relaxed);
+        while (current < target &&
+               !_now.compare_exchange_weak(current, target,
+                                           std::memory_order_acq_rel)) {
+        }
+    }
+
+    void advance(Seconds period) {
+        _now.fetch_add(
+            std::chrono::duration_cast<Time::duration>(period).count(),
+            std::memory_order_acq_rel);
+    }
+
+    /// Sets the time, even if that moves it backwards
+    void set(Time time) {
+        _now.store(time.time_since_epoch().count(), std::memory_order_release);
+    }
+
+private:
+    std::atomic<Time::rep> _now;
+};
+
+/// The clock used when no other clock has been set
+inline RealTimeClock& realTimeClock() {
+    static RealTimeClock clock;
+    return clock;
 }
 
+namespace detail {
+inline std::atomic<Clock*>& activeClock() {
+    static std::atomic<Clock*> clock{&realTimeClock()};
+    return clock;
+}
+}  // namespace detail
+
+/// The clock used by now() and sleepUntil()
+inline Clock& clock() {
+    return *detail::activeClock().load(std::memory_order_acquire);
+}
+
+/**
+ * Makes @clock the source of time for the whole program, or goes back to real
+ * time if @clock is null.
+ *
+ * This should be done before any threads that read the time are started.  The
+ * caller keeps ownership of @clock, which must outlive its use.
+ */
+inline void setClock(Clock* clock) {
+    detail::activeClock().store(clock ? clock : &realTimeClock(),
+                                std::memory_order_release);
+}
+
+inline Time now() { return clock().now(); }
+
+inline void sleepUntil(Time time) { clock().sleepUntil(time); }
+
 constexpr Timestamp timestamp(Time time) {
     return numMicroseconds(time.time_since_epoch());
 }
@@ -1,6 +1,7 @@
 #include <NewRefereeModule.cpp>
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <LogReader.hpp>
 #include <protobuf/LogFrame.pb.h>
 #include <protobuf/referee.pb.h>
 
@@ -18,7 +19,8 @@ using namespace std;
 const char BAR = '|';
 const int MATCH_ID_LENGTH = 32;
 
-vector<std::shared_ptr<Packet::LogFrame> > frames;
+// Frames are only converted once each, so a small cache is enough
+LogReader frames(16);
 
 /**
  * Defines usage information for launching the Log-Viewer application
@@ -51,46 +53,12 @@ void generateMatchID(char* id, int length) {
 }
 
 /**
- * Read frames and parse protobuf from specified file
+ * Open the specified log file. Frames are parsed as they are read.
  * @param filename Filename of a RoboJackets protobuf log file
- * @return true If reading and parsing was flawless
- * @return false If there was any errors or warnings while parsing
+ * @return true If the whole file could be indexed
+ * @return false If there was any errors or warnings while indexing
  */
-bool readFrames(const char* filename) {
-    QFile file(filename);
-
-    if (!file.open(QFile::ReadOnly)) {
-        fprintf(stderr, "Can't open %s: %s\n", filename,
-                (const char*)file.errorString().toLatin1());
-        return false;
-    }
-
-    while (!file.atEnd()) {
-        uint32_t size = 0;
-        if (file.read((char*)&size, sizeof(size)) != sizeof(size)) {
-            // Broken length
-            printf("Broken length\n");
-            return false;
-        }
-
-        string str(size, 0);
-        if (file.read(&str[0], size) != size) {
-            // Broken packet at end of file
-            printf("Broken packet\n");
-            return false;
-        }
-
-        shared_ptr<LogFrame> frame = std::make_shared<LogFrame>();
-        frames.push_back(frame);
-        // Parse partial so we can recover from corrupt data
-        if (!frame->ParsePartialFromString(str)) {
-            printf("Failed: %s\n", frame->InitializationErrorString().c_str());
-            return false;
-        }
-    }
-
-    return true;
-}
+bool readFrames(const char* filename) { return frames.open(filename); }
 
 int main(int argc, char* argv[]) {
     if (argc != 3) {
@@ -134,7 +102,11 @@ int main(int argc, char* argv[]) {
              << "yellow_goalie" << BAR << "blue_goalie" << endl;
 
     for (int i = 0; i < frames.size(); i++) {
-        LogFrame* currentFrame = frames[i].get();
+        const shared_ptr<LogFrame> frame = frames.frame(i);
+        if (!frame) {
+            exit(1);
+        }
+        LogFrame* currentFrame = frame.get();
 
         const long long timestamp = currentFrame->timestamp();
 
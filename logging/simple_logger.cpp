@@ -7,6 +7,7 @@
 #include <protobuf/referee.pb.h>
 #include <rc-fshare/git_version.hpp>
 
+#include <LogWriter.hpp>
 #include <multicast.hpp>
 #include <Network.hpp>
 #include <Utils.hpp>
@@ -81,9 +82,8 @@ int main(int argc, char* argv[]) {
     multicast_add(&refereeSocket, RefereeAddress);
 
     // Create log file
-    int fd = creat(logFile.toLatin1(), 0666);
-    if (fd < 0) {
-        printf("Can't create %s: %m\n", (const char*)logFile.toLatin1());
+    LogWriter logWriter;
+    if (!logWriter.open(logFile.toStdString())) {
         return 1;
     }
 
@@ -157,12 +157,7 @@ int main(int argc, char* argv[]) {
             logConfig->set_simulation(simulation);
         }
 
-        uint32_t size = logFrame.ByteSize();
-        if (write(fd, &size, sizeof(size)) != sizeof(size)) {
-            printf("Failed to write size: %m\n");
-            break;
-        } else if (!logFrame.SerializeToFileDescriptor(fd)) {
-            printf("Failed to write frame: %m\n");
+        if (!logWriter.write(logFrame)) {
             break;
         }
 
@@ -177,6 +172,9 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    // Write out the last chunk
+    logWriter.close();
+
     // Discard input on stdin
     tcflush(0, TCIFLUSH);
 
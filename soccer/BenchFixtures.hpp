@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Geometry2d/Point.hpp>
+#include <Geometry2d/Pose.hpp>
+#include "Context.hpp"
+#include "Robot.hpp"
+
+/**
+ * Puts @count robots of each team in a line across the field, like the
+ * robots around a shot or a pass.  Our line starts at @selfStart and heads
+ * right, and theirs starts at @oppStart and heads left, both moving up the
+ * field as they go.
+ */
+inline void placeRobots(
+    Context& context, int count,
+    Geometry2d::Point selfStart = Geometry2d::Point(-2, 2),
+    Geometry2d::Point oppStart = Geometry2d::Point(2, 1)) {
+    for (int i = 0; i < count; i++) {
+        OurRobot* self = context.state.self[i];
+        self->mutable_state().visible = true;
+        self->mutable_state().pose = Geometry2d::Pose(
+            selfStart + Geometry2d::Point(0.8 * i, 0.3 * i), 0);
+
+        OpponentRobot* opp = context.state.opp[i];
+        opp->mutable_state().visible = true;
+        opp->mutable_state().pose = Geometry2d::Pose(
+            oppStart + Geometry2d::Point(-0.8 * i, 0.4 * i), 0);
+    }
+}
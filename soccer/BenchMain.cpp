@@ -0,0 +1,23 @@
+#include <benchmark/benchmark.h>
+
+#include <stdlib.h>
+
+#include "Configuration.hpp"
+
+int main(int argc, char** argv) {
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    // setup config system because the filters and planners rely on it
+    std::shared_ptr<Configuration> config =
+        Configuration::FromRegisteredConfigurables();
+
+    // Same seed every run so randomized code does the same work
+    srand48(0);
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
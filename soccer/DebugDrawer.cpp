@@ -2,6 +2,7 @@
 #include "LogUtils.hpp"
 
 int DebugDrawer::findDebugLayer(QString layer) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     if (layer.isNull()) {
         layer = "Debug";
     }
@@ -21,6 +22,7 @@ int DebugDrawer::findDebugLayer(QString layer) {
 
 void DebugDrawer::drawPolygon(const Geometry2d::Point* pts, int n,
                               const QColor& qc, const QString& layer) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     Packet::DebugPath* dbg = _logFrame->add_debug_polygons();
     dbg->set_layer(findDebugLayer(layer));
     for (int i = 0; i < n; ++i) {
@@ -41,6 +43,7 @@ void DebugDrawer::drawPolygon(const Geometry2d::Polygon& polygon,
 
 void DebugDrawer::drawCircle(Geometry2d::Point center, float radius,
                              const QColor& qc, const QString& layer) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     Packet::DebugCircle* dbg = _logFrame->add_debug_circles();
     dbg->set_layer(findDebugLayer(layer));
     *dbg->mutable_center() = center;
@@ -50,6 +53,7 @@ void DebugDrawer::drawCircle(Geometry2d::Point center, float radius,
 
 void DebugDrawer::drawArc(const Geometry2d::Arc& arc, const QColor& qc,
                           const QString& layer) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     Packet::DebugArc* dbg = _logFrame->add_debug_arcs();
     dbg->set_layer(findDebugLayer(layer));
     *dbg->mutable_center() = arc.center();
@@ -59,14 +63,11 @@ void DebugDrawer::drawArc(const Geometry2d::Arc& arc, const QColor& qc,
     dbg->set_color(color(qc));
 }
 
-void DebugDrawer::drawShape(const std::shared_ptr<Geometry2d::Shape>& obs,
-                            const QColor& color, const QString& layer) {
-    std::shared_ptr<Geometry2d::Circle> circObs =
-        std::dynamic_pointer_cast<Geometry2d::Circle>(obs);
-    std::shared_ptr<Geometry2d::Polygon> polyObs =
-        std::dynamic_pointer_cast<Geometry2d::Polygon>(obs);
-    std::shared_ptr<Geometry2d::CompositeShape> compObs =
-        std::dynamic_pointer_cast<Geometry2d::CompositeShape>(obs);
+void DebugDrawer::drawShape(const Geometry2d::Shape& obs, const QColor& color,
+                            const QString& layer) {
+    auto circObs = dynamic_cast<const Geometry2d::Circle*>(&obs);
+    auto polyObs = dynamic_cast<const Geometry2d::Polygon*>(&obs);
+    auto compObs = dynamic_cast<const Geometry2d::CompositeShape*>(&obs);
     if (circObs)
         drawCircle(circObs->center, circObs->radius(), color, layer);
     else if (polyObs)
@@ -80,13 +81,14 @@ void DebugDrawer::drawShape(const std::shared_ptr<Geometry2d::Shape>& obs,
 
 void DebugDrawer::drawShapeSet(const Geometry2d::ShapeSet& shapes,
                                const QColor& color, const QString& layer) {
-    for (auto& shape : shapes.shapes()) {
-        drawShape(shape, color, layer);
+    for (uint32_t id = 0; id < shapes.size(); id++) {
+        drawShape(shapes.shape(id), color, layer);
     }
 }
 
 void DebugDrawer::drawLine(const Geometry2d::Segment& line, const QColor& qc,
                            const QString& layer) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     Packet::DebugPath* dbg = _logFrame->add_debug_paths();
     dbg->set_layer(findDebugLayer(layer));
     *dbg->add_points() = line.pt[0];
@@ -101,6 +103,7 @@ void DebugDrawer::drawLine(Geometry2d::Point p0, Geometry2d::Point p1,
 
 void DebugDrawer::drawText(const QString& text, Geometry2d::Point pos,
                            const QColor& qc, const QString& layer) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     Packet::DebugText* dbg = _logFrame->add_debug_texts();
     dbg->set_layer(findDebugLayer(layer));
     dbg->set_text(text.toStdString());
@@ -110,6 +113,7 @@ void DebugDrawer::drawText(const QString& text, Geometry2d::Point pos,
 
 void DebugDrawer::drawSegment(const Geometry2d::Segment& line, const QColor& qc,
                               const QString& layer) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     Packet::DebugPath* dbg = _logFrame->add_debug_paths();
     dbg->set_layer(findDebugLayer(layer));
     *dbg->add_points() = line.pt[0];
@@ -3,6 +3,7 @@
 #include <QColor>
 #include <QMap>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -17,6 +18,12 @@
 
 class Context;
 
+/**
+ * Records debug graphics into the current LogFrame.
+ *
+ * Drawing is serialized internally so that path planners running on worker
+ * threads can draw concurrently.
+ */
 class DebugDrawer {
 public:
     DebugDrawer(Context* context) : _context(context) {}
@@ -51,10 +58,17 @@ public:
                  const QString& layer = QString());
 
     /** @ingroup drawing_functions */
-    void drawShape(const std::shared_ptr<Geometry2d::Shape>& obs,
+    void drawShape(const Geometry2d::Shape& obs,
                    const QColor& color = Qt::black,
                    const QString& layer = QString());
 
+    /** @ingroup drawing_functions */
+    void drawShape(const std::shared_ptr<Geometry2d::Shape>& obs,
+                   const QColor& color = Qt::black,
+                   const QString& layer = QString()) {
+        drawShape(*obs, color, layer);
+    }
+
     /** @ingroup drawing_functions */
     void drawShapeSet(const Geometry2d::ShapeSet& shapes,
                       const QColor& color = Qt::black,
@@ -95,4 +109,7 @@ private:
 
     Context* _context;
     Packet::LogFrame* _logFrame;
+
+    /// Guards the layer map and additions to _logFrame
+    std::recursive_mutex _mutex;
 };
@@ -1,11 +1,18 @@
 #include "KickEvaluator.hpp"
 #include <Utils.hpp>
 #include <Geometry2d/Util.hpp>
+#include <ThreadPool.hpp>
 
 #include <algorithm>
 #include <vector>
 #include <math.h>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 REGISTER_CONFIGURABLE(KickEvaluator)
 
@@ -17,14 +24,38 @@ ConfigDouble* KickEvaluator::kick_mean;
 ConfigDouble* KickEvaluator::robot_std_dev;
 ConfigDouble* KickEvaluator::start_x_offset;
 
+namespace {
+
 // Fast exp function, valid within 4% at +- 100
+// The result's high word is a linear function of x, and its low word is zero.
 inline double fast_exp(double x) {
+    const int64_t bits = int64_t((int)(1512775 * x + 1072632447)) << 32;
     double d;
-    *((int*)(&d) + 0) = 0;
-    *((int*)(&d) + 1) = (int)(1512775 * x + 1072632447);
+    memcpy(&d, &bits, sizeof(d));
     return d;
 }
 
+#if defined(__AVX2__)
+// fast_exp() of four values, multiplied by -@scale, in double like the scalar
+// version
+inline __m128 neg_fast_exp_scaled(__m128 x, __m128 scale) {
+    const __m256d t = _mm256_add_pd(
+        _mm256_mul_pd(_mm256_set1_pd(1512775), _mm256_cvtps_pd(x)),
+        _mm256_set1_pd(1072632447));
+    const __m256i bits =
+        _mm256_slli_epi64(_mm256_cvtepi32_epi64(_mm256_cvttpd_epi32(t)), 32);
+    const __m256d e = _mm256_mul_pd(_mm256_set1_pd(-1.0),
+                                    _mm256_castsi256_pd(bits));
+    return _mm256_cvtpd_ps(_mm256_mul_pd(e, _mm256_cvtps_pd(scale)));
+}
+#endif
+
+// Origins evaluated per task in a batch.  A single origin takes a few
+// microseconds, so smaller tasks spend more time waking threads than working.
+constexpr size_t MinOriginsPerTask = 8;
+
+}  // namespace
+
 void KickEvaluator::createConfiguration(Configuration* cfg) {
     kick_std_dev = new ConfigDouble(cfg, "KickEvaluator/kick_std_dev", 0.04);
     kick_mean = new ConfigDouble(cfg, "KickEvaluator/kick_mean", 0);
@@ -66,13 +97,50 @@ KickResults KickEvaluator::eval_pt_to_our_goal(Point origin) {
 }
 
 KickResults KickEvaluator::eval_pt_to_seg(Point origin, Segment target) {
+    return eval_pt_to_seg(origin, target, get_obstacles());
+}
+
+vector<KickResults> KickEvaluator::eval_pts_to_seg(const vector<Point>& origins,
+                                                   Segment target) {
+    const vector<Point> obstacles = get_obstacles();
+    vector<KickResults> results(origins.size());
+
+    ThreadPool::evaluation().parallelBatch(
+        origins.size(), MinOriginsPerTask, [&](size_t i) {
+            results[i] = eval_pt_to_seg(origins[i], target, obstacles);
+        });
+    return results;
+}
+
+vector<KickResults> KickEvaluator::eval_pts_to_opp_goal(
+    const vector<Point>& origins) {
+    Segment their_goal{
+        Point{-Field_Dimensions::Current_Dimensions.GoalWidth() / 2,
+              Field_Dimensions::Current_Dimensions.Length()},
+        Point{Field_Dimensions::Current_Dimensions.GoalWidth() / 2,
+              Field_Dimensions::Current_Dimensions.Length()}};
+
+    return eval_pts_to_seg(origins, their_goal);
+}
+
+vector<KickResults> KickEvaluator::eval_pts_to_our_goal(
+    const vector<Point>& origins) {
+    Segment our_goal{
+        Point{-Field_Dimensions::Current_Dimensions.GoalWidth() / 2, 0},
+        Point{Field_Dimensions::Current_Dimensions.GoalWidth() / 2, 0}};
+
+    return eval_pts_to_seg(origins, our_goal);
+}
+
+KickResults KickEvaluator::eval_pt_to_seg(Point origin, Segment target,
+                                          const vector<Point>& obstacles) {
     Point center = target.center();
     float targetWidth = get_target_angle(origin, target);
 
     // Polar bot locations
     // <Dist, Angle>
     vector<tuple<float, float> > botLocations =
-        convert_robots_to_polar(origin, center);
+        convert_robots_to_polar(origin, center, obstacles);
 
     // Convert polar to mean / std_dev / Vertical Scales
     vector<float> botMeans;
@@ -219,8 +287,65 @@ tuple<float, float> KickEvaluator::eval_calculation(
     tterm =
         sqrtpi_2 * (sqrt1_kstdev2 - kstdev * erf((kx + bRight) / sqrt2_kstdev));
 
-    // For each robot distribution in Set #1
-    for (int i = 0; i < robotMeans.size(); i++) {
+    const int robotCount = robotMeans.size();
+    int i = 0;
+
+#if defined(__AVX2__)
+    // Eight robots at a time, with the last batch masked.  A few robots are
+    // faster in the scalar loop below.  This computes the same terms but in a
+    // different order, so results can differ from it in the last bits.
+    const __m256i laneIndex = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256 vkx = _mm256_set1_ps(kx);
+    const __m256 vkstdev2 = _mm256_set1_ps(kstdev2);
+    const __m256 vinvkstdev2 = _mm256_set1_ps(1.0f / kstdev2);
+    const __m256 vsqrt2pi = _mm256_set1_ps(sqrt2pi);
+    const __m256 vscale = _mm256_set1_ps(1.0f / (kstdev * sqrt2pi));
+    for (; i + 4 <= robotCount; i += 8) {
+        const int lanes = std::min(8, robotCount - i);
+        const __m256i mask =
+            _mm256_cmpgt_epi32(_mm256_set1_epi32(lanes), laneIndex);
+
+        const __m256 vrmean = _mm256_maskload_ps(&robotMeans[i], mask);
+        const __m256 vrstdev = _mm256_maskload_ps(&robotStDevs[i], mask);
+        const __m256 vrstdev2 = _mm256_mul_ps(vrstdev, vrstdev);
+        const __m256 vrobotV = _mm256_mul_ps(
+            _mm256_maskload_ps(&robotVertScales[i], mask), vsqrt2pi);
+
+        const __m256 d = _mm256_add_ps(vkx, vrmean);
+        const __m256 expArg = _mm256_div_ps(
+            _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(-0.5f), d), d),
+            _mm256_add_ps(vkstdev2, vrstdev2));
+
+        __m256 vfterm = _mm256_set_m128(
+            neg_fast_exp_scaled(_mm256_extractf128_ps(expArg, 1),
+                                _mm256_extractf128_ps(vrobotV, 1)),
+            neg_fast_exp_scaled(_mm256_castps256_ps128(expArg),
+                                _mm256_castps256_ps128(vrobotV)));
+        vfterm = _mm256_div_ps(
+            vfterm,
+            _mm256_sqrt_ps(_mm256_add_ps(
+                vinvkstdev2, _mm256_div_ps(_mm256_set1_ps(1.0f), vrstdev2))));
+
+        alignas(32) float batchResults[8];
+        _mm256_store_ps(
+            batchResults,
+            _mm256_mul_ps(
+                vscale,
+                _mm256_sub_ps(_mm256_add_ps(vfterm, _mm256_set1_ps(sterm)),
+                              _mm256_set1_ps(tterm))));
+
+        // Masked lanes are garbage
+        for (int j = 0; j < lanes; j++) {
+            if (batchResults[j] < minResults) {
+                minResults = batchResults[j];
+                minIndex = i + j;
+            }
+        }
+    }
+#endif
+
+    // For each remaining robot distribution in Set #1
+    for (; i < robotCount; i++) {
         rmean = robotMeans[i];
         rstdev = robotStDevs[i];
         rstdev2 = rstdev * rstdev;
@@ -288,6 +413,20 @@ vector<Robot*> KickEvaluator::get_valid_robots() {
     return bots;
 }
 
+vector<Point> KickEvaluator::get_obstacles() {
+    vector<Robot*> bots = get_valid_robots();
+    vector<Point> obstacles;
+    obstacles.reserve(bots.size() + hypothetical_robot_locations.size());
+
+    for (Robot* bot : bots) {
+        obstacles.push_back(bot->pos());
+    }
+    obstacles.insert(obstacles.end(), hypothetical_robot_locations.begin(),
+                     hypothetical_robot_locations.end());
+
+    return obstacles;
+}
+
 tuple<float, float> KickEvaluator::rect_to_polar(const Point origin,
                                                  const Point target,
                                                  const Point obstacle) {
@@ -299,21 +438,13 @@ tuple<float, float> KickEvaluator::rect_to_polar(const Point origin,
 }
 
 vector<tuple<float, float> > KickEvaluator::convert_robots_to_polar(
-    const Point origin, const Point target) {
-    vector<Robot*> bots = get_valid_robots();
+    const Point origin, const Point target, const vector<Point>& obstacles) {
     vector<tuple<float, float> > botLocations;
-    botLocations.reserve(bots.size() + botLocations.size());
-
-    // Convert each bot position to polar
-    transform(bots.begin(), bots.end(), back_inserter(botLocations),
-              [target, origin, this](Robot* bot) {
-                  return rect_to_polar(origin, target, bot->pos());
-              });
+    botLocations.reserve(obstacles.size());
 
-    // Convert imaginary obstacles to polar
-    transform(hypothetical_robot_locations.begin(),
-              hypothetical_robot_locations.end(), back_inserter(botLocations),
-              [target, origin, this](Point obstacle) {
+    // Convert each obstacle position to polar
+    transform(obstacles.begin(), obstacles.end(), back_inserter(botLocations),
+              [target, origin](Point obstacle) {
                   return rect_to_polar(origin, target, obstacle);
               });
 
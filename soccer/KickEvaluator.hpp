@@ -67,6 +67,33 @@ public:
     KickResults eval_pt_to_seg(Geometry2d::Point origin,
                                Geometry2d::Segment target);
 
+    /**
+     * @brief Evaluates kicks from many origins to the same target segment
+     * @details Each result is the same as eval_pt_to_seg() for that origin.
+     * The obstacles are gathered once for the whole batch, and large batches
+     * are split across a shared thread pool.
+     * @param origins, Starting points of the kicks
+     * @param target, End segment of the kicks
+     * @return Results of calculations, in the same order as origins
+     */
+    std::vector<KickResults> eval_pts_to_seg(
+        const std::vector<Geometry2d::Point>& origins,
+        Geometry2d::Segment target);
+
+    /**
+     * @brief Evaluates kicks from many origins to the opponent goal
+     * @see eval_pts_to_seg
+     */
+    std::vector<KickResults> eval_pts_to_opp_goal(
+        const std::vector<Geometry2d::Point>& origins);
+
+    /**
+     * @brief Evaluates kicks from many origins to our goal
+     * @see eval_pts_to_seg
+     */
+    std::vector<KickResults> eval_pts_to_our_goal(
+        const std::vector<Geometry2d::Point>& origins);
+
     /**
      * @brief Evaluates closed form solution of the KickEvaluation problem
      * @param x, Location to run at
@@ -109,33 +136,47 @@ private:
     /**
      * @return the width of the target segment in radians
      */
-    float get_target_angle(const Geometry2d::Point origin,
-                           const Geometry2d::Segment target);
+    static float get_target_angle(const Geometry2d::Point origin,
+                                  const Geometry2d::Segment target);
 
     /**
      * @return Vector of valid robots on the field
      */
     std::vector<Robot*> get_valid_robots();
 
+    /**
+     * @return Positions of the valid robots and hypothetical robots
+     */
+    std::vector<Geometry2d::Point> get_obstacles();
+
+    /**
+     * @brief Evaluates kick to target segment with the given obstacles
+     * @note Only reads shared state, so batches can call it from any thread
+     */
+    static KickResults eval_pt_to_seg(
+        Geometry2d::Point origin, Geometry2d::Segment target,
+        const std::vector<Geometry2d::Point>& obstacles);
+
     /**
      * @brief Converts Robot position to polar in reference to the goal vector
      * @return <R, Theta>
      */
-    std::tuple<float, float> rect_to_polar(const Geometry2d::Point origin,
-                                           const Geometry2d::Point target,
-                                           const Geometry2d::Point obstacle);
+    static std::tuple<float, float> rect_to_polar(
+        const Geometry2d::Point origin, const Geometry2d::Point target,
+        const Geometry2d::Point obstacle);
 
     /**
-     * @return List of all robots positions in polar coordinates
+     * @return List of all obstacle positions in polar coordinates
      */
-    std::vector<std::tuple<float, float> > convert_robots_to_polar(
-        const Geometry2d::Point origin, const Geometry2d::Point target);
+    static std::vector<std::tuple<float, float> > convert_robots_to_polar(
+        const Geometry2d::Point origin, const Geometry2d::Point target,
+        const std::vector<Geometry2d::Point>& obstacles);
 
     /**
      * @brief Initilizes ParallelGraident1DConfig based upon the robot locations
      * etc
      */
-    void init_gradient_configs(
+    static void init_gradient_configs(
         ParallelGradient1DConfig& pConfig,
         std::function<std::tuple<float, float>(float)>& func,
         const std::vector<float>& robotMeans,
@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+#include "BenchFixtures.hpp"
+#include "KickEvaluator.hpp"
+#include "SystemState.hpp"
+
+using namespace Geometry2d;
+
+static void BM_KickEvaluatorEvalPtToSeg(benchmark::State& state) {
+    Context context;
+    placeRobots(context, state.range(0));
+
+    const Segment ourGoal =
+        Field_Dimensions::Current_Dimensions.OurGoalSegment();
+    KickEvaluator kickEval(&context.state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(kickEval.eval_pt_to_seg(Point(0.5, 4), ourGoal));
+    }
+}
+BENCHMARK(BM_KickEvaluatorEvalPtToSeg)
+    ->ArgName("robots")
+    ->Arg(0)
+    ->Arg(3)
+    ->Arg(6);
+
+static void BM_KickEvaluatorEvalPtsToSeg(benchmark::State& state) {
+    Context context;
+    placeRobots(context, 6);
+
+    std::vector<Point> origins;
+    for (int i = 0; i < state.range(0); i++) {
+        origins.emplace_back(-2 + 4.0 * i / state.range(0), 4);
+    }
+
+    const Segment ourGoal =
+        Field_Dimensions::Current_Dimensions.OurGoalSegment();
+    KickEvaluator kickEval(&context.state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(kickEval.eval_pts_to_seg(origins, ourGoal));
+    }
+    state.SetItemsProcessed(state.iterations() * origins.size());
+}
+BENCHMARK(BM_KickEvaluatorEvalPtsToSeg)->ArgName("origins")->Arg(8)->Arg(64);
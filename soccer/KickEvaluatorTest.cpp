@@ -3,6 +3,7 @@
 #include "SystemState.hpp"
 
 #include <stdlib.h>
+#include <cmath>
 
 using namespace Geometry2d;
 
@@ -85,3 +86,61 @@ TEST(KickEvaluator, check_best_point) {
     EXPECT_NEAR((std::get<0>(expected)).x(), (std::get<0>(pt_to_opp_goal)).x(),
                 0.01);
 }
+
+TEST(KickEvaluator, eval_calculation_many_robots) {
+    // More robots than one SIMD batch, so the tail is covered too
+    std::vector<float> robotMeans;
+    std::vector<float> robotStdevs;
+    std::vector<float> robotVertScores;
+    for (int i = 0; i < 11; i++) {
+        robotMeans.push_back(-0.5 + 0.1 * i);
+        robotStdevs.push_back(0.05 + 0.01 * i);
+        robotVertScores.push_back(0.5 + 0.05 * i);
+    }
+
+    for (float x = -0.4; x <= 0.4; x += 0.05) {
+        std::tuple<float, float> res = KickEvaluator::eval_calculation(
+            x, 0, 0.1, robotMeans, robotStdevs, robotVertScores, -0.5, 0.5);
+
+        // The result is set by whichever robot blocks the most
+        std::tuple<float, float> best(INFINITY, 0);
+        for (int i = 0; i < 11; i++) {
+            std::tuple<float, float> single = KickEvaluator::eval_calculation(
+                x, 0, 0.1, {robotMeans[i]}, {robotStdevs[i]},
+                {robotVertScores[i]}, -0.5, 0.5);
+            if (std::get<0>(single) < std::get<0>(best)) {
+                best = single;
+            }
+        }
+        // With AVX2, the batch rounds differently from the scalar loop that
+        // evaluates a single robot
+        EXPECT_NEAR(std::get<0>(best), std::get<0>(res), 1e-5);
+        EXPECT_NEAR(std::get<1>(best), std::get<1>(res), 1e-4);
+    }
+}
+
+TEST(KickEvaluator, eval_pts_to_seg) {
+    Context context;
+    for (int i = 0; i < 3; i++) {
+        OpponentRobot* opp = context.state.opp[i];
+        opp->mutable_state().visible = true;
+        opp->mutable_state().pose = Pose(-1 + i, 4 + 0.5 * i, 0);
+    }
+
+    KickEvaluator kickEval(&context.state);
+    std::vector<Point> origins;
+    for (int i = 0; i < 40; i++) {
+        origins.emplace_back(-2 + 0.1 * i, 2 + 0.05 * i);
+    }
+
+    // Each result matches evaluating that origin on its own
+    auto results = kickEval.eval_pts_to_opp_goal(origins);
+    ASSERT_EQ(origins.size(), results.size());
+    for (size_t i = 0; i < origins.size(); i++) {
+        auto single = kickEval.eval_pt_to_opp_goal(origins[i]);
+        EXPECT_EQ(single.first, results[i].first);
+        EXPECT_EQ(single.second, results[i].second);
+    }
+
+    EXPECT_TRUE(kickEval.eval_pts_to_our_goal({}).empty());
+}
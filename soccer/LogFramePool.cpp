@@ -0,0 +1,95 @@
+#include "LogFramePool.hpp"
+
+#include <algorithm>
+
+using namespace Packet;
+using google::protobuf::Arena;
+using google::protobuf::ArenaOptions;
+
+LogFramePool::Slot::Slot(size_t blockSize)
+    : block(new char[blockSize]), blockSize(blockSize) {
+    ArenaOptions options;
+    options.initial_block = block.get();
+    options.initial_block_size = blockSize;
+    options.start_block_size = MinBlockSize;
+    options.max_block_size = MaxBlockSize;
+    arena = std::make_unique<Arena>(options);
+}
+
+std::shared_ptr<LogFramePool> LogFramePool::create(size_t capacity) {
+    return std::shared_ptr<LogFramePool>(new LogFramePool(capacity));
+}
+
+LogFramePool::LogFramePool(size_t capacity) : _capacity(capacity) {
+    // Recycling never reallocates the free list
+    _free.reserve(capacity);
+}
+
+std::shared_ptr<LogFrame> LogFramePool::make() {
+    std::unique_ptr<Slot> slot;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_free.empty()) {
+            slot = std::move(_free.back());
+            _free.pop_back();
+        }
+    }
+    if (!slot) {
+        slot = std::make_unique<Slot>(blockSize());
+    }
+
+    LogFrame* frame = Arena::CreateMessage<LogFrame>(slot->arena.get());
+
+    // The deleter owns the slot until the frame is released.  The frame itself
+    // is destroyed by its arena.
+    Slot* owned = slot.release();
+    return std::shared_ptr<LogFrame>(
+        frame, [pool = shared_from_this(), owned](LogFrame*) {
+            pool->recycle(owned);
+        });
+}
+
+void LogFramePool::recycle(Slot* released) {
+    std::unique_ptr<Slot> slot(released);
+
+    // SpaceUsed() leaves out the unused end of each block, so it measures
+    // the frame rather than the block it was given
+    const size_t used = slot->arena->SpaceUsed();
+    size_t blockSize;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _averageUsed += (used - _averageUsed) * AverageWeight;
+        const size_t wanted = _averageUsed * BlockHeadroom;
+        const size_t rounded =
+            (wanted + MinBlockSize - 1) / MinBlockSize * MinBlockSize;
+        _blockSize = std::min(std::max(rounded, MinBlockSize), MaxBlockSize);
+
+        if (_free.size() >= _capacity) {
+            return;
+        }
+        blockSize = _blockSize;
+    }
+
+    if (slot->blockSize < blockSize || slot->blockSize > 2 * blockSize) {
+        // Replace arenas that are smaller than what frames now need, or that
+        // hold much more memory than they do
+        slot = std::make_unique<Slot>(blockSize);
+    } else {
+        slot->arena->Reset();
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_free.size() < _capacity) {
+        _free.push_back(std::move(slot));
+    }
+}
+
+size_t LogFramePool::available() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _free.size();
+}
+
+size_t LogFramePool::blockSize() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _blockSize;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <protobuf/LogFrame.pb.h>
+#include <google/protobuf/arena.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Makes LogFrames whose messages are allocated on a recycled
+ * google::protobuf::Arena.
+ *
+ * @details The Processor fills a new LogFrame every cycle with hundreds of
+ * nested messages.  Each frame made by make() lives in an arena with its own
+ * initial block, so building it doesn't touch the heap.  When the last
+ * shared_ptr to the frame is released, which is usually when it falls out of
+ * the Logger's history, the arena is reset and returned to the pool.
+ *
+ * The initial block is sized from a running average of the space frames use,
+ * so once the pool has warmed up, typical frames don't need more blocks.  An
+ * occasional large frame uses extra blocks instead of making every arena in
+ * the pool bigger.  At most @capacity idle arenas are kept; it should be at
+ * least the Logger's history size plus the frames in flight.
+ *
+ * A pool must be owned by a shared_ptr (see create()), because the frames
+ * keep it alive.  make() is only called from one thread.  Frames may be
+ * released from any thread.
+ */
+class LogFramePool : public std::enable_shared_from_this<LogFramePool> {
+public:
+    static std::shared_ptr<LogFramePool> create(size_t capacity);
+
+    /// Returns an empty frame
+    std::shared_ptr<Packet::LogFrame> make();
+
+    /// Number of arenas waiting to be reused
+    size_t available() const;
+
+    /// Size of the initial block given to new arenas
+    size_t blockSize() const;
+
+    /// Smallest initial block, and the granularity it changes by
+    static constexpr size_t MinBlockSize = 16 * 1024;
+
+    /// The initial block stops growing here.  Larger frames use extra blocks.
+    static constexpr size_t MaxBlockSize = 1024 * 1024;
+
+    /// Weight of each released frame in the running average of frame sizes.
+    /// The average follows a change in frame size within a few hundred
+    /// frames.
+    static constexpr double AverageWeight = 1.0 / 64;
+
+    /// How much larger than the average frame the initial block is, so that
+    /// frames a bit larger than average still fit
+    static constexpr double BlockHeadroom = 1.25;
+
+private:
+    explicit LogFramePool(size_t capacity);
+
+    struct Slot {
+        explicit Slot(size_t blockSize);
+
+        std::unique_ptr<char[]> block;
+        size_t blockSize;
+        std::unique_ptr<google::protobuf::Arena> arena;
+    };
+
+    // Called when the last reference to a frame made on @slot is released
+    void recycle(Slot* slot);
+
+    const size_t _capacity;
+
+    mutable std::mutex _mutex;
+    std::vector<std::unique_ptr<Slot>> _free;
+    double _averageUsed = 0;
+    size_t _blockSize = MinBlockSize;
+};
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "LogFramePool.hpp"
+
+using namespace Packet;
+
+namespace {
+
+// Adds about @bytes of debug text to @frame
+void fill(LogFrame* frame, size_t bytes) {
+    for (size_t i = 0; i < bytes / 100; i++) {
+        DebugText* text = frame->add_debug_texts();
+        text->set_text(std::string(100, 'x'));
+        text->mutable_pos()->set_x(i);
+        text->mutable_pos()->set_y(0);
+        text->set_layer(0);
+    }
+}
+
+}  // namespace
+
+TEST(LogFramePool, reusesArenas) {
+    auto pool = LogFramePool::create(4);
+
+    auto frame = pool->make();
+    ASSERT_NE(nullptr, frame->GetArena());
+    const google::protobuf::Arena* arena = frame->GetArena();
+    fill(frame.get(), 1000);
+    frame->set_timestamp(1);
+    EXPECT_EQ(0, pool->available());
+
+    frame.reset();
+    EXPECT_EQ(1, pool->available());
+
+    // The next frame is empty and built on the same arena
+    frame = pool->make();
+    EXPECT_EQ(arena, frame->GetArena());
+    EXPECT_FALSE(frame->has_timestamp());
+    EXPECT_EQ(0, frame->debug_texts_size());
+    EXPECT_EQ(0, pool->available());
+}
+
+TEST(LogFramePool, growsToFitFrames) {
+    auto pool = LogFramePool::create(4);
+    EXPECT_EQ(LogFramePool::MinBlockSize, pool->blockSize());
+
+    for (int i = 0; i < 300; i++) {
+        auto frame = pool->make();
+        fill(frame.get(), 4 * LogFramePool::MinBlockSize);
+    }
+    EXPECT_GT(pool->blockSize(), LogFramePool::MinBlockSize);
+
+    // A frame of the same size now fits in the initial block
+    auto frame = pool->make();
+    fill(frame.get(), 4 * LogFramePool::MinBlockSize);
+    EXPECT_EQ(pool->blockSize(), frame->GetArena()->SpaceAllocated());
+}
+
+TEST(LogFramePool, followsTypicalFrames) {
+    auto pool = LogFramePool::create(4);
+    for (int i = 0; i < 300; i++) {
+        auto frame = pool->make();
+        fill(frame.get(), 1000);
+    }
+    EXPECT_EQ(LogFramePool::MinBlockSize, pool->blockSize());
+
+    // One large frame doesn't make every later arena large
+    auto frame = pool->make();
+    fill(frame.get(), 10 * LogFramePool::MinBlockSize);
+    frame.reset();
+    EXPECT_EQ(LogFramePool::MinBlockSize, pool->blockSize());
+
+    // Blocks shrink again once large frames stop
+    for (int i = 0; i < 300; i++) {
+        frame = pool->make();
+        fill(frame.get(), 4 * LogFramePool::MinBlockSize);
+    }
+    frame.reset();
+    EXPECT_GT(pool->blockSize(), LogFramePool::MinBlockSize);
+    for (int i = 0; i < 600; i++) {
+        frame = pool->make();
+        fill(frame.get(), 1000);
+    }
+    frame.reset();
+    EXPECT_EQ(LogFramePool::MinBlockSize, pool->blockSize());
+}
+
+TEST(LogFramePool, keepsAtMostCapacity) {
+    auto pool = LogFramePool::create(2);
+
+    std::vector<std::shared_ptr<LogFrame>> frames;
+    for (int i = 0; i < 5; i++) {
+        frames.push_back(pool->make());
+    }
+    frames.clear();
+    EXPECT_EQ(2, pool->available());
+}
+
+TEST(LogFramePool, framesOutliveOwner) {
+    auto pool = LogFramePool::create(2);
+    auto frame = pool->make();
+    pool.reset();
+
+    fill(frame.get(), 1000);
+    EXPECT_EQ(10, frame->debug_texts_size());
+    frame.reset();
+}
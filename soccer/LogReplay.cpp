@@ -0,0 +1,58 @@
+#include "LogReplay.hpp"
+
+#include <iostream>
+
+#include "NewRefereeModule.hpp"
+
+using namespace std;
+
+LogReplay::LogReplay(Context* context, NewRefereeModule* referee)
+    : _context(context), _referee(referee) {}
+
+bool LogReplay::open(const string& filename) {
+    _next = 0;
+    if (!_reader.open(filename)) {
+        cerr << "LogReplay: Can't read " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+RJ::Time LogReplay::startTime() const {
+    if (_reader.size() == 0) {
+        return RJ::Time();
+    }
+    return RJ::Time(chrono::microseconds(_reader.timestamp(0)));
+}
+
+void LogReplay::run() {
+    const RJ::Timestamp now = RJ::timestamp();
+
+    for (; _next < _reader.size() &&
+           static_cast<RJ::Timestamp>(_reader.timestamp(_next)) <= now;
+         ++_next) {
+        shared_ptr<Packet::LogFrame> frame = _reader.frame(_next);
+        if (!frame) {
+            continue;
+        }
+
+        // The packets were received some time before the frame started, but
+        // that isn't recorded
+        const RJ::Time receivedTime =
+            RJ::Time(chrono::microseconds(frame->timestamp()));
+
+        for (const SSL_WrapperPacket& wrapper : frame->raw_vision()) {
+            auto packet = make_unique<VisionPacket>();
+            packet->receivedTime = receivedTime;
+            packet->wrapper = wrapper;
+            _context->vision_packets.push_back(move(packet));
+        }
+
+        for (const SSL_Referee& referee : frame->raw_refbox()) {
+            NewRefereePacket* packet = new NewRefereePacket;
+            packet->receivedTime = receivedTime;
+            packet->wrapper = referee;
+            _referee->addPacket(packet);
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <LogReader.hpp>
+#include <time.hpp>
+
+#include <string>
+
+#include "Context.hpp"
+#include "Node.hpp"
+
+class NewRefereeModule;
+
+/**
+ * @brief Plays back the vision and referee packets recorded in a log as if
+ * they were arriving from the network.
+ *
+ * @details Each call to run() moves the packets from every frame logged at or
+ * before RJ::now() into the context (vision) and the referee module (referee),
+ * like VisionReceiver does for live packets.  With an RJ::VirtualClock that
+ * starts at startTime(), the rest of soccer sees the recorded match at the
+ * original pace no matter how fast it runs.
+ */
+class LogReplay : public Node {
+public:
+    LogReplay(Context* context, NewRefereeModule* referee);
+
+    bool open(const std::string& filename);
+
+    /// Time of the first frame in the log
+    RJ::Time startTime() const;
+
+    /// True once every frame has been played back
+    bool done() const { return _next >= _reader.size(); }
+
+    virtual void run() override;
+
+private:
+    Context* _context;
+    NewRefereeModule* _referee;
+
+    LogReader _reader;
+
+    // Index of the next frame to play back
+    size_t _next = 0;
+};
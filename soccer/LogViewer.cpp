@@ -34,7 +34,8 @@ int main(int argc, char* argv[]) {
     return app.exec();
 }
 
-LogViewer::LogViewer(QWidget* parent) : QMainWindow(parent) {
+LogViewer::LogViewer(QWidget* parent)
+    : QMainWindow(parent), frames(4 * 60) {
     ui.setupUi(this);
 
     _history.resize(2 * 60);
@@ -62,44 +63,12 @@ LogViewer::LogViewer(QWidget* parent) : QMainWindow(parent) {
 }
 
 bool LogViewer::readFrames(const char* filename) {
-    frames.clear();
     ui.timeSlider->setMaximum(0);
 
-    QFile file(filename);
-    if (!file.open(QFile::ReadOnly)) {
-        fprintf(stderr, "Can't open %s: %s\n", filename,
-                (const char*)file.errorString().toLatin1());
-        return false;
-    }
-
-    int n = 0;
-    while (!file.atEnd()) {
-        uint32_t size = 0;
-        if (file.read((char*)&size, sizeof(size)) != sizeof(size)) {
-            // Broken length
-            printf("Broken length\n");
-            return false;
-        }
-
-        string str(size, 0);
-        if (file.read(&str[0], size) != size) {
-            // Broken packet at end of file
-            printf("Broken packet\n");
-            return false;
-        }
-
-        std::shared_ptr<LogFrame> frame = std::make_shared<LogFrame>();
-        frames.push_back(frame);
-        // Parse partial so we can recover from corrupt data
-        if (!frame->ParsePartialFromString(str)) {
-            printf("Failed: %s\n", frame->InitializationErrorString().c_str());
-            return false;
-        }
-        ++n;
-    }
+    bool ok = frames.open(filename);
 
     ui.timeSlider->setMaximum(frames.size());
-    return true;
+    return ok;
 }
 
 void LogViewer::updateViews() {
@@ -115,15 +84,23 @@ void LogViewer::updateViews() {
     _doubleFrameNumber = max(0.0, _doubleFrameNumber);
     _doubleFrameNumber = min(frames.size() - 1.0, _doubleFrameNumber);
 
+    if (frames.size() == 0) {
+        return;
+    }
+
     int f = frameNumber();
-    const LogFrame& currentFrame = *frames[f];
+    const std::shared_ptr<LogFrame> currentFramePtr = frames.frame(f);
+    if (!currentFramePtr) {
+        return;
+    }
+    const LogFrame& currentFrame = *currentFramePtr;
 
     ui.timeSlider->setValue(f);
 
     // Copy recent history into the FieldView
     int n = min(f, (int)_history.size());
     for (int i = 0; i < n; ++i) {
-        _history[i] = frames[f - i];
+        _history[i] = frames.frame(f - i);
     }
     for (int i = n; i < (int)_history.size(); ++i) {
         _history[i].reset();
@@ -132,8 +109,12 @@ void LogViewer::updateViews() {
     // Update non-message tree items
     _frameNumberItem->setData(ProtobufTree::Column_Value, Qt::DisplayRole,
                               frameNumber());
+    const std::shared_ptr<LogFrame> firstFrame = frames.frame(0);
     int elapsedMillis =
-        (currentFrame.command_time() - frames[0]->command_time() + 500) / 1000;
+        firstFrame
+            ? (currentFrame.command_time() - firstFrame->command_time() + 500) /
+                  1000
+            : 0;
     QTime elapsedTime = QTime::fromMSecsSinceStartOfDay(elapsedMillis);
     _elapsedTimeItem->setText(ProtobufTree::Column_Value,
                               elapsedTime.toString("hh:mm:ss.zzz"));
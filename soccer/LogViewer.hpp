@@ -2,6 +2,7 @@
 
 #include <ui_LogViewer.h>
 #include <protobuf/LogFrame.pb.h>
+#include <LogReader.hpp>
 
 #include <QTime>
 #include <QTimer>
@@ -17,10 +18,10 @@ public:
 
     void frameNumber(int value) { _doubleFrameNumber = value; }
 
-    // This is called when
+    // Opens a log file. Frames are parsed lazily as they are viewed.
     bool readFrames(const char* filename);
 
-    std::vector<std::shared_ptr<Packet::LogFrame> > frames;
+    LogReader frames;
 
 public Q_SLOTS:
     void updateViews();
@@ -1,92 +1,170 @@
 #include "Logger.hpp"
 
 #include <QString>
-#include <fcntl.h>
 #include <stdio.h>
-#include <unistd.h>
+#include <Trace.hpp>
 #include "Utils.hpp"
 
 using namespace std;
 using namespace Packet;
 using namespace google::protobuf::io;
 
-Logger::Logger(size_t logSize) : _history(logSize) {
-    _fd = -1;
+namespace {
+
+// Memory held by @frame.  A frame built on an arena (see LogFramePool) holds
+// the whole arena, which is also much cheaper to measure than walking the
+// message.
+size_t frameSpace(const LogFrame& frame) {
+    if (google::protobuf::Arena* arena = frame.GetArena()) {
+        return arena->SpaceAllocated();
+    }
+    return frame.SpaceUsed();
+}
+
+}  // namespace
+
+Logger::Logger(size_t logSize)
+    : _history(logSize), _writeQueue(WriteQueueCapacity) {
     _spaceUsed = sizeof(shared_ptr<Packet::LogFrame>) * _history.size();
 }
 
 Logger::~Logger() { close(); }
 
 bool Logger::open(QString filename) {
-    QWriteLocker locker(&_lock);
+    lock_guard<mutex> fileLock(_fileMutex);
 
-    if (_fd >= 0) {
-        close();
-    }
+    stopWriter();
 
-    _fd = creat(filename.toLatin1(), 0666);
-    if (_fd < 0) {
-        printf("Can't create %s: %m\n", (const char*)filename.toLatin1());
+    if (!_file.open(filename.toStdString())) {
         return false;
     }
 
+    // Throw away anything left over from a previous log.  The writer isn't
+    // running, so this thread is the only consumer.
+    while (_writeQueue.tryPop()) {
+    }
+
     _filename = filename;
+    _droppedFrames = 0;
+    _stopWriter = false;
+    _recording = true;
+    _writer = std::thread(&Logger::writerLoop, this);
 
     return true;
 }
 
 void Logger::close() {
-    QWriteLocker locker(&_lock);
-    if (_fd >= 0) {
-        ::close(_fd);
-        _fd = -1;
-        _filename = QString();
+    lock_guard<mutex> fileLock(_fileMutex);
+
+    stopWriter();
+    _filename = QString();
+}
+
+void Logger::stopWriter() {
+    _recording = false;
+    if (_writer.joinable()) {
+        {
+            lock_guard<mutex> lock(_wakeMutex);
+            _stopWriter = true;
+        }
+        _wake.notify_one();
+        _writer.join();
+    }
+
+    // Writes out the last partial chunk
+    _file.close();
+}
+
+void Logger::writerLoop() {
+    Trace::setThreadName("Logger writer");
+
+    vector<shared_ptr<LogFrame>> batch;
+    batch.reserve(MaxWriteBatch);
+
+    while (true) {
+        while (batch.size() < MaxWriteBatch) {
+            auto frame = _writeQueue.tryPop();
+            if (!frame) {
+                break;
+            }
+            batch.push_back(std::move(*frame));
+        }
+
+        if (!batch.empty()) {
+            if (!writeBatch(batch)) {
+                _recording = false;
+                return;
+            }
+            batch.clear();
+            continue;
+        }
+
+        // The queue is drained, so it's safe to stop
+        if (_stopWriter) {
+            return;
+        }
+
+        // addFrame() doesn't take _wakeMutex, so a wakeup can be missed; the
+        // timeout bounds how long a frame waits in that case
+        unique_lock<mutex> lock(_wakeMutex);
+        _wake.wait_for(lock, 10ms, [this]() {
+            return _stopWriter || !_writeQueue.empty();
+        });
     }
 }
 
+bool Logger::writeBatch(const vector<shared_ptr<LogFrame>>& batch) {
+    TRACE_SCOPE("Logger::writeBatch");
+    for (const auto& frame : batch) {
+        if (!_file.write(*frame)) {
+            printf("Logger: Failed to write frames, closing log\n");
+            return false;
+        }
+    }
+    return true;
+}
+
 void Logger::addFrame(shared_ptr<LogFrame> frame) {
     this->addFrame(frame, false);
 }
 
 void Logger::addFrame(shared_ptr<LogFrame> frame, bool force) {
+    TRACE_SCOPE("Logger::addFrame");
+
+    // Hand the frame to the writer thread without blocking
+    if (_recording) {
+        if (_writeQueue.tryPush(frame)) {
+            _wake.notify_one();
+        } else {
+            _droppedFrames++;
+        }
+    }
+
     QWriteLocker locker(&_lock);
 
     if (_history.empty()) {
         _startTime = RJ::Time(chrono::microseconds(frame->timestamp()));
     }
 
-    // Write this from to the file
-    if (_fd >= 0) {
-        if (frame->IsInitialized()) {
-            uint32_t size = frame->ByteSize();
-            if (write(_fd, &size, sizeof(size)) != sizeof(size)) {
-                printf("Logger: Failed to write size, closing log: %m\n");
-                close();
-            } else if (!frame->SerializeToFileDescriptor(_fd)) {
-                printf("Logger: Failed to write frame, closing log: %m\n");
-                close();
-            }
-        } else {
-            printf("Logger: Not writing frame missing fields: %s\n",
-                   frame->InitializationErrorString().c_str());
-        }
-    }
-
-    if (_history.full() && !force) {
-        _spaceUsed -= _history.front()->SpaceUsed();
+    // A full circular buffer drops its oldest frame on push_back() even when
+    // forced, so that frame's space is always given back
+    if (_history.full()) {
+        _spaceUsed -= frameSpace(*_history.front());
         _history.pop_front();
     }
-    // Create a new LogFrame
 
     _history.push_back(frame);
 
     // Add space used by the new data
-    _spaceUsed += frame->SpaceUsed();
+    _spaceUsed += frameSpace(*frame);
     _nextFrameNumber++;
 }
 
 shared_ptr<LogFrame> Logger::lastFrame() const {
     QReadLocker locker(&_lock);
+    if (_reader) {
+        return _reader->size() ? _reader->frame(_reader->size() - 1) : nullptr;
+    }
     return _history.back();
 }
 
@@ -100,37 +178,20 @@ void Logger::clear() {
 bool Logger::readFrames(const char* filename) {
     this->clear();
 
-    QFile file(filename);
-    if (!file.open(QFile::ReadOnly)) {
-        fprintf(stderr, "Can't open %s: %s\n", filename,
-                (const char*)file.errorString().toLatin1());
+    // Frames are parsed on demand, keeping at most as many in memory as the
+    // live history would
+    auto reader = std::make_unique<LogReader>(_history.capacity());
+    const bool ok = reader->open(filename);
+    if (!reader->isOpen()) {
         return false;
     }
 
-    int n = 0;
-    while (!file.atEnd()) {
-        uint32_t size = 0;
-        if (file.read((char*)&size, sizeof(size)) != sizeof(size)) {
-            // Broken length
-            printf("Broken length\n");
-            return false;
-        }
-
-        string str(size, 0);
-        if (file.read(&str[0], size) != size) {
-            // Broken packet at end of file
-            printf("Broken packet\n");
-            return false;
-        }
-
-        std::shared_ptr<LogFrame> frame = std::make_shared<LogFrame>();
-        if (!frame->ParsePartialFromString(str)) {
-            printf("Failed: %s\n", frame->InitializationErrorString().c_str());
-            return false;
-        }
-        this->addFrame(frame, true);
-        ++n;
+    QWriteLocker locker(&_lock);
+    if (reader->size() > 0) {
+        _startTime = RJ::Time(chrono::microseconds(reader->timestamp(0)));
     }
+    _nextFrameNumber = reader->size();
+    _reader = std::move(reader);
 
-    return true;
+    return ok;
 }
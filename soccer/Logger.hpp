@@ -28,6 +28,18 @@
  *
  * Frames are allocated as they are first needed.  The size of the circular
  * buffer limits total memory usage.
+ *
+ * Frames are written to disk by a dedicated writer thread.  addFrame() only
+ * hands the frame over through a bounded lock-free queue, so the control loop
+ * never waits on disk I/O.  If the writer falls behind and the queue fills up,
+ * frames are dropped from the file (but still kept in the history) and counted
+ * in droppedFrames().
+ *
+ * Logs are written in the compressed format (see LogFormat.hpp) together with
+ * an index of frame offsets and timestamps.  Compression happens on the writer
+ * thread as well.  Logs opened with readFrames() are served lazily
+ * from a memory-mapped LogReader instead of the circular buffer, so opening a
+ * long log is fast and memory stays bounded by capacity().
  */
 
 #pragma once
@@ -40,8 +52,15 @@
 #include <QReadWriteLock>
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include "time.hpp"
+#include <LogReader.hpp>
+#include <LogWriter.hpp>
+#include <SpscQueue.hpp>
 #include <boost/circular_buffer.hpp>
 
 class Logger {
@@ -55,13 +74,16 @@ public:
     // Returns the size of the circular buffer
     size_t capacity() const { return _history.capacity(); }
 
-    // Returns the sequence number of the most recently added frame.
-    // Returns -1 if no frames have been added.
-    size_t size() const { return _history.size(); }
+    // Returns the number of frames available
+    size_t size() const {
+        return _reader ? _reader->size() : _history.size();
+    }
 
     std::shared_ptr<Packet::LogFrame> lastFrame() const;
 
     // Adds a frame to this logger. force will force the frame to be added even if we are full.
+    // Must only be called from one thread (the Processor).  The frame must not
+    // be modified afterwards, since the writer thread serializes it later.
     void addFrame(std::shared_ptr<Packet::LogFrame> frame, bool force);
     void addFrame(std::shared_ptr<Packet::LogFrame> frame);
 
@@ -75,21 +97,34 @@ public:
                   std::vector<std::shared_ptr<Packet::LogFrame>>& frames) const;
 
     // Returns the amount of memory used by all LogFrames in the history.
-    int spaceUsed() const { return _spaceUsed; }
+    size_t spaceUsed() const {
+        return _reader ? _reader->spaceUsed() : _spaceUsed;
+    }
+
+    bool recording() const { return _recording; }
 
-    bool recording() const { return _fd >= 0; }
+    // Number of frames that were not written to the log file because the
+    // writer thread's queue was full
+    uint64_t droppedFrames() const { return _droppedFrames; }
 
     QString filename() const { return _filename; }
 
-    int firstFrameNumber() const {
-        return currentFrameNumber() - _history.size() + 1;
-    }
+    int firstFrameNumber() const { return currentFrameNumber() - size() + 1; }
 
     int currentFrameNumber() const { return _nextFrameNumber - 1; }
 
     template <typename OutputIterator>
     int getFrames(int endIndex, int num, OutputIterator result) const {
         QReadLocker locker(&_lock);
+        if (_reader) {
+            endIndex = std::min(_nextFrameNumber, endIndex);
+            int numToCopy = std::min(endIndex - 1, num);
+            for (int i = 0; i < numToCopy; i++) {
+                *result++ = _reader->frame(endIndex - 1 - i);
+            }
+            return std::max(numToCopy, 0);
+        }
+
         auto end = _history.rbegin();
         endIndex = std::min(_nextFrameNumber, endIndex);
         int numFromBack = _nextFrameNumber - endIndex;
@@ -123,10 +158,46 @@ private:
      */
     boost::circular_buffer<std::shared_ptr<Packet::LogFrame>> _history;
 
-    int _spaceUsed;
+    size_t _spaceUsed;
+
+    // Maximum number of frames waiting to be written (10 seconds at 60Hz)
+    static constexpr size_t WriteQueueCapacity = 600;
+
+    // Maximum number of frames written with a single writev()
+    static constexpr size_t MaxWriteBatch = 64;
+
+    // Body of the writer thread
+    void writerLoop();
+
+    // Hands frames to _file, which writes them out a chunk at a time.
+    // Returns false if the log could not be written.
+    bool writeBatch(const std::vector<std::shared_ptr<Packet::LogFrame>>& batch);
+
+    // Finishes writing queued frames and joins the writer thread
+    void stopWriter();
+
+    // Serializes open() and close()
+    std::mutex _fileMutex;
+
+    // Compresses frames into the log file and writes its index.
+    // Owned by the writer thread while it is running.
+    LogWriter _file;
+
+    // Frames waiting to be written.  addFrame() is the only producer and the
+    // writer thread is the only consumer.
+    SpscQueue<std::shared_ptr<Packet::LogFrame>> _writeQueue;
+
+    std::thread _writer;
+    std::atomic<bool> _recording{false};
+    std::atomic<bool> _stopWriter{false};
+    std::atomic<uint64_t> _droppedFrames{0};
+
+    // Used only to sleep the writer thread while the queue is empty
+    std::mutex _wakeMutex;
+    std::condition_variable _wake;
 
-    // File descriptor for log file
-    int _fd;
+    // Set when viewing a log read by readFrames()
+    std::unique_ptr<LogReader> _reader;
 
     // Sequence number of the next frame to be written
     int _nextFrameNumber = 0;
@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+#include "LogFramePool.hpp"
+#include "Logger.hpp"
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <boost/circular_buffer.hpp>
+
+using namespace Packet;
+
+namespace {
+
+/// Fills @frame with the world state and a little debug drawing, roughly the
+/// size of what the Processor logs during a game
+void fillFrame(LogFrame& frame) {
+    frame.set_timestamp(RJ::timestamp());
+    frame.set_command_time(frame.timestamp());
+    frame.set_blue_team(false);
+
+    for (int i = 0; i < 6; i++) {
+        for (auto* robot : {frame.add_self(), frame.add_opp()}) {
+            robot->mutable_pos()->set_x(i);
+            robot->mutable_pos()->set_y(i);
+            robot->mutable_world_vel()->set_x(0);
+            robot->mutable_world_vel()->set_y(0);
+            robot->set_shell(i);
+            robot->set_angle(0);
+        }
+    }
+    frame.mutable_ball()->mutable_pos()->set_x(0);
+    frame.mutable_ball()->mutable_pos()->set_y(4.5);
+    frame.mutable_ball()->mutable_vel()->set_x(0);
+    frame.mutable_ball()->mutable_vel()->set_y(0);
+
+    for (int i = 0; i < 20; i++) {
+        DebugPath* path = frame.add_debug_paths();
+        path->set_layer(0);
+        for (int j = 0; j < 10; j++) {
+            Point* pt = path->add_points();
+            pt->set_x(j);
+            pt->set_y(i);
+        }
+    }
+}
+
+LogFrame makeFrame() {
+    LogFrame frame;
+    fillFrame(frame);
+    return frame;
+}
+
+// Frames are never modified once they are added, so each iteration copies the
+// template frame (untimed) like the Processor builds a new one every cycle
+void addFrames(benchmark::State& state, Logger& logger) {
+    const LogFrame frame = makeFrame();
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto copy = std::make_shared<LogFrame>(frame);
+        copy->set_timestamp(frame.timestamp() + state.iterations());
+        state.ResumeTiming();
+
+        logger.addFrame(copy);
+    }
+    state.SetBytesProcessed(state.iterations() * frame.ByteSize());
+}
+
+}  // namespace
+
+// Keeping history only, as when the logger isn't recording to a file
+static void BM_LoggerAddFrame(benchmark::State& state) {
+    Logger logger;
+    addFrames(state, logger);
+}
+BENCHMARK(BM_LoggerAddFrame);
+
+// Recording to a file.  Only the hand-off to the writer thread is on the
+// caller's path; the time the writer takes shows up as dropped frames.
+static void BM_LoggerAddFrameRecording(benchmark::State& state) {
+    char filename[] = "/tmp/LoggerBenchXXXXXX";
+    ::close(mkstemp(filename));
+
+    Logger logger;
+    logger.open(filename);
+    addFrames(state, logger);
+    logger.close();
+    state.counters["dropped"] = logger.droppedFrames();
+
+    unlink(filename);
+    unlink(logIndexFilename(filename).c_str());
+}
+BENCHMARK(BM_LoggerAddFrameRecording);
+
+// Building each cycle's frame, which lives in a history of 600 frames before
+// it is destroyed.  Arg 1 builds frames with a LogFramePool instead of the
+// heap.
+static void BM_LogFrameBuild(benchmark::State& state) {
+    const size_t history = 600;
+    auto pool = LogFramePool::create(history + 1);
+    boost::circular_buffer<std::shared_ptr<LogFrame>> frames(history);
+    for (auto _ : state) {
+        auto frame =
+            state.range(0) ? pool->make() : std::make_shared<LogFrame>();
+        fillFrame(*frame);
+        frames.push_back(std::move(frame));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogFrameBuild)->ArgName("pooled")->Arg(0)->Arg(1);
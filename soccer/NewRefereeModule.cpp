@@ -6,6 +6,7 @@
 
 #include <Network.hpp>
 #include <multicast.hpp>
+#include <Trace.hpp>
 #include <Utils.hpp>
 #include <unistd.h>
 #include <QMutexLocker>
@@ -130,6 +131,7 @@ void NewRefereeModule::getPackets(std::vector<NewRefereePacket*>& packets) {
 }
 
 void NewRefereeModule::run() {
+    Trace::setThreadName("Referee");
     QUdpSocket socket;
 
     if (!socket.bind(ProtobufRefereePort, QUdpSocket::ShareAddress)) {
@@ -162,54 +164,60 @@ void NewRefereeModule::run() {
 
         NewRefereePacket* packet = new NewRefereePacket;
         packet->receivedTime = RJ::now();
-        this->received_time = packet->receivedTime;
         if (!packet->wrapper.ParseFromArray(buf, size)) {
             fprintf(stderr,
                     "NewRefereeModule: got bad packet of %d bytes from %s:%d\n",
                     (int)size, (const char*)host.toString().toLatin1(), port);
             fprintf(stderr, "Packet: %s\n", buf);
             fprintf(stderr, "Address: %s\n", RefereeAddress);
+            delete packet;
             continue;
         }
 
-        _mutex.lock();
-        _packets.push_back(packet);
-
-        stage = (Stage)packet->wrapper.stage();
-        command = (Command)packet->wrapper.command();
-        sent_time = RJ::Time(
-            std::chrono::microseconds(packet->wrapper.packet_timestamp()));
-        stage_time_left =
-            std::chrono::milliseconds(packet->wrapper.stage_time_left());
-        command_counter = packet->wrapper.command_counter();
-        command_timestamp = RJ::Time(
-            std::chrono::microseconds(packet->wrapper.command_timestamp()));
-        yellow_info.ParseRefboxPacket(packet->wrapper.yellow());
-        blue_info.ParseRefboxPacket(packet->wrapper.blue());
-        ballPlacementx = packet->wrapper.designated_position().x();
-        ballPlacementy = packet->wrapper.designated_position().y();
-
-        // If we have no name, we're using a default config and there's no
-        // sense trying to match the referee's output (because chances are
-        // everything is just on default configuration with no names, so more
-        // than one team/soccer instance will be trying to use the same color)
-        if (Team_Name_Lower.length() > 0) {
-            // We only want to change teams if we get something that actually
-            // matches our team name (either yellow or blue).
-            // Otherwise, keep the current color.
-            if (boost::iequals(yellow_info.name, Team_Name_Lower)) {
-                blueTeam(false);
-                _isRefControlled = true;
-            } else if (boost::iequals(blue_info.name, Team_Name_Lower)) {
-                blueTeam(true);
-                _isRefControlled = true;
-            } else {
-                _isRefControlled = false;
-            }
-        }
+        addPacket(packet);
+    }
+}
 
-        _mutex.unlock();
+void NewRefereeModule::addPacket(NewRefereePacket* packet) {
+    TRACE_SCOPE("NewRefereeModule::addPacket");
+    _mutex.lock();
+    this->received_time = packet->receivedTime;
+    _packets.push_back(packet);
+
+    stage = (Stage)packet->wrapper.stage();
+    command = (Command)packet->wrapper.command();
+    sent_time = RJ::Time(
+        std::chrono::microseconds(packet->wrapper.packet_timestamp()));
+    stage_time_left =
+        std::chrono::milliseconds(packet->wrapper.stage_time_left());
+    command_counter = packet->wrapper.command_counter();
+    command_timestamp = RJ::Time(
+        std::chrono::microseconds(packet->wrapper.command_timestamp()));
+    yellow_info.ParseRefboxPacket(packet->wrapper.yellow());
+    blue_info.ParseRefboxPacket(packet->wrapper.blue());
+    ballPlacementx = packet->wrapper.designated_position().x();
+    ballPlacementy = packet->wrapper.designated_position().y();
+
+    // If we have no name, we're using a default config and there's no
+    // sense trying to match the referee's output (because chances are
+    // everything is just on default configuration with no names, so more
+    // than one team/soccer instance will be trying to use the same color)
+    if (Team_Name_Lower.length() > 0) {
+        // We only want to change teams if we get something that actually
+        // matches our team name (either yellow or blue).
+        // Otherwise, keep the current color.
+        if (boost::iequals(yellow_info.name, Team_Name_Lower)) {
+            blueTeam(false);
+            _isRefControlled = true;
+        } else if (boost::iequals(blue_info.name, Team_Name_Lower)) {
+            blueTeam(true);
+            _isRefControlled = true;
+        } else {
+            _isRefControlled = false;
+        }
     }
+
+    _mutex.unlock();
 }
 
 void NewRefereeModule::overrideTeam(bool isBlue) {
@@ -236,7 +244,7 @@ void NewRefereeModule::spinKickWatcher() {
                 if (!_context->state.ball.pos.nearPoint(_readyBallPos,
                                                         KickThreshold)) {
                     // The ball appears to have moved
-                    _kickTime = QTime::currentTime();
+                    _kickTime = RJ::now();
                     _kickDetectState = VerifyKick;
                 }
                 break;
@@ -247,8 +255,8 @@ void NewRefereeModule::spinKickWatcher() {
                     // The ball is back where it was.  There was probably a
                     // vision error.
                     _kickDetectState = WaitForKick;
-                } else if (_kickTime.msecsTo(QTime::currentTime()) >=
-                           KickVerifyTime_ms) {
+                } else if (RJ::now() - _kickTime >=
+                           std::chrono::milliseconds(KickVerifyTime_ms)) {
                     // The ball has been far enough away for enough time, so
                     // call this a kick.
                     _kickDetectState = Kicked;
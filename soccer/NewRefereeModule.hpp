@@ -144,6 +144,15 @@ public:
 
     void getPackets(std::vector<NewRefereePacket*>& packets);
 
+    /**
+     * Handles a packet as if it had just been received from the network.
+     * This is how recorded referee packets are fed in during replay, when the
+     * thread isn't started.
+     *
+     * Takes ownership of @packet.
+     */
+    void addPacket(NewRefereePacket* packet);
+
     bool kicked() { return _kickDetectState == Kicked; }
 
     void useExternalReferee(bool value) { _useExternalRef = value; }
@@ -220,7 +229,7 @@ protected:
     Geometry2d::Point _readyBallPos;
 
     // Time the ball was first beyond KickThreshold from its original position
-    QTime _kickTime;
+    RJ::Time _kickTime;
 
     QMutex _mutex;
     std::vector<NewRefereePacket*> _packets;
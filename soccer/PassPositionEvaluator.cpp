@@ -0,0 +1,250 @@
+#include "PassPositionEvaluator.hpp"
+#include "Constants.hpp"
+#include "KickEvaluator.hpp"
+#include "WindowEvaluator.hpp"
+#include "optimization/NelderMead2D.hpp"
+#include "optimization/NelderMead2DConfig.hpp"
+#include "optimization/ParallelNelderMead2D.hpp"
+#include "optimization/ParallelNelderMead2DConfig.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+using namespace std;
+using namespace Geometry2d;
+
+PassPositionEvaluator::PassPositionEvaluator(Context* context)
+    : context(context) {}
+
+float PassPositionEvaluator::eval_single_point(Point kickPoint,
+                                               Point receivePoint) {
+    if (out_of_bounds(kickPoint, receivePoint)) {
+        return 0;
+    }
+
+    // The rest of the score doesn't matter if the pass can't get there
+    const float passChance = pass_chance(kickPoint, receivePoint);
+    if (passChance == 0) {
+        return 0;
+    }
+
+    KickEvaluator kickEval(&context->state);
+    kickEval.excluded_robots = excluded_robots;
+    const float shotChance = kickEval.eval_pt_to_opp_goal(receivePoint).second;
+
+    return combine(kickPoint, receivePoint, passChance, shotChance);
+}
+
+vector<vector<float>> PassPositionEvaluator::eval_field(Point kickPoint,
+                                                        int numWidth,
+                                                        int numLength) {
+    const float width = Field_Dimensions::Current_Dimensions.Width();
+    const float length = Field_Dimensions::Current_Dimensions.Length();
+
+    vector<vector<float>> heatmap(numWidth, vector<float>(numLength, 0));
+
+    // Find the cells worth a shot evaluation, and their pass chances
+    vector<Point> receivePoints;
+    vector<float> passChances;
+    vector<pair<int, int>> cells;
+    for (int x = 0; x < numWidth; x++) {
+        for (int y = 0; y < numLength; y++) {
+            const Point receivePoint(-width / 2 + (x + 0.5) * width / numWidth,
+                                     (y + 0.5) * length / numLength);
+            if (out_of_bounds(kickPoint, receivePoint)) {
+                continue;
+            }
+
+            const float passChance = pass_chance(kickPoint, receivePoint);
+            if (passChance == 0) {
+                continue;
+            }
+
+            receivePoints.push_back(receivePoint);
+            passChances.push_back(passChance);
+            cells.emplace_back(x, y);
+        }
+    }
+
+    KickEvaluator kickEval(&context->state);
+    kickEval.excluded_robots = excluded_robots;
+    const vector<KickResults> shots =
+        kickEval.eval_pts_to_opp_goal(receivePoints);
+
+    for (size_t i = 0; i < cells.size(); i++) {
+        heatmap[cells[i].first][cells[i].second] = combine(
+            kickPoint, receivePoints[i], passChances[i], shots[i].second);
+    }
+
+    return heatmap;
+}
+
+Point PassPositionEvaluator::field_max_point(
+    const vector<vector<float>>& heatmap) {
+    if (heatmap.empty() || heatmap[0].empty()) {
+        return Point();
+    }
+
+    const float width = Field_Dimensions::Current_Dimensions.Width();
+    const float length = Field_Dimensions::Current_Dimensions.Length();
+
+    // Ties go to the first cell, like the overlay's max
+    int bestX = 0;
+    int bestY = 0;
+    for (int x = 0; x < heatmap.size(); x++) {
+        for (int y = 0; y < heatmap[x].size(); y++) {
+            if (heatmap[x][y] > heatmap[bestX][bestY]) {
+                bestX = x;
+                bestY = y;
+            }
+        }
+    }
+
+    const int numWidth = heatmap.size();
+    const int numLength = heatmap[0].size();
+    return Point(-width / 2 + (bestX + 0.5) * width / numWidth,
+                 (bestY + 0.5) * length / numLength);
+}
+
+pair<Point, float> PassPositionEvaluator::eval_best_receive_point(
+    Point kickPoint, Point start, Point step, Point minDist,
+    float reflectionCoeff, float expansionCoeff, float contractionCoeff,
+    float shrinkCoeff, int maxIterations, float maxValue, float maxThresh) {
+    function<float(Point)> f = [this, kickPoint](Point receivePoint) {
+        return eval_single_point(kickPoint, receivePoint);
+    };
+
+    NelderMead2DConfig config(f, start, step, minDist, reflectionCoeff,
+                              expansionCoeff, contractionCoeff, shrinkCoeff,
+                              maxIterations, maxValue, maxThresh);
+    NelderMead2D nm(config);
+    nm.execute();
+
+    return make_pair(nm.getPoint(), nm.getValue());
+}
+
+pair<Point, float> PassPositionEvaluator::eval_best_receive_point(
+    Point kickPoint, const vector<Point>& starts, RJ::Seconds timeBudget,
+    Point step, Point minDist, float reflectionCoeff, float expansionCoeff,
+    float contractionCoeff, float shrinkCoeff, int maxIterations,
+    float maxValue, float maxThresh) {
+    // Only reads the state, so it's safe to call from every simplex at once
+    function<float(Point)> f = [this, kickPoint](Point receivePoint) {
+        return eval_single_point(kickPoint, receivePoint);
+    };
+
+    NelderMead2DConfig nmConfig(f, Point(), step, minDist, reflectionCoeff,
+                                expansionCoeff, contractionCoeff, shrinkCoeff,
+                                maxIterations, maxValue, maxThresh);
+    ParallelNelderMead2DConfig config(nmConfig, starts, timeBudget);
+    ParallelNelderMead2D pnm(config);
+    pnm.execute();
+
+    return make_pair(pnm.getPoint(), pnm.getValue());
+}
+
+bool PassPositionEvaluator::out_of_bounds(Point kickPoint,
+                                          Point receivePoint) const {
+    const float width = Field_Dimensions::Current_Dimensions.Width();
+    const float length = Field_Dimensions::Current_Dimensions.Length();
+    const float xOffset = 0.1 * width;
+    const float yOffset = 0.1 * length;
+
+    // Can be smoothed for a better solution
+    const Rect goalZone =
+        Field_Dimensions::Current_Dimensions.TheirGoalZoneShape();
+    const Point robotOffset(Robot_Radius * 6, Robot_Radius * 6);
+    const Point shifted = receivePoint + Point(0, yOffset);
+    if (receivePoint.x() - xOffset < -width / 2 ||
+        receivePoint.x() + xOffset > width / 2 ||
+        receivePoint.y() - yOffset < 0 ||
+        receivePoint.y() + yOffset > length ||
+        goalZone.containsPoint(shifted + robotOffset) ||
+        goalZone.containsPoint(shifted - robotOffset)) {
+        return true;
+    }
+
+    return (receivePoint - kickPoint).mag() < min_pass_dist;
+}
+
+float PassPositionEvaluator::pass_chance(Point kickPoint, Point receivePoint) {
+    // Make a pass triangle with the far corner at the kick and the opposite
+    // side across the receiver's mouth, then see how open it is.  The side's
+    // length grows with the square of the pass distance, as it did in python.
+    const float passAngle = M_PI / 32.0;
+    const Point passPerp = (receivePoint - kickPoint).perpCCW();
+    const float halfLength = tan(passAngle) * receivePoint.distTo(kickPoint);
+    const Segment receiveSeg(receivePoint + passPerp * halfLength,
+                             receivePoint - passPerp * halfLength);
+
+    WindowEvaluator winEval(context);
+    winEval.excluded_robots = excluded_robots;
+    const optional<Window> best =
+        winEval.eval_pt_to_seg(kickPoint, receiveSeg).second;
+    if (!best) {
+        return 0;
+    }
+
+    // Squared to make the open part of the pass count for more
+    const float ratio = best->segment.length() / receiveSeg.length();
+    return 0.8 * ratio * ratio;
+}
+
+float PassPositionEvaluator::space_coeff(Point pos) const {
+    const float maxDist =
+        Point(Field_Dimensions::Current_Dimensions.Width() / 2,
+              Field_Dimensions::Current_Dimensions.Length())
+            .mag();
+    const float sensitivity = 8;
+
+    float total = 0;
+    for (const OpponentRobot* bot : context->state.opp) {
+        if (!bot->visible() ||
+            find(excluded_robots.begin(), excluded_robots.end(), bot) !=
+                excluded_robots.end()) {
+            continue;
+        }
+
+        // Triweight kernel, which looks much like a normal distribution
+        const float u = sensitivity * (bot->pos() - pos).mag() / maxDist;
+        total += max(35.0f / 32 * powf(1 - u * u, 3), 0.0f);
+    }
+
+    return min(total, 1.0f);
+}
+
+float PassPositionEvaluator::field_pos_coeff(Point pos) const {
+    const float width = Field_Dimensions::Current_Dimensions.Width();
+    const float length = Field_Dimensions::Current_Dimensions.Length();
+
+    // Closeness to the line between the goals
+    const float centerValue = 1 - fabs(pos.x() / (width / 2));
+
+    // Closeness to their goal
+    const float distValue = fabs(pos.y() / length);
+
+    // Angle onto their goal, where straight on is best
+    const float angle = atan2(pos.x(), length - pos.y());
+    const float anglValue = 1 - fabs(angle / (M_PI / 2));
+
+    const float total = field_weights[0] + field_weights[1] + field_weights[2];
+    return (field_weights[0] * centerValue + field_weights[1] * distValue +
+            field_weights[2] * anglValue) /
+           total;
+}
+
+float PassPositionEvaluator::combine(Point kickPoint, Point receivePoint,
+                                     float passChance,
+                                     float shotChance) const {
+    const float space = space_coeff(receivePoint);
+    const float fieldPos = field_pos_coeff(receivePoint);
+    const float distance = exp(-(kickPoint - receivePoint).mag());
+
+    // Every other score depends on the pass actually making it
+    const float totalChance =
+        passChance * (weights[0] * (1 - space) + weights[1] * fieldPos +
+                      weights[2] * shotChance + weights[3] * (1 - distance));
+
+    return totalChance / (weights[0] + weights[1] + weights[2] + weights[3]);
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <Geometry2d/Point.hpp>
+#include "Robot.hpp"
+#include "SystemState.hpp"
+#include <time.hpp>
+
+#include <array>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Scores points on the field as places to receive a pass
+ *
+ * @details This is the native version of
+ * evaluation.passing_positioning.eval_single_point.  A point's score combines
+ * the chance of the pass making it there with how open the point is, its
+ * position on the field, the chance of a shot on goal from it and how far it
+ * is from the kick.
+ */
+class PassPositionEvaluator {
+public:
+    /**
+     * @brief Constructor
+     * @param context pointer to the global context
+     */
+    PassPositionEvaluator(Context* context);
+
+    /**
+     * @brief Scores a single receive point
+     * @param kickPoint Point the pass is kicked from
+     * @param receivePoint Point the pass is received at
+     * @return Score between 0 and 1 on how good of a pass it would be
+     */
+    float eval_single_point(Geometry2d::Point kickPoint,
+                            Geometry2d::Point receivePoint);
+
+    /**
+     * @brief Scores the center of every cell of a grid over the field
+     * @details The grid is the same as
+     * visualization.overlay.get_visualization_points.  Shots are evaluated
+     * as one KickEvaluator batch, which spreads them across threads.
+     * @param kickPoint Point the pass is kicked from
+     * @param numWidth Number of cells across the field
+     * @param numLength Number of cells along the field
+     * @return Scores indexed by [x][y], x from left to right and y from our
+     *     goal to theirs
+     */
+    std::vector<std::vector<float>> eval_field(Geometry2d::Point kickPoint,
+                                               int numWidth, int numLength);
+
+    /**
+     * @return Center of the grid cell with the highest score in @heatmap, as
+     *     returned by eval_field()
+     */
+    static Geometry2d::Point field_max_point(
+        const std::vector<std::vector<float>>& heatmap);
+
+    /**
+     * @brief Finds the best point to receive a pass with NelderMead2D
+     * @details The remaining parameters are passed to NelderMead2DConfig.
+     * @param kickPoint Point the pass is kicked from
+     * @param start Point to start the search at, for example
+     *     field_max_point() of a coarse eval_field()
+     * @return Best point and its score
+     */
+    std::pair<Geometry2d::Point, float> eval_best_receive_point(
+        Geometry2d::Point kickPoint, Geometry2d::Point start,
+        Geometry2d::Point step = Geometry2d::Point(0.5, 0.5),
+        Geometry2d::Point minDist = Geometry2d::Point(0.01, 0.01),
+        float reflectionCoeff = 1, float expansionCoeff = 2,
+        float contractionCoeff = 0.75, float shrinkCoeff = 0.5,
+        int maxIterations = 50, float maxValue = 1, float maxThresh = 0.1);
+
+    /**
+     * @brief Finds the best point to receive a pass with a NelderMead2D from
+     * each of @starts, run in parallel
+     * @details The remaining parameters are the same as the single start
+     * version.
+     * @param kickPoint Point the pass is kicked from
+     * @param starts Points to start the searches at, for example the best
+     *     cells of eval_field()
+     * @param timeBudget Time after which the searches stop, or zero for no
+     *     limit
+     * @return Best point and its score over all the searches
+     */
+    std::pair<Geometry2d::Point, float> eval_best_receive_point(
+        Geometry2d::Point kickPoint,
+        const std::vector<Geometry2d::Point>& starts, RJ::Seconds timeBudget,
+        Geometry2d::Point step = Geometry2d::Point(0.5, 0.5),
+        Geometry2d::Point minDist = Geometry2d::Point(0.01, 0.01),
+        float reflectionCoeff = 1, float expansionCoeff = 2,
+        float contractionCoeff = 0.75, float shrinkCoeff = 0.5,
+        int maxIterations = 50, float maxValue = 1, float maxThresh = 0.1);
+
+    /**
+     * @brief Robots that should not be considered obstacles
+     */
+    std::vector<Robot*> excluded_robots;
+
+    /**
+     * @brief Receive points closer than this to the kick score zero
+     */
+    float min_pass_dist = 0;
+
+    /**
+     * @brief Weights of the field position score
+     * @details (Centerness, distance to their goal, angle off their goal)
+     */
+    std::array<float, 3> field_weights = {0.1, 3.2, 0.1};
+
+    /**
+     * @brief Weights of each part of the overall score
+     * @details (Space, field position, shot chance, kick proximity)
+     */
+    std::array<float, 4> weights = {1, 4, 15, 1};
+
+private:
+    Context* context;
+
+    /**
+     * @return Whether @receivePoint is too close to the edge of the field or
+     *     their goal zone, or too close to @kickPoint
+     */
+    bool out_of_bounds(Geometry2d::Point kickPoint,
+                       Geometry2d::Point receivePoint) const;
+
+    /**
+     * @return Chance of a pass from @kickPoint reaching @receivePoint
+     */
+    float pass_chance(Geometry2d::Point kickPoint,
+                      Geometry2d::Point receivePoint);
+
+    /**
+     * @return Between 0 and 1, higher the closer opponents are to @pos
+     */
+    float space_coeff(Geometry2d::Point pos) const;
+
+    /**
+     * @return Between 0 and 1, how good @pos is to attack their goal from
+     */
+    float field_pos_coeff(Geometry2d::Point pos) const;
+
+    /**
+     * @return The overall score from the pass and shot chances at
+     *     @receivePoint
+     */
+    float combine(Geometry2d::Point kickPoint, Geometry2d::Point receivePoint,
+                  float passChance, float shotChance) const;
+};
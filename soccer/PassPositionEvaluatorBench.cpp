@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include "BenchFixtures.hpp"
+#include "PassPositionEvaluator.hpp"
+#include "SystemState.hpp"
+
+using namespace Geometry2d;
+
+static void BM_PassPositionEvaluatorEvalSinglePoint(benchmark::State& state) {
+    Context context;
+    placeRobots(context, 6, Point(-2, 4.5), Point(2, 5));
+
+    PassPositionEvaluator passEval(&context);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            passEval.eval_single_point(Point(0, 3), Point(1, 6)));
+    }
+}
+BENCHMARK(BM_PassPositionEvaluatorEvalSinglePoint);
+
+static void BM_PassPositionEvaluatorEvalField(benchmark::State& state) {
+    Context context;
+    placeRobots(context, 6, Point(-2, 4.5), Point(2, 5));
+
+    PassPositionEvaluator passEval(&context);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(passEval.eval_field(Point(0, 3), 20, 40));
+    }
+}
+BENCHMARK(BM_PassPositionEvaluatorEvalField)->Unit(benchmark::kMillisecond);
+
+static void BM_PassPositionEvaluatorEvalBestReceivePoint(
+    benchmark::State& state) {
+    Context context;
+    placeRobots(context, 6, Point(-2, 4.5), Point(2, 5));
+
+    PassPositionEvaluator passEval(&context);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            passEval.eval_best_receive_point(Point(0, 3), Point(0, 3)));
+    }
+}
+BENCHMARK(BM_PassPositionEvaluatorEvalBestReceivePoint);
+
+static void BM_PassPositionEvaluatorEvalBestReceivePointStarts(
+    benchmark::State& state) {
+    Context context;
+    placeRobots(context, 6, Point(-2, 4.5), Point(2, 5));
+
+    std::vector<Point> starts;
+    for (int i = 0; i < state.range(0); i++) {
+        starts.emplace_back(-2 + 4.0 * i / state.range(0), 3 + 0.5 * i);
+    }
+
+    PassPositionEvaluator passEval(&context);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(passEval.eval_best_receive_point(
+            Point(0, 3), starts, RJ::Seconds(0)));
+    }
+}
+BENCHMARK(BM_PassPositionEvaluatorEvalBestReceivePointStarts)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8);
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "PassPositionEvaluator.hpp"
+#include "SystemState.hpp"
+
+#include <cmath>
+
+using namespace Geometry2d;
+
+namespace {
+
+/// Puts a few opponents around midfield
+void placeOpponents(Context& context) {
+    for (int i = 0; i < 3; i++) {
+        OpponentRobot* opp = context.state.opp[i];
+        opp->mutable_state().visible = true;
+        opp->mutable_state().pose = Pose(-1.5 + 1.5 * i, 4 + 0.5 * i, 0);
+    }
+}
+
+}  // namespace
+
+TEST(PassPositionEvaluator, out_of_bounds) {
+    Context context;
+    PassPositionEvaluator passEval(&context);
+
+    // Too close to the side, our end and their goal zone
+    EXPECT_EQ(0, passEval.eval_single_point(Point(0, 2), Point(2.8, 4)));
+    EXPECT_EQ(0, passEval.eval_single_point(Point(0, 2), Point(0, 0.5)));
+    EXPECT_EQ(0, passEval.eval_single_point(Point(0, 2), Point(0, 7)));
+
+    EXPECT_GT(passEval.eval_single_point(Point(0, 2), Point(1, 5)), 0);
+    passEval.min_pass_dist = 4;
+    EXPECT_EQ(0, passEval.eval_single_point(Point(0, 2), Point(1, 5)));
+}
+
+TEST(PassPositionEvaluator, open_field) {
+    Context context;
+    PassPositionEvaluator passEval(&context);
+
+    // With nothing in the way, the pass and shot are both as good as they get
+    const float passChance = 0.8;
+    const float shotChance = 1;
+    const float fieldPos =
+        (0.1 * (1 - 1.0 / 3) + 3.2 * (5.0 / 9) +
+         0.1 * (1 - std::atan2(1.0, 4.0) / (M_PI / 2))) /
+        3.4;
+    const float distance = std::exp(-std::sqrt(10.0));
+    const float expected =
+        passChance * (1 + 4 * fieldPos + 15 * shotChance + (1 - distance)) / 21;
+
+    EXPECT_NEAR(expected, passEval.eval_single_point(Point(0, 2), Point(1, 5)),
+                0.01);
+}
+
+TEST(PassPositionEvaluator, blocked_pass) {
+    Context context;
+    OpponentRobot* opp = context.state.opp[0];
+    opp->mutable_state().visible = true;
+    opp->mutable_state().pose = Pose(0, 3, 0);
+
+    // The robot covers most of the pass
+    PassPositionEvaluator passEval(&context);
+    const float blocked = passEval.eval_single_point(Point(0, 2), Point(0, 5));
+
+    passEval.excluded_robots.push_back(opp);
+    const float open = passEval.eval_single_point(Point(0, 2), Point(0, 5));
+    EXPECT_GT(blocked, 0);
+    EXPECT_LT(blocked, open / 2);
+}
+
+TEST(PassPositionEvaluator, eval_field) {
+    Context context;
+    placeOpponents(context);
+    PassPositionEvaluator passEval(&context);
+
+    const int numWidth = 6;
+    const int numLength = 12;
+    const Point kickPoint(0.5, 2);
+    auto heatmap = passEval.eval_field(kickPoint, numWidth, numLength);
+    ASSERT_EQ(numWidth, heatmap.size());
+
+    // Each cell is scored at its center
+    const float width = Field_Dimensions::Current_Dimensions.Width();
+    const float length = Field_Dimensions::Current_Dimensions.Length();
+    float best = 0;
+    for (int x = 0; x < numWidth; x++) {
+        ASSERT_EQ(numLength, heatmap[x].size());
+        for (int y = 0; y < numLength; y++) {
+            Point center(-width / 2 + (x + 0.5) * width / numWidth,
+                         (y + 0.5) * length / numLength);
+            EXPECT_NEAR(passEval.eval_single_point(kickPoint, center),
+                        heatmap[x][y], 1e-6);
+            best = std::max(best, heatmap[x][y]);
+        }
+    }
+
+    EXPECT_GT(best, 0);
+    EXPECT_NEAR(best,
+                passEval.eval_single_point(
+                    kickPoint, PassPositionEvaluator::field_max_point(heatmap)),
+                1e-6);
+}
+
+TEST(PassPositionEvaluator, eval_best_receive_point) {
+    Context context;
+    placeOpponents(context);
+    PassPositionEvaluator passEval(&context);
+
+    // Start from the best cell of a coarse heatmap
+    const Point kickPoint(0.5, 2);
+    const Point start = PassPositionEvaluator::field_max_point(
+        passEval.eval_field(kickPoint, 6, 12));
+    auto result = passEval.eval_best_receive_point(kickPoint, start);
+
+    EXPECT_NEAR(passEval.eval_single_point(kickPoint, result.first),
+                result.second, 1e-6);
+    EXPECT_GE(result.second, passEval.eval_single_point(kickPoint, start));
+}
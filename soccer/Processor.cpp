@@ -13,17 +13,17 @@
 #include <LogUtils.hpp>
 #include <Robot.hpp>
 #include <RobotConfig.hpp>
+#include <ThreadPool.hpp>
+#include <Trace.hpp>
 #include <Utils.hpp>
-#include <joystick/GamepadController.hpp>
-#include <joystick/GamepadJoystick.hpp>
 #include <joystick/Joystick.hpp>
-#include <joystick/SpaceNavJoystick.hpp>
 #include <multicast.hpp>
 #include <planning/IndependentMultiRobotPathPlanner.hpp>
 #include <rc-fshare/git_version.hpp>
 #include "DebugDrawer.hpp"
 #include "Processor.hpp"
 #include "radio/NetworkRadio.hpp"
+#include "radio/NullRadio.hpp"
 #include "radio/PacketConvert.hpp"
 #include "radio/SimRadio.hpp"
 #include "vision/VisionFilter.hpp"
@@ -37,11 +37,28 @@ using namespace google::protobuf;
 
 static const auto Command_Latency = 0ms;
 
+// Indexed by Processor::Stage
+static const vector<string> StageNames = {
+    "Vision",   "Radio",    "Joystick", "Models", "Referee",
+    "Gameplay", "Planning", "Motion",   "Logging"};
+
+static void logStageTiming(Packet::LogFrame::StageTiming* log,
+                           const string& stage,
+                           const StageTimer::Stats& stats) {
+    log->set_stage(stage);
+    log->set_last(stats.last);
+    log->set_min(stats.min);
+    log->set_mean(stats.mean);
+    log->set_p99(stats.p99);
+    log->set_max(stats.max);
+}
+
 RobotConfig* Processor::robotConfig2008;
 RobotConfig* Processor::robotConfig2011;
 RobotConfig* Processor::robotConfig2015;
 std::vector<RobotStatus*>
     Processor::robotStatuses;  ///< FIXME: verify that this is correct
+ConfigInt* Processor::evaluationThreads;
 
 Field_Dimensions* currentDimensions = &Field_Dimensions::Current_Dimensions;
 
@@ -54,11 +71,21 @@ void Processor::createConfiguration(Configuration* cfg) {
         robotStatuses.push_back(
             new RobotStatus(cfg, QString("Robot Statuses/Robot %1").arg(s)));
     }
+
+    evaluationThreads = new ConfigInt(cfg, "Processor/evaluationThreads", 0);
 }
 
 Processor::Processor(bool sim, bool defendPlus, VisionChannel visionChannel,
-                     bool blueTeam, std::string readLogFile="")
-    : _loopMutex(), _blueTeam(blueTeam), _readLogFile(readLogFile) {
+                     bool blueTeam, std::string readLogFile,
+                     std::string replayLogFile)
+    : _loopMutex(),
+      _blueTeam(blueTeam),
+      _readLogFile(readLogFile),
+      _stageTimer(StageNames) {
+    // A few frames may still be held elsewhere (e.g. by the UI) after they
+    // leave the history
+    _logFramePool = LogFramePool::create(_logger.capacity() + 16);
+
     _running = true;
     _manualID = -1;
     _framerate = 0;
@@ -69,7 +96,6 @@ Processor::Processor(bool sim, bool defendPlus, VisionChannel visionChannel,
     _radio = nullptr;
 
     _multipleManual = false;
-    setupJoysticks();
 
     _dampedTranslation = true;
     _dampedRotation = true;
@@ -81,30 +107,54 @@ Processor::Processor(bool sim, bool defendPlus, VisionChannel visionChannel,
 
     QMetaObject::connectSlotsByName(this);
 
-    _vision = std::make_shared<VisionFilter>();
     _refereeModule = std::make_shared<NewRefereeModule>(&_context, _blueTeam);
-    _refereeModule->start();
+
+    if (!replayLogFile.empty()) {
+        _replay = std::make_unique<LogReplay>(&_context, _refereeModule.get());
+        if (!_replay->open(replayLogFile)) {
+            throw runtime_error("Can't open replay log " + replayLogFile);
+        }
+
+        // Everything after this reads the virtual clock
+        _replayClock = std::make_unique<RJ::VirtualClock>(_replay->startTime());
+        RJ::setClock(_replayClock.get());
+    } else {
+        _refereeModule->start();
+    }
+
+    // Without a worker thread, vision updates happen in step with the loop so
+    // a replay gives the same result every time
+    _vision = std::make_shared<VisionFilter>(!_replay);
     _gameplayModule = std::make_shared<Gameplay::GameplayModule>(&_context);
     _pathPlanner = std::unique_ptr<Planning::MultiRobotPathPlanner>(
         new Planning::IndependentMultiRobotPathPlanner());
     _motionControl = std::make_unique<MotionControlNode>(&_context);
-    _visionReceiver = std::make_unique<VisionReceiver>(
-        &_context, sim, sim ? SimVisionPort : SharedVisionPortSinglePrimary);
+    if (!_replay) {
+        _visionReceiver = std::make_unique<VisionReceiver>(
+            &_context, sim, sim ? SimVisionPort : SharedVisionPortSinglePrimary);
+    }
 
     _visionChannel = visionChannel;
 
     // Create radio socket
-    _radio =
-        _simulation
-            ? static_cast<Radio*>(new SimRadio(&_context, _blueTeam))
-            : static_cast<Radio*>(new NetworkRadio(NetworkRadioServerPort));
+    if (_replay) {
+        _radio = new NullRadio();
+    } else if (_simulation) {
+        _radio = new SimRadio(&_context, _blueTeam);
+    } else {
+        _radio = new NetworkRadio(NetworkRadioServerPort);
+    }
 
     if (!readLogFile.empty()) {
         _logger.readFrames(readLogFile.c_str());
         firstLogTime = _logger.startTime();
     }
 
-    _nodes.push_back(_visionReceiver.get());
+    if (_replay) {
+        _nodes.push_back(_replay.get());
+    } else {
+        _nodes.push_back(_visionReceiver.get());
+    }
     _nodes.push_back(_motionControl.get());
 }
 
@@ -118,6 +168,11 @@ Processor::~Processor() {
     // DEBUG - This is unnecessary, but lets us determine which one breaks.
     //_refereeModule.reset();
     _gameplayModule.reset();
+
+    // Go back to real time before the virtual clock is destroyed
+    if (_replayClock) {
+        RJ::setClock(nullptr);
+    }
 }
 
 void Processor::stop() {
@@ -163,18 +218,12 @@ void Processor::joystickKickOnBreakBeam(bool value) {
     _kickOnBreakBeam = value;
 }
 
-void Processor::setupJoysticks() {
-    _joysticks.clear();
-
-    GamepadController::controllersInUse.clear();
-    GamepadController::joystickRemoved = -1;
-
-    for (int i = 0; i < Robots_Per_Team; i++) {
-        _joysticks.push_back(new GamepadController());
-    }
+void Processor::setJoysticks(std::vector<Joystick*> joysticks) {
+    QMutexLocker locker(&_loopMutex);
 
-    //_joysticks.push_back(new SpaceNavJoystick()); //Add this back when
-    // isValid() is working properly
+    // The old joysticks aren't deleted here.  Destroying a GamepadController
+    // shuts down SDL, which the new ones have already started.
+    _joysticks = std::move(joysticks);
 }
 
 /**
@@ -204,6 +253,7 @@ bool Processor::joystickValid() const {
 }
 
 void Processor::runModels(const vector<const SSL_DetectionFrame*>& detectionFrames) {
+    TRACE_SCOPE("Processor::runModels");
     std::vector<CameraFrame> frames;
 
     for (const SSL_DetectionFrame* frame : detectionFrames) {
@@ -242,25 +292,37 @@ void Processor::runModels(const vector<const SSL_DetectionFrame*>& detectionFram
                 robot.robot_id());
         }
 
-        frames.emplace_back(time, frame->camera_id(), ballObservations, yellowObservations, blueObservations);
+        // t_sent was replaced with the time the packet was received
+        RJ::Time receivedTime =
+            RJ::Time(chrono::duration_cast<chrono::microseconds>(
+                RJ::Seconds(frame->t_sent())));
+
+        frames.emplace_back(time, frame->camera_id(), ballObservations,
+                            yellowObservations, blueObservations,
+                            receivedTime);
     }
 
-    _vision->addFrames(frames);
+    _vision->addFrames(std::move(frames));
 
     // Fill the list of our robots/balls based on whether we are the blue team or not
-    _vision->fillBallState(_context.state);
-    _vision->fillRobotState(_context.state, _blueTeam);
+    _vision->fillStates(_context.state, _blueTeam);
 }
 
 /**
  * program loop
  */
 void Processor::run() {
+    Trace::setThreadName("Processor");
     Status curStatus;
 
+    // The config file has been loaded by now, and nothing has been evaluated
+    ThreadPool::setEvaluationThreads(std::max(0, (int)*evaluationThreads));
+
     bool first = true;
     // main loop
     while (_running) {
+        TRACE_SCOPE("Processor::run");
+        _stageTimer.start();
         RJ::Time startTime = RJ::now();
         auto deltaTime = startTime - curStatus.lastLoopTime;
         _framerate = RJ::Seconds(1) / deltaTime;
@@ -275,7 +337,7 @@ void Processor::run() {
         // Reset
 
         // Make a new log frame
-        _context.state.logFrame = std::make_shared<Packet::LogFrame>();
+        _context.state.logFrame = _logFramePool->make();
         _context.state.logFrame->set_timestamp(RJ::timestamp());
         _context.state.logFrame->set_command_time(
             RJ::timestamp(startTime + Command_Latency));
@@ -297,6 +359,19 @@ void Processor::run() {
             logConfig->set_simulation(_simulation);
         }
 
+        // The current iteration isn't done yet, so log the previous one
+        if (_stageTimer.iterations() > 0) {
+            Packet::LogFrame::Timing* timing =
+                _context.state.logFrame->mutable_timing();
+            for (size_t i = 0; i < _stageTimer.numStages(); i++) {
+                logStageTiming(timing->add_stages(), _stageTimer.name(i),
+                               _stageTimer.stats(i));
+            }
+            logStageTiming(timing->mutable_total(), "Total",
+                           _stageTimer.total());
+        }
+        _stageTimer.mark(LoggingStage);
+
         for (OurRobot* robot : _context.state.self) {
             // overall robot config
             switch (robot->hardwareVersion()) {
@@ -325,7 +400,13 @@ void Processor::run() {
         // TODO(Kyle): Don't do this here.
         // Because not everything is on modules yet, but we still need things to
         // run in order, we can't just do everything via the for loop (yet).
-        _visionReceiver->run();
+        if (_replay) {
+            TRACE_SCOPE("LogReplay::run");
+            _replay->run();
+        } else {
+            TRACE_SCOPE("VisionReceiver::run");
+            _visionReceiver->run();
+        }
 
         // Read vision packets
         vector<const SSL_DetectionFrame*> detectionFrames;
@@ -397,6 +478,7 @@ void Processor::run() {
                 detectionFrames.push_back(det);
             }
         }
+        _stageTimer.mark(VisionStage);
 
         // Read radio reverse packets
         _radio->receive();
@@ -418,15 +500,21 @@ void Processor::run() {
                 _context.state.self[board]->radioRxUpdated();
             }
         }
+        _stageTimer.mark(RadioStage);
 
         for (Joystick* joystick : _joysticks) {
             joystick->update();
         }
-        GamepadController::joystickRemoved = -1;
+        _stageTimer.mark(JoystickStage);
 
         runModels(detectionFrames);
 
-        _context.vision_packets.clear();
+        if (_visionReceiver) {
+            _visionReceiver->recyclePackets(_context.vision_packets);
+        } else {
+            _context.vision_packets.clear();
+        }
+        _stageTimer.mark(ModelsStage);
 
         // Log referee data
         vector<NewRefereePacket*> refereePackets;
@@ -455,6 +543,7 @@ void Processor::run() {
 
         _context.state.logFrame->set_team_name_blue(bluename);
         _context.state.logFrame->set_team_name_yellow(yellowname);
+        _stageTimer.mark(RefereeStage);
 
         // Run high-level soccer logic
         _gameplayModule->run();
@@ -464,6 +553,7 @@ void Processor::run() {
         if (_gameplayModule->hasFieldEdgeInsetChanged()) {
             _gameplayModule->calculateFieldObstacles();
         }
+        _stageTimer.mark(GameplayStage);
         /// Collect global obstacles
         Geometry2d::ShapeSet globalObstacles =
             _gameplayModule->globalObstacles();
@@ -482,10 +572,8 @@ void Processor::run() {
                 }
 
                 // Visualize local obstacles
-                for (auto& shape : r->localObstacles().shapes()) {
-                    _context.debug_drawer.drawShape(shape, Qt::black,
-                                                    "LocalObstacles");
-                }
+                _context.debug_drawer.drawShapeSet(
+                    r->localObstacles(), Qt::black, "LocalObstacles");
 
                 auto& globalObstaclesForBot =
                     (r->shell() == _gameplayModule->goalieID() ||
@@ -528,10 +616,9 @@ void Processor::run() {
         }
 
         // Visualize obstacles
-        for (auto& shape : globalObstacles.shapes()) {
-            _context.debug_drawer.drawShape(shape, Qt::black,
-                                            "Global Obstacles");
-        }
+        _context.debug_drawer.drawShapeSet(globalObstacles, Qt::black,
+                                           "Global Obstacles");
+        _stageTimer.mark(PlanningStage);
 
         // TODO(Kyle, Collin): This is a horrible hack to get around the fact
         // that joystick code only (sort of) supports one joystick at a time.
@@ -541,6 +628,7 @@ void Processor::run() {
         }
 
         _motionControl->run();
+        _stageTimer.mark(MotionStage);
         // Run all nodes in sequence
         // TODO(Kyle): This is dead code for now. Once everything is ported over
         // to modules we can delete the if (false), but for now we still have to
@@ -631,17 +719,21 @@ void Processor::run() {
             *log->mutable_pos() = _context.state.ball.pos;
             *log->mutable_vel() = _context.state.ball.vel;
         }
+        _stageTimer.mark(LoggingStage);
 
         ////////////////
         // Outputs
 
         // Send motion commands to the robots
+        recordVisionLatency();
         sendRadioData();
+        _stageTimer.mark(RadioStage);
 
         // Write to the log unless we are viewing logs or main window is paused
         if (_readLogFile.empty() && !_paused) {
             _logger.addFrame(_context.state.logFrame);
         }
+        _stageTimer.mark(LoggingStage);
 
         // Store processing loop status
         _statusMutex.lock();
@@ -654,15 +746,23 @@ void Processor::run() {
         ////////////////
         // Timing
 
+        if (_replay && _replay->done()) {
+            _running = false;
+        }
+
+        _stageTimer.finish();
+
         auto endTime = RJ::now();
         auto timeLapse = endTime - startTime;
         if (timeLapse < _framePeriod) {
-            // Use system usleep, not QThread::usleep.
+            // Sleep on the RJ clock, not QThread::usleep, so a virtual clock
+            // skips the wait.
             //
             // QThread::usleep uses pthread_cond_wait which sometimes fails to
             // unblock.
             // This seems to depend on how many threads are blocked.
-            ::usleep(RJ::numMicroseconds(_framePeriod - timeLapse));
+            TRACE_SCOPE("Processor sleep");
+            RJ::sleepUntil(startTime + _framePeriod);
         } else {
             //   printf("Processor took too long: %d us\n", lastFrameTime);
         }
@@ -756,7 +856,65 @@ void Processor::updateGeometryPacket(const SSL_GeometryFieldSize& fieldSize) {
     }
 }
 
+void Processor::recordVisionLatency() {
+    const VisionFilter::FrameTiming& frame = _vision->filledFrameTiming();
+    if (frame.captured <= _lastLatencyCapture) {
+        return;
+    }
+    _lastLatencyCapture = frame.captured;
+
+    const RJ::Time commandTime = RJ::now();
+    const int64_t captureToReceive =
+        max<int64_t>(0, RJ::numMicroseconds(frame.received - frame.captured));
+    const int64_t receiveToFilter =
+        max<int64_t>(0, RJ::numMicroseconds(frame.filtered - frame.received));
+    const int64_t filterToCommand =
+        max<int64_t>(0, RJ::numMicroseconds(commandTime - frame.filtered));
+
+    _visionLatency.captureToReceive.add(captureToReceive);
+    _visionLatency.receiveToFilter.add(receiveToFilter);
+    _visionLatency.filterToCommand.add(filterToCommand);
+    _visionLatency.total.add(captureToReceive + receiveToFilter +
+                             filterToCommand);
+
+    Packet::LogFrame::VisionLatency* log =
+        _context.state.logFrame->mutable_vision_latency();
+    log->set_capture_to_receive(captureToReceive);
+    log->set_receive_to_filter(receiveToFilter);
+    log->set_filter_to_command(filterToCommand);
+}
+
+bool Processor::saveVisionLatency(const string& filename) const {
+    FILE* fp = fopen(filename.c_str(), "w");
+    if (!fp) {
+        printf("Can't write %s: %m\n", filename.c_str());
+        return false;
+    }
+
+    const LatencyHistogram* columns[] = {
+        &_visionLatency.captureToReceive, &_visionLatency.receiveToFilter,
+        &_visionLatency.filterToCommand, &_visionLatency.total};
+    fprintf(fp,
+            "bucket_start_us,capture_to_receive,receive_to_filter,"
+            "filter_to_command,total\n");
+    for (size_t i = 0; i < LatencyHistogram::NumBuckets; i++) {
+        fprintf(fp, "%ld", (long)(i * LatencyHistogram::BucketWidth));
+        for (const LatencyHistogram* histogram : columns) {
+            fprintf(fp, ",%lu", (unsigned long)histogram->bucket(i));
+        }
+        fprintf(fp, "\n");
+    }
+
+    const bool ok = !ferror(fp);
+    if (fclose(fp) != 0 || !ok) {
+        printf("Can't write %s: %m\n", filename.c_str());
+        return false;
+    }
+    return true;
+}
+
 void Processor::sendRadioData() {
+    TRACE_SCOPE("Processor::sendRadioData");
     // Halt overrides normal motion control, but not joystick
     if (_context.game_state.halt()) {
         // Force all motor speeds to zero
@@ -924,7 +1082,7 @@ void Processor::changeVisionChannel(int port) {
 
     // If we're in simulation, the vision channel should never change
     // from `SimVisionPort`.
-    if (!_simulation) {
+    if (!_simulation && _visionReceiver) {
         _visionReceiver->setPort(port);
     }
 
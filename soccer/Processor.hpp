@@ -16,9 +16,14 @@
 #include <Geometry2d/Point.hpp>
 #include <Geometry2d/Pose.hpp>
 #include <Geometry2d/TransformMatrix.hpp>
+#include <LatencyHistogram.hpp>
+#include <LogFramePool.hpp>
 #include <Logger.hpp>
 #include <NewRefereeModule.hpp>
+#include <StageTimer.hpp>
 #include <SystemState.hpp>
+#include <time.hpp>
+#include "LogReplay.hpp"
 #include "Node.hpp"
 #include "VisionReceiver.hpp"
 #include "motion/MotionControlNode.hpp"
@@ -71,8 +76,16 @@ public:
 
     static void createConfiguration(Configuration* cfg);
 
+    /**
+     * @param readLogFile Log to view instead of running normally
+     * @param replayLogFile Log to run the whole pipeline over instead of live
+     *        vision and referee input.  Time comes from a virtual clock that
+     *        starts at the beginning of the log and runs as fast as
+     *        processing allows, and the processor stops at the end of the log.
+     */
     Processor(bool sim, bool defendPlus, VisionChannel visionChannel,
-              bool blueTeam, std::string readLogFile);
+              bool blueTeam, std::string readLogFile = "",
+              std::string replayLogFile = "");
     virtual ~Processor();
 
     void stop();
@@ -121,7 +134,13 @@ public:
     void dampedTranslation(bool value);
 
     void joystickKickOnBreakBeam(bool value);
-    void setupJoysticks();
+
+    /**
+     * Replaces the joysticks used for manual control.  The processor owns
+     * them afterwards.  There are none until this is called, so the core
+     * doesn't depend on any input devices.
+     */
+    void setJoysticks(std::vector<Joystick*> joysticks);
     std::vector<int> getJoystickRobotIds();
 
     void blueTeam(bool value);
@@ -139,6 +158,8 @@ public:
 
     bool simulation() const { return _simulation; }
 
+    bool replaying() const { return _replay != nullptr; }
+
     void defendPlusX(bool value);
     bool defendPlusX() { return _defendPlusX; }
 
@@ -149,6 +170,21 @@ public:
 
     float framerate() { return _framerate; }
 
+    /// Distributions of how old each camera frame was at each step on its way
+    /// to the radio.  See LogFrame.VisionLatency.
+    struct VisionLatency {
+        LatencyHistogram captureToReceive;
+        LatencyHistogram receiveToFilter;
+        LatencyHistogram filterToCommand;
+        LatencyHistogram total;
+    };
+
+    /// Safe to read from any thread while the processor is running
+    const VisionLatency& visionLatency() const { return _visionLatency; }
+
+    /// Writes the vision latency histograms to @filename as CSV
+    bool saveVisionLatency(const std::string& filename) const;
+
     const Logger& logger() const { return _logger; }
 
     bool openLog(const QString& filename) { return _logger.open(filename); }
@@ -200,9 +236,17 @@ private:
     // per-robot status configs
     static std::vector<RobotStatus*> robotStatuses;
 
+    // Threads in ThreadPool::evaluation().  Read when the processor starts.
+    // Zero uses one thread per core.
+    static ConfigInt* evaluationThreads;
+
     /** send out the radio data for the radio program */
     void sendRadioData();
 
+    // Records the latency of the newest filtered camera frame, if it hasn't
+    // been acted on yet.  Called just before its commands are sent.
+    void recordVisionLatency();
+
     void updateGeometryPacket(const SSL_GeometryFieldSize& fieldSize);
 
     void runModels(const std::vector<const SSL_DetectionFrame*>& detectionFrames);
@@ -212,6 +256,10 @@ private:
 
     Logger _logger;
 
+    // Makes each cycle's LogFrame.  Sized to hold an arena for every frame in
+    // the Logger's history.
+    std::shared_ptr<LogFramePool> _logFramePool;
+
     Radio* _radio;
 
     bool _useOurHalf, _useOpponentHalf;
@@ -257,6 +305,28 @@ private:
     /// Measured framerate
     float _framerate;
 
+    // Stages of the processing loop, in the order they run.  Names are in
+    // StageNames.
+    enum Stage {
+        VisionStage,
+        RadioStage,
+        JoystickStage,
+        ModelsStage,
+        RefereeStage,
+        GameplayStage,
+        PlanningStage,
+        MotionStage,
+        LoggingStage,
+    };
+
+    // Time spent in each stage of the loop, which goes in every LogFrame
+    StageTimer _stageTimer;
+
+    VisionLatency _visionLatency;
+
+    // Capture time of the last camera frame counted in _visionLatency
+    RJ::Time _lastLatencyCapture;
+
     // This is used by the GUI to indicate status of the processing loop and
     // network
     QMutex _statusMutex;
@@ -268,6 +338,10 @@ private:
     std::shared_ptr<Gameplay::GameplayModule> _gameplayModule;
     std::unique_ptr<Planning::MultiRobotPathPlanner> _pathPlanner;
     std::unique_ptr<VisionReceiver> _visionReceiver;
+
+    // Only used when replaying a log, in place of _visionReceiver
+    std::unique_ptr<LogReplay> _replay;
+    std::unique_ptr<RJ::VirtualClock> _replayClock;
     std::unique_ptr<MotionControlNode> _motionControl;
 
     std::vector<Node*> _nodes;
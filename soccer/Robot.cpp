@@ -438,22 +438,22 @@ float OurRobot::avoidBallRadius() const { return intent().avoid_ball_radius; }
 
 void OurRobot::resetAvoidBall() { avoidBallRadius(Ball_Avoid_Small); }
 
-std::shared_ptr<Geometry2d::Circle> OurRobot::createBallObstacle() const {
+std::optional<Geometry2d::Circle> OurRobot::createBallObstacle() const {
     // if game is stopped, large obstacle regardless of flags
     if (_context->game_state.state != GameState::Playing &&
         !(_context->game_state.ourRestart ||
           _context->game_state.theirPenalty())) {
-        return std::make_shared<Geometry2d::Circle>(
+        return Geometry2d::Circle(
             _context->state.ball.pos,
             Field_Dimensions::Current_Dimensions.CenterRadius());
     }
 
     // create an obstacle if necessary
     if (intent().avoid_ball_radius > 0.0) {
-        return std::make_shared<Geometry2d::Circle>(_context->state.ball.pos,
-                                                    intent().avoid_ball_radius);
+        return Geometry2d::Circle(_context->state.ball.pos,
+                                  intent().avoid_ball_radius);
     } else {
-        return nullptr;
+        return std::nullopt;
     }
 }
 
@@ -513,7 +513,7 @@ Geometry2d::ShapeSet OurRobot::collectAllObstacles(
         // _state->drawShape(ball_obs, Qt::gray,
         //                   QString("ball_obstacles_%1").arg(shell()));
         auto ballObs = createBallObstacle();
-        if (ballObs) fullObstacles.add(ballObs);
+        if (ballObs) fullObstacles.add(*ballObs);
     }
     fullObstacles.add(selfObs);
     fullObstacles.add(oppObs);
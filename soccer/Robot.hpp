@@ -362,6 +362,12 @@ public:
     void localObstacles(const std::shared_ptr<Geometry2d::Shape>& obs) {
         intent().local_obstacles.add(obs);
     }
+    void localObstacles(const Geometry2d::Circle& obs) {
+        intent().local_obstacles.add(obs);
+    }
+    void localObstacles(const Geometry2d::Rect& obs) {
+        intent().local_obstacles.add(obs);
+    }
     const Geometry2d::ShapeSet& localObstacles() const {
         return intent().local_obstacles;
     }
@@ -510,8 +516,7 @@ protected:
         Geometry2d::ShapeSet result;
         for (size_t i = 0; i < mask.size(); ++i)
             if (mask[i] > 0 && robots[i] && robots[i]->visible())
-                result.add(std::shared_ptr<Geometry2d::Shape>(
-                    new Geometry2d::Circle(robots[i]->pos(), mask[i])));
+                result.add(Geometry2d::Circle(robots[i]->pos(), mask[i]));
         return result;
     }
 
@@ -535,8 +540,8 @@ protected:
         for (size_t i = 0; i < mask.size(); ++i)
             if (mask[i] > 0 && robots[i] && robots[i]->visible()) {
                 if (currentPosition.distTo(robots[i]->pos()) <= checkRadius) {
-                    result.add(std::shared_ptr<Geometry2d::Shape>(
-                        new Geometry2d::Circle(robots[i]->pos(), mask[i])));
+                    result.add(
+                        Geometry2d::Circle(robots[i]->pos(), mask[i]));
                 }
             }
         return result;
@@ -545,7 +550,7 @@ protected:
     /**
      * Creates an obstacle for the ball if necessary
      */
-    std::shared_ptr<Geometry2d::Circle> createBallObstacle() const;
+    std::optional<Geometry2d::Circle> createBallObstacle() const;
 
     friend class Processor;
 
@@ -1,30 +1,33 @@
 #include "VisionReceiver.hpp"
 
+#include <arpa/inet.h>
+#include <errno.h>
+#include <string.h>
 #include <unistd.h>
-#include <QMutexLocker>
 #include <QUdpSocket>
 #include <Utils.hpp>
 #include <multicast.hpp>
 #include <stdexcept>
 
+#include "Trace.hpp"
+
 using namespace std;
 using boost::asio::ip::udp;
 
 VisionReceiver::VisionReceiver(Context* context, bool sim, int port)
     : port(port), _context(context), _socket(_io_context) {
-    _recv_buffer.resize(65536);
+    _recvBuffer.resize(BatchSize * MaxPacketSize);
 
-    // There should be at most four packets: one for each camera on each of two
-    // frames, assuming some clock skew between this
-    // computer and the vision computer.
-    _packets.reserve(4);
+    // There are usually at most two packets per camera in each frame, and the
+    // Processor returns them before the next frame.
+    _pool.reserve(16);
 
     setPort(port);
 }
 
 void VisionReceiver::setPort(int port) {
-    // If the socket is already open, close it to cancel any pending operations
-    // before we reopen it on a new port.
+    // If the socket is already open, close it before we reopen it on a new
+    // port.
     if (_socket.is_open()) {
         _socket.close();
     }
@@ -34,6 +37,14 @@ void VisionReceiver::setPort(int port) {
     _socket.open(udp::v4());
     _socket.set_option(udp::socket::reuse_address(true));
 
+    // Have the kernel stamp each datagram with the time it arrived
+    const int on = 1;
+    if (setsockopt(_socket.native_handle(), SOL_SOCKET, SO_TIMESTAMPNS, &on,
+                   sizeof(on)) != 0) {
+        std::cerr << "VisionReceiver: SO_TIMESTAMPNS failed: "
+                  << strerror(errno) << std::endl;
+    }
+
     // Set up multicast.
     if (!multicast_add_native(_socket.native_handle(), SharedVisionAddress)) {
         std::cerr << "Multicast add failed" << std::endl;
@@ -48,58 +59,112 @@ void VisionReceiver::setPort(int port) {
                   << bind_error.message() << std::endl;
         return;
     }
-
-    // Start receiving. Note that this only listens once; any later receive
-    // will call `startReceive` again to continue listening.
-    startReceive();
 }
 
-void VisionReceiver::run() {
-    // Let boost::asio check for new packets
-    _io_context.poll();
+void VisionReceiver::run() { receivePackets(); }
 
-    // Move new packets into context using a move_iterator.
-    _context->vision_packets.insert(_context->vision_packets.begin(),
-                                    std::make_move_iterator(_packets.begin()),
-                                    std::make_move_iterator(_packets.end()));
-
-    // Remove the nullptr packets that we just moved to context.
-    _packets.clear();
+void VisionReceiver::recyclePackets(
+    std::vector<std::unique_ptr<VisionPacket>>& packets) {
+    for (auto& packet : packets) {
+        _pool.push_back(std::move(packet));
+    }
+    packets.clear();
 }
 
-void VisionReceiver::startReceive() {
-    // Set a receive callback
-    _socket.async_receive_from(
-        boost::asio::buffer(_recv_buffer), _sender_endpoint,
-        [this](const boost::system::error_code& error, std::size_t num_bytes) {
-            // Handle the packet and then restart reception to allow new
-            // incoming data
-            receivePacket(error, num_bytes);
-            startReceive();
-        });
+void VisionReceiver::receivePackets() {
+    if (!_socket.is_open()) {
+        return;
+    }
+
+    const int fd = _socket.native_handle();
+    while (true) {
+        for (int i = 0; i < BatchSize; ++i) {
+            _iovecs[i].iov_base = &_recvBuffer[i * MaxPacketSize];
+            _iovecs[i].iov_len = MaxPacketSize;
+
+            msghdr& msg = _headers[i].msg_hdr;
+            msg.msg_name = &_senders[i];
+            msg.msg_namelen = sizeof(_senders[i]);
+            msg.msg_iov = &_iovecs[i];
+            msg.msg_iovlen = 1;
+            msg.msg_control = _controls[i].data;
+            msg.msg_controllen = sizeof(_controls[i].data);
+            msg.msg_flags = 0;
+        }
+
+        const int count =
+            recvmmsg(fd, _headers.data(), BatchSize, MSG_DONTWAIT, nullptr);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                std::cerr << "Vision receive failed with error: "
+                          << strerror(errno) << std::endl;
+            }
+            return;
+        }
+
+        // Read both clocks once for the whole batch
+        timespec realNow;
+        clock_gettime(CLOCK_REALTIME, &realNow);
+        const RJ::Time now = RJ::now();
+
+        TRACE_SCOPE("VisionReceiver parse");
+        for (int i = 0; i < count; ++i) {
+            parsePacket(i, now, realNow);
+        }
+
+        if (count < BatchSize) {
+            return;
+        }
+    }
 }
 
-void VisionReceiver::receivePacket(const boost::system::error_code& error,
-                                   std::size_t num_bytes) {
-    // Check for error
-    if (error) {
-        std::cerr << "Vision receive failed with error: " << error.message()
-                  << std::endl;
-        return;
+void VisionReceiver::parsePacket(int i, RJ::Time now, const timespec& realNow) {
+    msghdr& msg = _headers[i].msg_hdr;
+    const size_t num_bytes = _headers[i].msg_len;
+
+    std::unique_ptr<VisionPacket> packet;
+    if (_pool.empty()) {
+        packet = std::make_unique<VisionPacket>();
+    } else {
+        packet = std::move(_pool.back());
+        _pool.pop_back();
     }
 
-    static int num = 0;
+    // The kernel timestamp is on the realtime clock, which RJ::now() is not
+    // necessarily on, so it is converted by how long ago it was.
+    packet->receivedTime = now;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET &&
+            cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            timespec stamp;
+            memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+            const int64_t age =
+                (realNow.tv_sec - stamp.tv_sec) * 1000000000LL +
+                (realNow.tv_nsec - stamp.tv_nsec);
+            if (age > 0) {
+                packet->receivedTime =
+                    now - std::chrono::duration_cast<RJ::Time::duration>(
+                              std::chrono::nanoseconds(age));
+            }
+        }
+    }
 
     // Parse the protobuf message
-    std::unique_ptr<VisionPacket> packet = std::make_unique<VisionPacket>();
-    packet->receivedTime = RJ::now();
-    if (!packet->wrapper.ParseFromArray(&_recv_buffer[0], num_bytes)) {
+    if ((msg.msg_flags & MSG_TRUNC) ||
+        !packet->wrapper.ParseFromArray(_iovecs[i].iov_base, num_bytes)) {
+        char address[INET_ADDRSTRLEN];
+        inet_ntop(AF_INET, &_senders[i].sin_addr, address, sizeof(address));
         std::cerr << "VisionReceiver: got bad packet of " << num_bytes
-                  << " bytes from " << _sender_endpoint.address() << ":"
-                  << _sender_endpoint.port() << std::endl;
+                  << " bytes from " << address << ":"
+                  << ntohs(_senders[i].sin_port) << std::endl;
+        _pool.push_back(std::move(packet));
         return;
     }
 
     // Put the message into the list
-    _packets.push_back(std::move(packet));
+    _context->vision_packets.push_back(std::move(packet));
 }
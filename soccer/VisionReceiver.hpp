@@ -5,56 +5,80 @@
 #include <Utils.hpp>
 #include <boost/asio.hpp>
 
+#include <netinet/in.h>
 #include <stdint.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <array>
+#include <memory>
 #include <vector>
 #include "Context.hpp"
 #include "Node.hpp"
 #include "vision/VisionPacket.hpp"
 
 /**
- * @brief Receives vision packets over UDP and places them in a buffer until
- * they are read.
+ * @brief Receives vision packets over UDP and passes them to the Processor
+ * through the Context.
  *
- * @details When start() is called, a new thread is spawned that listens on a
- * UDP port for packets. If sim = true, it tries both simulator ports until one
- * works. Otherwise, it connects to the port specified in the constructor.
+ * @details The socket listens on the port given in the constructor (or to
+ * setPort()).  Each call to run() drains every datagram waiting on the
+ * socket with recvmmsg(), parses it into an SSL_WrapperPacket and appends it
+ * to Context::vision_packets.
  *
- * Whenever a new packet comes in (encoded as Google Protobuf), it is parsed
- * into an SSL_WrapperPacket and placed onto the circular buffer @_packets.
- * They remain there until they are retrieved with getPackets().
+ * Each packet's receivedTime is the kernel's receive timestamp
+ * (SO_TIMESTAMPNS) rather than the time run() got to it, so it is not
+ * quantized to the Processor's loop period.
+ *
+ * Packets are taken from a pool, and the Processor gives them back with
+ * recyclePackets() once it is done with them, so the protobuf messages'
+ * memory is reused from frame to frame.
  */
 class VisionReceiver : public Node {
 public:
     explicit VisionReceiver(Context* context, bool sim = false,
                             int port = SharedVisionPortSinglePrimary);
 
-    /// Copies the vector of packets and then clears it. The vector contains
-    /// only packets received since the last time this was called (or since the
-    /// VisionReceiver was started, if getPackets has never been called).
-    ///
-    /// The caller is responsible for freeing the packets after this function
-    /// returns.
-    void getPackets(std::vector<VisionPacket*>& packets);
-
     virtual void run() override;
 
     void setPort(int port);
 
+    /// Returns @packets to the pool and clears it
+    void recyclePackets(std::vector<std::unique_ptr<VisionPacket>>& packets);
+
+    /// Maximum number of datagrams read by one recvmmsg() call
+    static constexpr int BatchSize = 16;
+
+    /// Largest datagram that can be received
+    static constexpr size_t MaxPacketSize = 65536;
+
 protected:
     int port;
 
-    void startReceive();
-    void receivePacket(const boost::system::error_code& error,
-                       std::size_t num_bytes);
+    void receivePackets();
 
-    Context* _context;
+    /// Parses datagram @i of the last batch.  @now and @realNow are the same
+    /// instant on RJ's clock and on the kernel's realtime clock.
+    void parsePacket(int i, RJ::Time now, const timespec& realNow);
 
-    std::vector<uint8_t> _recv_buffer;
+    Context* _context;
 
     boost::asio::io_service _io_context;
     boost::asio::ip::udp::socket _socket;
 
-    boost::asio::ip::udp::endpoint _sender_endpoint;
+    /// Ancillary data for one datagram, which holds its timestamp
+    struct alignas(cmsghdr) Control {
+        char data[CMSG_SPACE(sizeof(timespec))];
+    };
+
+    // recvmmsg() arguments for each datagram in a batch
+    std::array<mmsghdr, BatchSize> _headers;
+    std::array<iovec, BatchSize> _iovecs;
+    std::array<sockaddr_in, BatchSize> _senders;
+    std::array<Control, BatchSize> _controls;
+
+    /// BatchSize buffers of MaxPacketSize bytes
+    std::vector<uint8_t> _recvBuffer;
 
-    std::vector<std::unique_ptr<VisionPacket>> _packets;
+    /// Packets that are ready to be reused
+    std::vector<std::unique_ptr<VisionPacket>> _pool;
 };
@@ -1,5 +1,6 @@
 #include "WindowEvaluator.hpp"
 #include <Geometry2d/Util.hpp>
+#include <ThreadPool.hpp>
 #include "Constants.hpp"
 #include "DebugDrawer.hpp"
 #include "KickEvaluator.hpp"
@@ -16,6 +17,14 @@ using namespace Geometry2d;
 ConfigDouble* WindowEvaluator::angle_score_coefficient;
 ConfigDouble* WindowEvaluator::distance_score_coefficient;
 
+namespace {
+
+// Shots evaluated per task in a batch.  A single shot takes around a
+// microsecond, so smaller tasks spend more time waking threads than working.
+constexpr size_t MinShotsPerTask = 32;
+
+}  // namespace
+
 Window::Window() : t0(0), t1(0), a0(0), a1(0), shot_success(0) {}
 
 Window::Window(double t0, double t1)
@@ -61,41 +70,9 @@ WindowingResult WindowEvaluator::eval_pt_to_our_goal(Point origin) {
     return eval_pt_to_seg(origin, our_goal);
 }
 
-void WindowEvaluator::obstacle_range(vector<Window>& windows, double& t0,
-                                     double& t1) {
-    // Ignore degenerate obstacles
-    if (t0 == t1) return;
-
-    if (t0 > t1) swap(t0, t1);
-
-    auto iter = windows.begin();
-    while (iter != windows.end()) {
-        auto& w = *iter;
-        if (t0 <= w.t0 && t1 >= w.t1) {
-            // this window is fully covered by the obstacle, so remove it
-            iter = windows.erase(iter);
-        } else if (t0 > w.t0 && t1 < w.t1) {
-            // the window fully contains the obstacle, so we split the window
-            Window w2{t1, w.t1};
-            w.t1 = t0;
-            iter = windows.insert(iter + 1, w2);
-            iter++;
-        } else if (t0 > w.t0 && t0 < w.t1) {
-            // the obstacle covers the end of the window
-            w.t1 = t0;
-            iter++;
-        } else if (t1 > w.t0 && t1 < w.t1) {
-            // the obstacle covers the beginning of the window
-            w.t0 = t1;
-            iter++;
-        } else {
-            iter++;
-        }
-    }
-}
-
-void WindowEvaluator::obstacle_robot(vector<Window>& windows, Point origin,
-                                     Segment target, Point bot_pos) {
+void WindowEvaluator::obstacle_robot(vector<pair<double, double>>& blocked,
+                                     Point origin, Segment target,
+                                     Point bot_pos, bool drawDebug) const {
     auto n = (bot_pos - origin).normalized();
     auto t = n.perpCCW();
     auto r = Robot_Radius + Ball_Radius;
@@ -103,7 +80,7 @@ void WindowEvaluator::obstacle_robot(vector<Window>& windows, Point origin,
     Segment seg{bot_pos - n * Robot_Radius + t * r,
                 bot_pos - n * Robot_Radius - t * r};
 
-    if (debug) {
+    if (drawDebug) {
         context->debug_drawer.drawLine(seg, QColor{"Red"}, "Debug");
     }
 
@@ -129,60 +106,103 @@ void WindowEvaluator::obstacle_robot(vector<Window>& windows, Point origin,
             return;
         }
     }
-    obstacle_range(windows, extent[0], extent[1]);
-}
 
-WindowingResult WindowEvaluator::eval_pt_to_seg(Point origin, Segment target) {
-    auto end = target.delta().magsq();
+    // Ignore degenerate obstacles
+    if (extent[0] == extent[1]) return;
 
-    // if target is a zero-length segment, there are no windows
-    if (end == 0) return make_pair(vector<Window>{}, std::nullopt);
+    blocked.emplace_back(min(extent[0], extent[1]), max(extent[0], extent[1]));
+}
 
-    if (debug) {
-        context->debug_drawer.drawLine(target, QColor{"Blue"}, "Debug");
-    }
+vector<Point> WindowEvaluator::get_obstacles() const {
+    vector<Point> obstacles;
 
-    vector<Window> windows = {Window{0, end}};
+    auto add_robots = [&](const auto& robots) {
+        for (const Robot* bot : robots) {
+            if (bot != nullptr && bot->visible() &&
+                find(excluded_robots.begin(), excluded_robots.end(), bot) ==
+                    excluded_robots.end()) {
+                obstacles.push_back(bot->pos());
+            }
+        }
+    };
+    add_robots(context->state.self);
+    add_robots(context->state.opp);
 
-    // apply the obstacles
+    obstacles.insert(obstacles.end(), hypothetical_robot_locations.begin(),
+                     hypothetical_robot_locations.end());
+    return obstacles;
+}
 
-    vector<Robot*> bots(context->state.self.size() + context->state.opp.size());
+WindowingResult WindowEvaluator::eval_pt_to_seg(Point origin, Segment target) {
+    return eval_pt_to_seg(origin, target, get_obstacles(), debug);
+}
 
-    auto filter_predicate = [&](const Robot* bot) -> bool {
-        return bot != nullptr && bot->visible() &&
-               find(excluded_robots.begin(), excluded_robots.end(), bot) ==
-                   excluded_robots.end();
-    };
+vector<WindowingResult> WindowEvaluator::eval_pts_to_segs(
+    const vector<pair<Point, Segment>>& shots) {
+    const vector<Point> obstacles = get_obstacles();
+    vector<WindowingResult> results(shots.size());
+
+    ThreadPool::evaluation().parallelBatch(
+        shots.size(), MinShotsPerTask, [&](size_t i) {
+            results[i] = eval_pt_to_seg(shots[i].first, shots[i].second,
+                                        obstacles, false);
+        });
+    return results;
+}
 
-    auto end_it =
-        copy_if(context->state.self.begin(), context->state.self.end(),
-                bots.begin(), filter_predicate);
+vector<WindowingResult> WindowEvaluator::eval_pts_to_seg(
+    const vector<Point>& origins, Segment target) {
+    vector<pair<Point, Segment>> shots;
+    shots.reserve(origins.size());
+    for (Point origin : origins) {
+        shots.emplace_back(origin, target);
+    }
+    return eval_pts_to_segs(shots);
+}
 
-    end_it = copy_if(context->state.opp.begin(), context->state.opp.end(),
-                     end_it, filter_predicate);
+WindowingResult WindowEvaluator::eval_pt_to_seg(Point origin, Segment target,
+                                                const vector<Point>& obstacles,
+                                                bool drawDebug) const {
+    auto end = target.delta().magsq();
 
-    bots.resize(distance(bots.begin(), end_it));
+    // if target is a zero-length segment, there are no windows
+    if (end == 0) return make_pair(vector<Window>{}, std::nullopt);
 
-    vector<Point> bot_locations;
-    for_each(bots.begin(), bots.end(), [&bot_locations](Robot* bot) {
-        bot_locations.push_back(bot->pos());
-    });
+    if (drawDebug) {
+        context->debug_drawer.drawLine(target, QColor{"Blue"}, "Debug");
+    }
 
-    bot_locations.insert(bot_locations.end(),
-                         hypothetical_robot_locations.begin(),
-                         hypothetical_robot_locations.end());
+    // apply the obstacles
 
-    for (auto& pos : bot_locations) {
+    vector<pair<double, double>> blocked;
+    blocked.reserve(obstacles.size());
+    for (auto& pos : obstacles) {
         auto d = (pos - origin).mag();
         // whether or not we can ship over this bot
         auto chip_overable = chip_enabled &&
                              (d < max_chip_range - Robot_Radius) &&
                              (d > min_chip_range + Robot_Radius);
         if (!chip_overable) {
-            obstacle_robot(windows, origin, target, pos);
+            obstacle_robot(blocked, origin, target, pos, drawDebug);
         }
     }
 
+    // The windows are the gaps between the blocked ranges, found in one pass
+    // over them in order.  Ranges that touch leave no window between them.
+    sort(blocked.begin(), blocked.end());
+
+    vector<Window> windows;
+    double covered = 0;
+    for (auto& range : blocked) {
+        if (range.first > covered) {
+            windows.emplace_back(covered, range.first);
+        }
+        covered = max(covered, range.second);
+    }
+    if (covered < end) {
+        windows.emplace_back(covered, end);
+    }
+
     auto p0 = target.pt[0];
     auto delta = target.delta() / end;
 
@@ -201,7 +221,7 @@ WindowingResult WindowEvaluator::eval_pt_to_seg(Point origin, Segment target) {
                         return a.segment.delta().magsq() < b.segment.delta().magsq();
                     });
     }
-    if (debug) {
+    if (drawDebug) {
         if (best) {
             context->debug_drawer.drawLine(
                 Segment{origin, best->segment.center()}, QColor{"Green"},
@@ -245,7 +265,7 @@ double phi(double x)
     return 0.5*(1.0 + sign*y);
 }
 
-void WindowEvaluator::fill_shot_success(Window& window, Point origin) {
+void WindowEvaluator::fill_shot_success(Window& window, Point origin) const {
     auto shot_vector = window.segment.center() - origin;
     auto shot_distance = shot_vector.mag();
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include <Geometry2d/Segment.hpp>
 #include <Geometry2d/Point.hpp>
@@ -87,6 +89,29 @@ public:
     WindowingResult eval_pt_to_seg(Geometry2d::Point origin,
                                    Geometry2d::Segment target);
 
+    /**
+     * @brief Evaluates shot windows for many pairs of origin and target
+     * segment
+     * @details Each result is the same as eval_pt_to_seg() for that pair.
+     * The obstacles are gathered once for the whole batch, and large batches
+     * are split across a shared thread pool.  Nothing is drawn, even with
+     * debug set.
+     * @param shots Starting point and target segment of each shot
+     * @return Results of windowing operations, in the same order as shots
+     */
+    std::vector<WindowingResult> eval_pts_to_segs(
+        const std::vector<std::pair<Geometry2d::Point, Geometry2d::Segment>>&
+            shots);
+
+    /**
+     * @brief Evaluates shot windows from many origins to the same target
+     * segment
+     * @see eval_pts_to_segs
+     */
+    std::vector<WindowingResult> eval_pts_to_seg(
+        const std::vector<Geometry2d::Point>& origins,
+        Geometry2d::Segment target);
+
     /**
      * @brief Initializes configurable fields.
      * @note See configuration documentation for details.
@@ -126,12 +151,32 @@ public:
 private:
     Context* context;
 
-    void fill_shot_success(Window& window, Geometry2d::Point origin);
+    /**
+     * @return Positions of the visible robots that aren't excluded, and the
+     *     hypothetical robots
+     */
+    std::vector<Geometry2d::Point> get_obstacles() const;
+
+    /**
+     * @brief Evaluates shot windows to a target segment with the given
+     * obstacles
+     * @note Only reads shared state unless @drawDebug is set, so batches can
+     * call it from any thread
+     */
+    WindowingResult eval_pt_to_seg(
+        Geometry2d::Point origin, Geometry2d::Segment target,
+        const std::vector<Geometry2d::Point>& obstacles, bool drawDebug) const;
 
-    void obstacle_range(std::vector<Window>& windows, double& t0, double& t1);
+    void fill_shot_success(Window& window, Geometry2d::Point origin) const;
 
-    void obstacle_robot(std::vector<Window>& windows, Geometry2d::Point origin,
-                        Geometry2d::Segment target, Geometry2d::Point bot_pos);
+    /**
+     * @brief Adds the range of @target that the robot at @bot_pos blocks to
+     * @blocked, if it blocks any
+     * @details Ranges are in the same units as Window::t0 and Window::t1.
+     */
+    void obstacle_robot(std::vector<std::pair<double, double>>& blocked,
+                        Geometry2d::Point origin, Geometry2d::Segment target,
+                        Geometry2d::Point bot_pos, bool drawDebug) const;
 
     static ConfigDouble* angle_score_coefficient;
     static ConfigDouble* distance_score_coefficient;
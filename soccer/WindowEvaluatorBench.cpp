@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+#include "BenchFixtures.hpp"
+#include "SystemState.hpp"
+#include "WindowEvaluator.hpp"
+
+using namespace Geometry2d;
+
+static void BM_WindowEvaluatorEvalPtToSeg(benchmark::State& state) {
+    Context context;
+    placeRobots(context, state.range(0));
+
+    const Segment ourGoal =
+        Field_Dimensions::Current_Dimensions.OurGoalSegment();
+    WindowEvaluator winEval(&context);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(winEval.eval_pt_to_seg(Point(0.5, 4), ourGoal));
+    }
+}
+BENCHMARK(BM_WindowEvaluatorEvalPtToSeg)
+    ->ArgName("robots")
+    ->Arg(0)
+    ->Arg(3)
+    ->Arg(6);
+
+static void BM_WindowEvaluatorEvalPtsToSeg(benchmark::State& state) {
+    Context context;
+    placeRobots(context, 6);
+
+    std::vector<Point> origins;
+    for (int i = 0; i < state.range(0); i++) {
+        origins.emplace_back(-2.5 + 5.0 * i / state.range(0), 4);
+    }
+
+    const Segment ourGoal =
+        Field_Dimensions::Current_Dimensions.OurGoalSegment();
+    WindowEvaluator winEval(&context);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(winEval.eval_pts_to_seg(origins, ourGoal));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_WindowEvaluatorEvalPtsToSeg)
+    ->ArgName("origins")
+    ->Arg(16)
+    ->Arg(256)
+    ->Arg(4096);
@@ -35,4 +35,89 @@ TEST(WindowEvaluator, eval_pt_to_seg) {
 
     // the window should be our goal segment
     EXPECT_EQ(ourGoalSegment, windows[0].segment);
-}
\ No newline at end of file
+}
+
+// Two robots in front of the goal split it into three windows
+TEST(WindowEvaluator, eval_pt_to_seg_split) {
+    Context context;
+    for (int i = 0; i < 2; i++) {
+        OpponentRobot* bot = context.state.opp[i];
+        bot->mutable_state().visible = true;
+        bot->mutable_state().pose = Pose(-0.2 + 0.4 * i, 0.5, 0);
+    }
+
+    Segment ourGoalSegment(
+        Point(-Field_Dimensions::Current_Dimensions.GoalWidth() / 2.0, 0),
+        Point(Field_Dimensions::Current_Dimensions.GoalWidth() / 2.0, 0));
+
+    WindowEvaluator winEval(&context);
+    WindowingResult result =
+        winEval.eval_pt_to_seg(Point(0, 2), ourGoalSegment);
+    auto& windows = result.first;
+
+    ASSERT_EQ(3, windows.size());
+    EXPECT_EQ(0, windows[0].t0);
+    EXPECT_EQ(ourGoalSegment.delta().magsq(), windows[2].t1);
+    for (size_t i = 0; i < windows.size(); i++) {
+        EXPECT_LT(windows[i].t0, windows[i].t1);
+        if (i > 0) EXPECT_LT(windows[i - 1].t1, windows[i].t0);
+    }
+
+    // Robots that overlap from the origin's view leave no window between them
+    context.state.opp[1]->mutable_state().pose = Pose(-0.05, 0.5, 0);
+    EXPECT_EQ(2, winEval.eval_pt_to_seg(Point(0, 2), ourGoalSegment)
+                     .first.size());
+}
+
+// Evaluating many shots at once gives the same results as one at a time
+TEST(WindowEvaluator, eval_pts_to_segs) {
+    Context context;
+    for (int i = 0; i < 6; i++) {
+        OurRobot* self = context.state.self[i];
+        self->mutable_state().visible = true;
+        self->mutable_state().pose = Pose(-2 + 0.8 * i, 2 + 0.3 * i, 0);
+
+        OpponentRobot* opp = context.state.opp[i];
+        opp->mutable_state().visible = true;
+        opp->mutable_state().pose = Pose(2 - 0.8 * i, 1 + 0.4 * i, 0);
+    }
+
+    WindowEvaluator winEval(&context);
+    winEval.excluded_robots.push_back(context.state.opp[2]);
+    winEval.hypothetical_robot_locations.push_back(Point(0.3, 2.5));
+
+    const Segment ourGoal =
+        Field_Dimensions::Current_Dimensions.OurGoalSegment();
+
+    // Enough shots to be split across threads
+    std::vector<std::pair<Point, Segment>> shots;
+    for (int i = 0; i < 200; i++) {
+        Point origin(-2.5 + 0.025 * i, 3 + 0.02 * i);
+        if (i % 2 == 0) {
+            shots.emplace_back(origin, ourGoal);
+        } else {
+            shots.emplace_back(origin,
+                               Segment(Point(-1, 0.5 + 0.01 * i), Point(1, 1)));
+        }
+    }
+
+    std::vector<WindowingResult> results = winEval.eval_pts_to_segs(shots);
+    ASSERT_EQ(shots.size(), results.size());
+    for (size_t i = 0; i < shots.size(); i++) {
+        WindowingResult single =
+            winEval.eval_pt_to_seg(shots[i].first, shots[i].second);
+        EXPECT_EQ(single.first, results[i].first);
+        EXPECT_EQ(single.second, results[i].second);
+    }
+
+    std::vector<Point> origins;
+    for (auto& shot : shots) {
+        origins.push_back(shot.first);
+    }
+    results = winEval.eval_pts_to_seg(origins, ourGoal);
+    ASSERT_EQ(origins.size(), results.size());
+    for (size_t i = 0; i < origins.size(); i++) {
+        EXPECT_EQ(winEval.eval_pt_to_seg(origins[i], ourGoal).first,
+                  results[i].first);
+    }
+}
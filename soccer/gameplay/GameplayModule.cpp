@@ -4,6 +4,7 @@
 #include <protobuf/LogFrame.pb.h>
 #include <Robot.hpp>
 #include <SystemState.hpp>
+#include <Trace.hpp>
 
 #include <stdio.h>
 #include <iostream>
@@ -329,6 +330,7 @@ Geometry2d::ShapeSet Gameplay::GameplayModule::goalZoneObstacles() const {
  * runs the current play
  */
 void Gameplay::GameplayModule::run() {
+    TRACE_SCOPE("GameplayModule::run");
     QMutexLocker lock(&_mutex);
 
     bool verbose = false;
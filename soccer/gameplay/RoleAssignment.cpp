@@ -0,0 +1,361 @@
+#include "RoleAssignment.hpp"
+
+#include <Robot.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+using namespace Geometry2d;
+
+namespace Gameplay {
+
+namespace {
+
+/**
+ * The python munkres package's Munkres class.  The steps, scan orders and
+ * marks are kept exactly as they are there.
+ */
+class Munkres {
+public:
+    explicit Munkres(const vector<vector<double>>& costs)
+        : _rows(costs.size()), _cols(costs.empty() ? 0 : costs[0].size()) {
+        // Pad to a square matrix with zeros
+        _n = max(_rows, _cols);
+        _c.assign(_n, vector<double>(_n, 0));
+        for (size_t i = 0; i < _rows; i++) {
+            copy(costs[i].begin(), costs[i].end(), _c[i].begin());
+        }
+
+        _rowCovered.assign(_n, false);
+        _colCovered.assign(_n, false);
+        _marked.assign(_n, vector<int>(_n, None));
+    }
+
+    vector<pair<int, int>> compute() {
+        int step = 1;
+        while (step != 7) {
+            switch (step) {
+                case 1:
+                    step = step1();
+                    break;
+                case 2:
+                    step = step2();
+                    break;
+                case 3:
+                    step = step3();
+                    break;
+                case 4:
+                    step = step4();
+                    break;
+                case 5:
+                    step = step5();
+                    break;
+                case 6:
+                    step = step6();
+                    break;
+            }
+        }
+
+        vector<pair<int, int>> results;
+        for (size_t i = 0; i < _rows; i++) {
+            for (size_t j = 0; j < _cols; j++) {
+                if (_marked[i][j] == Starred) {
+                    results.emplace_back(i, j);
+                }
+            }
+        }
+        return results;
+    }
+
+private:
+    enum Mark { None = 0, Starred = 1, Primed = 2 };
+
+    // Subtract each row's minimum from the row
+    int step1() {
+        for (auto& row : _c) {
+            const double minval = *min_element(row.begin(), row.end());
+            for (double& c : row) {
+                c -= minval;
+            }
+        }
+        return 2;
+    }
+
+    // Star the first zero in each row whose column has no star yet
+    int step2() {
+        for (size_t i = 0; i < _n; i++) {
+            for (size_t j = 0; j < _n; j++) {
+                if (_c[i][j] == 0 && !_colCovered[j] && !_rowCovered[i]) {
+                    _marked[i][j] = Starred;
+                    _colCovered[j] = true;
+                    _rowCovered[i] = true;
+                    break;
+                }
+            }
+        }
+        clearCovers();
+        return 3;
+    }
+
+    // Cover each column with a star.  All covered means we're done.
+    int step3() {
+        size_t count = 0;
+        for (size_t i = 0; i < _n; i++) {
+            for (size_t j = 0; j < _n; j++) {
+                if (_marked[i][j] == Starred && !_colCovered[j]) {
+                    _colCovered[j] = true;
+                    count++;
+                }
+            }
+        }
+        return count >= _n ? 7 : 4;
+    }
+
+    // Prime uncovered zeros until one has no star in its row
+    int step4() {
+        int row = 0;
+        int col = 0;
+        while (true) {
+            tie(row, col) = findAZero(row, col);
+            if (row < 0) {
+                return 6;
+            }
+
+            _marked[row][col] = Primed;
+            const int starCol = findInRow(row, Starred);
+            if (starCol >= 0) {
+                col = starCol;
+                _rowCovered[row] = true;
+                _colCovered[col] = false;
+            } else {
+                _z0 = {row, col};
+                return 5;
+            }
+        }
+    }
+
+    // Flip the stars along the alternating path of primes and stars that
+    // starts at the prime found in step 4
+    int step5() {
+        vector<pair<int, int>> path{_z0};
+        while (true) {
+            const int row = findStarInCol(path.back().second);
+            if (row < 0) {
+                break;
+            }
+            path.emplace_back(row, path.back().second);
+            path.emplace_back(row, findInRow(row, Primed));
+        }
+
+        for (const auto& cell : path) {
+            int& mark = _marked[cell.first][cell.second];
+            mark = mark == Starred ? None : Starred;
+        }
+        clearCovers();
+        for (auto& row : _marked) {
+            for (int& mark : row) {
+                if (mark == Primed) {
+                    mark = None;
+                }
+            }
+        }
+        return 3;
+    }
+
+    // Add the smallest uncovered value to covered rows and subtract it from
+    // uncovered columns
+    int step6() {
+        double minval = numeric_limits<double>::infinity();
+        for (size_t i = 0; i < _n; i++) {
+            for (size_t j = 0; j < _n; j++) {
+                if (!_rowCovered[i] && !_colCovered[j] && minval > _c[i][j]) {
+                    minval = _c[i][j];
+                }
+            }
+        }
+
+        for (size_t i = 0; i < _n; i++) {
+            for (size_t j = 0; j < _n; j++) {
+                if (_rowCovered[i]) {
+                    _c[i][j] += minval;
+                }
+                if (!_colCovered[j]) {
+                    _c[i][j] -= minval;
+                }
+            }
+        }
+        return 4;
+    }
+
+    // Scans the whole matrix for an uncovered zero, starting at (@i0, @j0) and
+    // wrapping around.  Like munkres, this returns the last one in the first
+    // row that has any.
+    pair<int, int> findAZero(int i0, int j0) const {
+        pair<int, int> found{-1, -1};
+        int i = i0;
+        while (true) {
+            int j = j0;
+            do {
+                if (_c[i][j] == 0 && !_rowCovered[i] && !_colCovered[j]) {
+                    found = {i, j};
+                }
+                j = (j + 1) % _n;
+            } while (j != j0);
+
+            if (found.first >= 0) {
+                return found;
+            }
+            i = (i + 1) % _n;
+            if (i == i0) {
+                return found;
+            }
+        }
+    }
+
+    int findInRow(int row, Mark mark) const {
+        for (size_t j = 0; j < _n; j++) {
+            if (_marked[row][j] == mark) {
+                return j;
+            }
+        }
+        return -1;
+    }
+
+    int findStarInCol(int col) const {
+        for (size_t i = 0; i < _n; i++) {
+            if (_marked[i][col] == Starred) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void clearCovers() {
+        fill(_rowCovered.begin(), _rowCovered.end(), false);
+        fill(_colCovered.begin(), _colCovered.end(), false);
+    }
+
+    // Size of the original matrix
+    size_t _rows;
+    size_t _cols;
+
+    // Size of the padded matrix
+    size_t _n;
+
+    vector<vector<double>> _c;
+    vector<bool> _rowCovered;
+    vector<bool> _colCovered;
+    vector<vector<int>> _marked;
+
+    // The prime that starts step 5's path
+    pair<int, int> _z0{0, 0};
+};
+
+}  // namespace
+
+vector<vector<double>> roleCostMatrix(const vector<OurRobot*>& robots,
+                                      const vector<RoleRequirements>& roles,
+                                      optional<int> forbiddenBallToucher,
+                                      string* failReason) {
+    vector<vector<double>> costs;
+    costs.reserve(robots.size());
+
+    for (OurRobot* robot : robots) {
+        const int shell = static_cast<int>(robot->shell());
+        const string prefix = "Robot " + to_string(shell) + ": ";
+        const bool forbidden = forbiddenBallToucher == shell;
+
+        vector<double> row;
+        row.reserve(roles.size());
+        for (const RoleRequirements& req : roles) {
+            // Hard requirement failures aren't scaled, which keeps them
+            // below prohibitedShellID in the solver's eyes.  The python
+            // version did the same, and our plays are tuned around it.
+            double cost = 0;
+            if (req.requiredShellID && *req.requiredShellID != shell) {
+                cost = RoleMaxWeight;
+                *failReason += prefix + "Required ID " +
+                               to_string(*req.requiredShellID) +
+                               " does not match " + to_string(shell) + "\n";
+            } else if (req.hasBall && !robot->hasBall()) {
+                cost = RoleMaxWeight;
+                *failReason += prefix + "does not have ball\n";
+            } else if (req.requireKicking &&
+                       (forbidden || !robot->kickerWorks() ||
+                        !robot->ballSenseWorks())) {
+                cost = RoleMaxWeight;
+                *failReason += prefix +
+                               "does not have a fully working kicking setup"
+                               " (or double touched)\n";
+            } else if (req.requireChipping &&
+                       (forbidden || !robot->chipper_available() ||
+                        !robot->ballSenseWorks())) {
+                cost = RoleMaxWeight;
+                *failReason +=
+                    prefix + "does not have a chipper (or double touched)\n";
+            } else {
+                if (req.prohibitedShellID && *req.prohibitedShellID == shell) {
+                    cost = RoleMaxWeight;
+                }
+                if (req.destinationPoint) {
+                    cost += req.positionCostMultiplier *
+                            req.destinationPoint->distTo(robot->pos());
+                } else if (req.destinationSegment) {
+                    cost += req.positionCostMultiplier *
+                            req.destinationSegment->distTo(robot->pos());
+                }
+                if (req.previousShellID && *req.previousShellID != shell) {
+                    cost += req.robotChangeCost;
+                }
+                if (!robot->chipper_available()) {
+                    cost += req.chipperPreferenceWeight;
+                }
+                if (req.costFunc) {
+                    cost += req.costFunc(robot);
+                }
+
+                cost *= RoleCostScale;
+            }
+
+            // The solver never finishes if given a NaN
+            if (std::isnan(cost)) {
+                throw domain_error(
+                    "NaN value encountered when building role assignment cost "
+                    "matrix");
+            }
+
+            row.push_back(cost);
+        }
+        costs.push_back(move(row));
+    }
+
+    return costs;
+}
+
+vector<pair<int, int>> solveAssignment(const vector<vector<double>>& costs) {
+    if (costs.empty() || costs[0].empty()) {
+        return {};
+    }
+    return Munkres(costs).compute();
+}
+
+RoleAssignments assignRoles(const vector<OurRobot*>& robots,
+                            const vector<RoleRequirements>& roles,
+                            optional<int> forbiddenBallToucher) {
+    RoleAssignments result;
+
+    const auto costs = roleCostMatrix(robots, roles, forbiddenBallToucher,
+                                      &result.failReason);
+    result.assignments = solveAssignment(costs);
+    for (const auto& assignment : result.assignments) {
+        result.totalCost +=
+            costs[assignment.first][assignment.second] / RoleCostScale;
+    }
+
+    return result;
+}
+
+}  // namespace Gameplay
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <Geometry2d/Point.hpp>
+#include <Geometry2d/Segment.hpp>
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+class OurRobot;
+
+namespace Gameplay {
+
+/**
+ * @brief What a role needs from the robot assigned to it
+ *
+ * @details This mirrors role_assignment.RoleRequirements on the python side.
+ * The built-in costs are all computed in c++; only @costFunc calls back into
+ * python.
+ */
+struct RoleRequirements {
+    /// The robot's distance to at most one of these is added to the cost
+    std::optional<Geometry2d::Point> destinationPoint;
+    std::optional<Geometry2d::Segment> destinationSegment;
+
+    /// Multiplied by the distance to the destination
+    double positionCostMultiplier = 1;
+
+    bool hasBall = false;
+
+    /// Added to the cost of robots without a working chipper
+    double chipperPreferenceWeight = 0;
+
+    std::optional<int> requiredShellID;
+    std::optional<int> previousShellID;
+    std::optional<int> prohibitedShellID;
+
+    /// The robot needs a working kicker and ball sensor and must not be the
+    /// forbidden ball toucher
+    bool requireKicking = false;
+
+    /// Same as requireKicking, but with a working chipper
+    bool requireChipping = false;
+
+    /// Added to the cost of robots other than previousShellID
+    double robotChangeCost = 1;
+
+    /// Extra cost of assigning a robot, or empty for none
+    std::function<double(OurRobot*)> costFunc;
+};
+
+/// The result of assignRoles()
+struct RoleAssignments {
+    /// (robot index, role index) pairs, in increasing robot order
+    std::vector<std::pair<int, int>> assignments;
+
+    /// Sum of the assigned costs
+    double totalCost = 0;
+
+    /// One line for each robot that failed a role's hard requirements
+    std::string failReason;
+};
+
+/// Cost of a robot that fails a role's hard requirements.  This is also the
+/// total cost at which an assignment is considered impossible.
+constexpr double RoleMaxWeight = 10000000;
+
+/// Costs are scaled by this before solving.  It's kept from when the solver
+/// only worked on integers, because it affects which ties are broken first.
+constexpr double RoleCostScale = 1000;
+
+/**
+ * Builds the (scaled) cost of assigning each robot (row) to each role
+ * (column) and appends the reason for every hard requirement failure to
+ * @failReason.
+ *
+ * @param forbiddenBallToucher The robot that may not touch the ball because of
+ *     the double touch rule, if any
+ * @throws std::domain_error if a cost is NaN
+ */
+std::vector<std::vector<double>> roleCostMatrix(
+    const std::vector<OurRobot*>& robots,
+    const std::vector<RoleRequirements>& roles,
+    std::optional<int> forbiddenBallToucher, std::string* failReason);
+
+/**
+ * Finds the minimum cost assignment of rows to columns with the Hungarian
+ * algorithm.
+ *
+ * This follows the python munkres package step for step, so it breaks ties
+ * between equal cost assignments the same way our plays were tuned with.
+ *
+ * @return (row, column) pairs in increasing row order.  If the matrix isn't
+ *     square, some rows or columns are left out.
+ */
+std::vector<std::pair<int, int>> solveAssignment(
+    const std::vector<std::vector<double>>& costs);
+
+/// Assigns @robots to @roles, minimizing the total cost
+RoleAssignments assignRoles(const std::vector<OurRobot*>& robots,
+                            const std::vector<RoleRequirements>& roles,
+                            std::optional<int> forbiddenBallToucher);
+
+}  // namespace Gameplay
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include "RoleAssignment.hpp"
+#include <Context.hpp>
+#include <Robot.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+using namespace Geometry2d;
+using namespace Gameplay;
+
+namespace {
+
+// Lowest total cost over every way of assigning the smaller dimension
+double bruteForceCost(const std::vector<std::vector<double>>& costs) {
+    const size_t rows = costs.size();
+    const size_t cols = costs[0].size();
+    std::vector<int> order(std::max(rows, cols));
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+
+    double best = INFINITY;
+    do {
+        double total = 0;
+        for (size_t i = 0; i < rows; i++) {
+            if (order[i] < (int)cols) {
+                total += costs[i][order[i]];
+            }
+        }
+        best = std::min(best, total);
+    } while (std::next_permutation(order.begin(), order.end()));
+    return best;
+}
+
+}  // namespace
+
+TEST(RoleAssignment, solves_example) {
+    std::vector<std::vector<double>> costs = {
+        {1, 2, 3}, {2, 4, 6}, {3, 6, 9}};
+    std::vector<std::pair<int, int>> expected = {{0, 2}, {1, 1}, {2, 0}};
+    EXPECT_EQ(expected, solveAssignment(costs));
+}
+
+TEST(RoleAssignment, breaks_ties_in_order) {
+    std::vector<std::vector<double>> costs(4, std::vector<double>(4, 0));
+    std::vector<std::pair<int, int>> expected = {
+        {0, 0}, {1, 1}, {2, 2}, {3, 3}};
+    EXPECT_EQ(expected, solveAssignment(costs));
+}
+
+TEST(RoleAssignment, finds_optimum) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dims(1, 6);
+    std::uniform_real_distribution<double> value(0, 10);
+
+    for (int trial = 0; trial < 200; trial++) {
+        const int rows = dims(rng);
+        const int cols = dims(rng);
+        std::vector<std::vector<double>> costs(rows, std::vector<double>(cols));
+        for (auto& row : costs) {
+            for (double& c : row) {
+                // Whole numbers make ties likely
+                c = trial % 2 ? std::floor(value(rng)) : value(rng);
+            }
+        }
+
+        const auto assignments = solveAssignment(costs);
+        ASSERT_EQ(std::min(rows, cols), (int)assignments.size());
+
+        double total = 0;
+        std::vector<bool> used(cols, false);
+        for (const auto& a : assignments) {
+            EXPECT_FALSE(used[a.second]);
+            used[a.second] = true;
+            total += costs[a.first][a.second];
+        }
+        EXPECT_NEAR(bruteForceCost(costs), total, 1e-9);
+    }
+}
+
+TEST(RoleAssignment, position_cost) {
+    Context context;
+    OurRobot* bot1 = context.state.self[1];
+    bot1->mutable_state().pose = Pose(1, 6, 0);
+    OurRobot* bot2 = context.state.self[2];
+    bot2->mutable_state().pose = Pose(2, 3, 0);
+
+    RoleRequirements req1;
+    req1.destinationPoint = Point(3, 4);
+    RoleRequirements req2;
+    req2.destinationSegment = Segment(Point(0, 7), Point(2, 7));
+
+    auto result = assignRoles({bot1, bot2}, {req1, req2}, std::nullopt);
+    std::vector<std::pair<int, int>> expected = {{0, 1}, {1, 0}};
+    EXPECT_EQ(expected, result.assignments);
+    EXPECT_NEAR(1 + std::sqrt(2), result.totalCost, 1e-6);
+    EXPECT_TRUE(result.failReason.empty());
+}
+
+TEST(RoleAssignment, requirements) {
+    Context context;
+    OurRobot* bot1 = context.state.self[1];
+    OurRobot* bot2 = context.state.self[2];
+
+    RoleRequirements required;
+    required.requiredShellID = 2;
+    RoleRequirements custom;
+    custom.costFunc = [bot1](OurRobot* robot) { return robot == bot1 ? 5 : 1; };
+
+    std::string failReason;
+    auto costs =
+        roleCostMatrix({bot1, bot2}, {required, custom}, std::nullopt,
+                       &failReason);
+    EXPECT_EQ(RoleMaxWeight, costs[0][0]);
+    EXPECT_EQ(0, costs[1][0]);
+    EXPECT_EQ(5 * RoleCostScale, costs[0][1]);
+    EXPECT_EQ(1 * RoleCostScale, costs[1][1]);
+    EXPECT_EQ("Robot 1: Required ID 2 does not match 1\n", failReason);
+
+    RoleRequirements prohibited;
+    prohibited.prohibitedShellID = 1;
+    auto result = assignRoles({bot1}, {prohibited}, std::nullopt);
+    EXPECT_GE(result.totalCost, RoleMaxWeight);
+
+    RoleRequirements kicking;
+    kicking.requireKicking = true;
+    result = assignRoles({bot1}, {kicking}, 1);
+    EXPECT_EQ(
+        "Robot 1: does not have a fully working kicking setup (or double "
+        "touched)\n",
+        result.failReason);
+}
+
+TEST(RoleAssignment, rejects_nan) {
+    Context context;
+    RoleRequirements req;
+    req.costFunc = [](OurRobot*) { return NAN; };
+    EXPECT_THROW(assignRoles({context.state.self[0]}, {req}, std::nullopt),
+                 std::domain_error);
+}
@@ -10,6 +10,36 @@ import main
 # @param excluded_robots A list of robots that shouldn't be counted as obstacles to this shot
 # @return a value from zero to one that estimates the probability of the pass succeeding
 def eval_pass(from_point, to_point, excluded_robots=[]):
+    receive_seg = _receive_seg(from_point, to_point)
+
+    win_eval = robocup.WindowEvaluator(main.context())
+    for r in excluded_robots:
+        win_eval.add_excluded_robot(r)
+    windows, best = win_eval.eval_pt_to_seg(from_point, receive_seg)
+
+    return _pass_chance(best, receive_seg)
+
+
+## Same as eval_pass, but for many passes at once
+#  This is much faster than calling eval_pass for each pass
+# @param from_points A list of Points the passes are coming from
+# @param to_points A list of Points the passes are being received at, one for each of from_points
+# @param excluded_robots A list of robots that shouldn't be counted as obstacles to these passes
+# @return a list of chances, one for each pass
+def eval_passes(from_points, to_points, excluded_robots=[]):
+    receive_segs = [_receive_seg(from_point, to_point)
+                    for from_point, to_point in zip(from_points, to_points)]
+
+    win_eval = robocup.WindowEvaluator(main.context())
+    for r in excluded_robots:
+        win_eval.add_excluded_robot(r)
+    bests, _ = win_eval.eval_pts_to_segs(list(from_points), receive_segs)
+
+    return [_pass_chance(best, receive_seg)
+            for best, receive_seg in zip(bests, receive_segs)]
+
+
+def _receive_seg(from_point, to_point):
     # we make a pass triangle with the far corner at the ball and the opposing side touching the receiver's mouth
     # the side along the receiver's mouth is the 'receive_seg'
     # we then use the window evaluator on this scenario to see if the pass is open
@@ -18,14 +48,11 @@ def eval_pass(from_point, to_point, excluded_robots=[]):
     pass_dir = to_point - from_point
     pass_perp = pass_dir.perp_ccw()
     receive_seg_half_len = math.tan(pass_angle) * pass_dist
-    receive_seg = robocup.Segment(to_point + pass_perp * receive_seg_half_len,
-                                  to_point + pass_perp * -receive_seg_half_len)
+    return robocup.Segment(to_point + pass_perp * receive_seg_half_len,
+                           to_point + pass_perp * -receive_seg_half_len)
 
-    win_eval = robocup.WindowEvaluator(main.context())
-    for r in excluded_robots:
-        win_eval.add_excluded_robot(r)
-    windows, best = win_eval.eval_pt_to_seg(from_point, receive_seg)
 
+def _pass_chance(best, receive_seg):
     # this is our estimate of the likelihood of the pass succeeding
     # value can range from zero to one
     # we square the ratio of best to total to make it weigh more - we could raise it to higher power if we wanted
@@ -1,11 +1,5 @@
-import constants
-import math
 import robocup
 import main
-import evaluation.field
-import evaluation.passing
-import evaluation.shooting
-import functools
 
 ## Finds the best location with a rectangle to pass the ball into
 #
@@ -17,8 +11,30 @@ import functools
 # point, score = evaluation.passing.eval_best_receive_point(main.ball().pos)
 
 
+## Builds the native evaluator behind the functions below
+#
+# @param ignore_robots: Robots to ignore
+# @param min_pass_dist: Minimum distance that we should ever pass
+# @param field_weights: A tuple of the 3 difference weights to apply to field position
+#               (Centerness, Distance to their goal, Angle off their goal)
+# @param weights: A tuple of the 4 different weights to apply to the evaulations overall
+#               (space, field_position, shot_chance, kick_proximty)
+def make_evaluator(ignore_robots, min_pass_dist, field_weights, weights):
+    pass_eval = robocup.PassPositionEvaluator(main.context())
+    for r in ignore_robots:
+        pass_eval.add_excluded_robot(r)
+    pass_eval.min_pass_dist = min_pass_dist
+    pass_eval.field_weights = field_weights
+    pass_eval.weights = weights
+    return pass_eval
+
+
 ## Evaluates a single point and returns the overall coefficient for the area
 #
+# The score combines the pass chance with the openness, field position
+# coefficients, shot chance and distance from the kick, and is computed in c++
+# by robocup.PassPositionEvaluator.
+#
 # @param kick_point: Point where we are kicking from
 # @param ignore_robots: Robots to ignore
 # @param min_pass_dist: Minimum distance that we should ever pass
@@ -31,57 +47,37 @@ import functools
 # @return Returns a score between 0 and 1 on how good of pass would be
 def eval_single_point(kick_point, ignore_robots, min_pass_dist, field_weights,
                       weights, receive_x, receive_y):
-
-    receive_point = robocup.Point(receive_x, receive_y)
-
     if kick_point is None:
         if main.ball().valid:
             kick_point = main.ball().pos
         else:
             return 0
 
-    w = constants.Field.Width
-    l = constants.Field.Length
-    x_offset = .1 * w
-    y_offset = .1 * l
-
-    # Check boundaries
-    # Can be smoothed for a better solution
-    robot_offset = constants.Robot.Radius * 6
-    if (receive_point.x - x_offset < w / -2 or
-            receive_point.x + x_offset > w / 2 or
-            receive_point.y - y_offset < 0 or
-            receive_point.y + y_offset > constants.Field.Length or
-            constants.Field.TheirGoalZoneShape.contains_point(
-                receive_point + robocup.Point(0, y_offset)
-                + robocup.Point(robot_offset, robot_offset)) or
-            constants.Field.TheirGoalZoneShape.contains_point(
-                receive_point + robocup.Point(0, y_offset)
-                - robocup.Point(robot_offset, robot_offset))):
-        return 0
-
-    # Check if we are too close to the ball
-    if ((receive_point - kick_point).mag() < min_pass_dist):
-        return 0
-
-    shotChance = evaluation.shooting.eval_shot(receive_point,
-                                                   ignore_robots)
-
-    passChance = evaluation.passing.eval_pass(kick_point, receive_point,
-                                              ignore_robots)
+    pass_eval = make_evaluator(ignore_robots, min_pass_dist, field_weights,
+                               weights)
+    return pass_eval.eval_single_point(kick_point,
+                                       robocup.Point(receive_x, receive_y))
 
-    space = evaluation.field.space_coeff_at_pos(receive_point, ignore_robots)
-    fieldPos = evaluation.field.field_pos_coeff_at_pos(
-        receive_point, field_weights[0], field_weights[1], field_weights[2])
-    distance = math.exp(-1 * (kick_point - receive_point).mag())
 
-    # All of the other scores are based on whether the pass will actually make it to it
-    # Not worth returning a great position if we cant even get a pass there
-    totalChance = passChance * (
-        weights[0] * (1 - space) + weights[1] * fieldPos + weights[2] *
-        shotChance + weights[3] * (1 - distance))
-
-    return totalChance / math.fsum(weights)
+## Scores every cell of a grid over the field
+#
+# The grid and result are in the format of visualization.overlay, so the
+# result can be passed straight to display_visualization_points.
+#
+# @param kick_point: Point that we are passing from
+# @param num_width: Number of cells across the field
+# @param num_length: Number of cells along the field
+# @return List of columns of scores, from left to right and bottom to top
+def eval_field(kick_point,
+               ignore_robots=[],
+               min_pass_dist=0.0,
+               field_weights=(0.1, 3.2, 0.1),
+               weights=(1, 4, 15, 1),
+               num_width=20,
+               num_length=40):
+    pass_eval = make_evaluator(ignore_robots, min_pass_dist, field_weights,
+                               weights)
+    return pass_eval.eval_field(kick_point, num_width, num_length)
 
 
 ## Finds the best position to pass to
@@ -91,10 +87,15 @@ def eval_single_point(kick_point, ignore_robots, min_pass_dist, field_weights,
 # @param field_weights: A tuple of the 3 difference weights to apply to field position 
 #               (Centerness, Distance to their goal, Angle off their goal)
 # @param nelder_mead_args: A tuple of the nelder mead optimization args
-#               (Starting point, Starting step, Exit condition, Reflection, Expansion,
+#               (Starting step, Exit condition, Reflection, Expansion,
 #                Coontraction, Shrink, Max iterations, Max function value, Max value exit condition)
 # @param weights: A tuple of the 4 different weights to apply to the evaulations overall (Weights are normalized)
 #               (space, field_position, shot_chance, kick_proximity)
+# @param start: Point to start the search at, or None to start at kick_point.
+#               The max of a coarse eval_field (PassPositionEvaluator.field_max_point)
+#               makes a good start.  A list of Points starts a search at each of them
+#               in parallel and keeps the best.
+# @param time_budget: Seconds after which the search stops, or 0 for no limit
 # @return bestPoint and bestScore in that order
 def eval_best_receive_point(kick_point,
                             ignore_robots=[],
@@ -103,16 +104,14 @@ def eval_best_receive_point(kick_point,
                             nelder_mead_args=(robocup.Point(0.5, .5),
                                               robocup.Point(0.01, 0.01), 1, 2,
                                               0.75, 0.5, 50, 1, 0.1),
-                            weights=(1, 4, 15, 1)):
-    pythfunc = functools.partial(eval_single_point, kick_point, ignore_robots,
-                                 min_pass_dist, field_weights, weights)
-    cppfunc = robocup.PythonFunctionWrapper(pythfunc)
-    nmConfig = robocup.NelderMead2DConfig(
-        cppfunc, kick_point, nelder_mead_args[0], nelder_mead_args[1],
-        nelder_mead_args[2], nelder_mead_args[3], nelder_mead_args[4],
-        nelder_mead_args[5], nelder_mead_args[6], nelder_mead_args[7],
-        nelder_mead_args[8])
-    nm = robocup.NelderMead2D(nmConfig)
-    nm.execute()
-
-    return nm.getPoint(), nm.getValue()
+                            weights=(1, 4, 15, 1),
+                            start=None,
+                            time_budget=0):
+    if start is None:
+        start = kick_point
+
+    pass_eval = make_evaluator(ignore_robots, min_pass_dist, field_weights,
+                               weights)
+    return pass_eval.eval_best_receive_point(kick_point, start,
+                                             tuple(nelder_mead_args),
+                                             time_budget)
@@ -15,6 +15,18 @@ def eval_shot(from_point, excluded_robots=[]):
     point, chance = kick_eval.eval_pt_to_opp_goal(from_point)
     return chance
 
+## Same as eval_shot, but for many points at once
+#  This is much faster than calling eval_shot for each point
+# @param from_points A list of Points the shots are coming from
+# @param excluded_robots A list of robots that shouldn't be counted as obstacles to these shots
+# @return a list of chances, one for each point in from_points
+def eval_shots(from_points, excluded_robots=[]):
+    kick_eval = robocup.KickEvaluator(main.system_state())
+    for r in excluded_robots:
+        kick_eval.add_excluded_robot(r)
+    points, chances = kick_eval.eval_pts_to_opp_goal(list(from_points))
+    return chances
+
 ## Shoot through a formation of enemy robots at a target
 #
 # @param target_pos: the target to shoot at
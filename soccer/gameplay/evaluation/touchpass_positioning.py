@@ -123,23 +123,30 @@ def eval_best_receive_point(kick_point,
         # We can't do anything.
         return None, None, None
     bestChance = None
+    bestpt = None
 
     for segment in segments:
         main.debug_drawer().draw_line(segment, constants.Colors.Blue,
                                       "Candidate Lines")
-        _, best = win_eval.eval_pt_to_seg(kick_point, segment)
 
-        if best is None: continue
+    # Evaluate every candidate line at once, then every receive point
+    receiveBests, receiveChances = win_eval.eval_pts_to_segs(
+        [kick_point] * len(segments), segments)
 
-        currentChance = best.shot_success
-        # TODO dont only aim for center of goal. Waiting on window_evaluator returning a probability.
-        receivePt = best.segment.center()
+    # TODO dont only aim for center of goal. Waiting on window_evaluator returning a probability.
+    receivePts = [best.segment.center() for best in receiveBests
+                  if best is not None]
+    receiveChances = [chance
+                      for best, chance in zip(receiveBests, receiveChances)
+                      if best is not None]
 
-        _, best = win_eval.eval_pt_to_seg(receivePt, targetSeg)
+    targetBests, _ = win_eval.eval_pts_to_seg(receivePts, targetSeg)
 
+    for receivePt, receiveChance, best in zip(receivePts, receiveChances,
+                                              targetBests):
         if best is None: continue
 
-        currentChance = currentChance * best.shot_success
+        currentChance = receiveChance * best.shot_success
         if bestChance is None or currentChance > bestChance:
             bestChance = currentChance
             targetPoint = best.segment.center()
@@ -7,6 +7,7 @@ import enum
 import standard_play
 import evaluation.ball
 import evaluation.passing_positioning
+import evaluation.shooting
 import tactics.coordinated_pass
 import tactics.defensive_forward
 import tactics.simple_zone_midfielder
@@ -305,9 +306,10 @@ class AdaptiveFormation(standard_play.StandardPlay):
         # Decrease weight on sides of field due to complexity of settling
         self.pass_target, self.pass_score = evaluation.passing_positioning.eval_best_receive_point(
             main.ball().pos,
-            main.our_robots(), AdaptiveFormation.FIELD_POS_WEIGHTS,
-            AdaptiveFormation.NELDER_MEAD_ARGS,
-            AdaptiveFormation.PASSING_WEIGHTS)
+            main.our_robots(),
+            field_weights=AdaptiveFormation.FIELD_POS_WEIGHTS,
+            nelder_mead_args=AdaptiveFormation.NELDER_MEAD_ARGS,
+            weights=AdaptiveFormation.PASSING_WEIGHTS)
 
         clear = skills.pivot_kick.PivotKick()
         clear.target = self.pass_target
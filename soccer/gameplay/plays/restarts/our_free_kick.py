@@ -8,6 +8,7 @@ import math
 import main
 import tactics.coordinated_pass
 import evaluation.passing_positioning
+import evaluation.shooting
 import enum
 
 class OurFreeKick(standard_play.StandardPlay):
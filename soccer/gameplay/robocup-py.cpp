@@ -1,9 +1,12 @@
 #include "robocup-py.hpp"
 #include <boost/python/register_ptr_to_python.hpp>
 #include <boost/python/suite/indexing/vector_indexing_suite.hpp>
+#include <algorithm>
 #include <functional>
 #include <iostream>
+#include <optional>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 using namespace boost::python;
@@ -23,6 +26,8 @@ using namespace boost::python;
 #include <motion/MotionControl.hpp>
 #include <rc-fshare/pid.hpp>
 #include "KickEvaluator.hpp"
+#include "PassPositionEvaluator.hpp"
+#include "RoleAssignment.hpp"
 #include "WindowEvaluator.hpp"
 #include "motion/TrapezoidalMotion.hpp"
 #include "optimization/NelderMead2D.hpp"
@@ -150,8 +155,16 @@ void OurRobot_settle_w_bounce(OurRobot* self, Geometry2d::Point* bounceTarget) {
 
 void OurRobot_add_local_obstacle(OurRobot* self, Geometry2d::Shape* obs) {
     if (obs == nullptr) throw NullArgumentException("obs");
-    std::shared_ptr<Geometry2d::Shape> sharedObs(obs->clone());
-    self->localObstacles(sharedObs);
+
+    // Circles and rects are copied into the set instead of allocated
+    if (auto circle = dynamic_cast<const Geometry2d::Circle*>(obs)) {
+        self->localObstacles(*circle);
+    } else if (auto rect = dynamic_cast<const Geometry2d::Rect*>(obs)) {
+        self->localObstacles(*rect);
+    } else {
+        std::shared_ptr<Geometry2d::Shape> sharedObs(obs->clone());
+        self->localObstacles(sharedObs);
+    }
 }
 
 void OurRobot_set_avoid_ball_radius(OurRobot* self, float radius) {
@@ -374,6 +387,13 @@ void DebugDrawer_draw_circle(DebugDrawer* self, const Geometry2d::Point* center,
                      QString::fromStdString(layer));
 }
 
+void DebugDrawer_draw_shape(DebugDrawer* self, const Geometry2d::Shape* obs,
+                            boost::python::tuple rgb,
+                            const std::string& layer) {
+    if (obs == nullptr) throw NullArgumentException("obs");
+    self->drawShape(*obs, Color_from_tuple(rgb), QString::fromStdString(layer));
+}
+
 void DebugDrawer_draw_arc(DebugDrawer* self, const Geometry2d::Arc* arc,
                           boost::python::tuple rgb, const std::string& layer) {
     if (arc == nullptr) throw NullArgumentException{"arc"};
@@ -569,6 +589,57 @@ void WinEval_add_excluded_robot(WindowEvaluator* self, Robot* robot) {
     self->excluded_robots.push_back(robot);
 }
 
+// Returns the best window of each shot, or None if it is blocked, and the
+// shot_success of each best window, or 0 if it is blocked
+boost::python::tuple WinEval_batch_tuple(
+    const std::vector<WindowingResult>& window_results) {
+    boost::python::list best_windows;
+    boost::python::list chances;
+    for (const auto& result : window_results) {
+        if (result.second.has_value()) {
+            best_windows.append(result.second.value());
+            chances.append(result.second->shot_success);
+        } else {
+            best_windows.append(boost::python::api::object());
+            chances.append(0.0);
+        }
+    }
+
+    return boost::python::make_tuple(best_windows, chances);
+}
+
+boost::python::tuple WinEval_eval_pts_to_seg(
+    WindowEvaluator* self, const boost::python::list& origins,
+    const Geometry2d::Segment* target) {
+    if (target == nullptr) throw NullArgumentException{"target"};
+
+    std::vector<Geometry2d::Point> ptVec;
+    for (int i = 0; i < len(origins); i++) {
+        ptVec.push_back(boost::python::extract<Geometry2d::Point>(origins[i]));
+    }
+
+    return WinEval_batch_tuple(self->eval_pts_to_seg(ptVec, *target));
+}
+
+boost::python::tuple WinEval_eval_pts_to_segs(
+    WindowEvaluator* self, const boost::python::list& origins,
+    const boost::python::list& targets) {
+    if (len(origins) != len(targets)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "Need the same number of origins and targets");
+        boost::python::throw_error_already_set();
+    }
+
+    std::vector<std::pair<Geometry2d::Point, Geometry2d::Segment>> shots;
+    for (int i = 0; i < len(origins); i++) {
+        shots.emplace_back(
+            boost::python::extract<Geometry2d::Point>(origins[i]),
+            boost::python::extract<Geometry2d::Segment>(targets[i]));
+    }
+
+    return WinEval_batch_tuple(self->eval_pts_to_segs(shots));
+}
+
 boost::python::tuple KickEval_eval_pt_to_seg(
     KickEvaluator* self, const Geometry2d::Point* origin,
     const Geometry2d::Segment* target) {
@@ -641,10 +712,283 @@ boost::python::tuple KickEval_eval_pt_to_our_goal(
     return boost::python::tuple{lst};
 }
 
+// Returns ([point], [chance]) for a batch of results
+boost::python::tuple KickEval_batch_tuple(
+    const std::vector<KickResults>& kick_results) {
+    boost::python::list points;
+    boost::python::list chances;
+    for (const auto& result : kick_results) {
+        points.append(result.first);
+        chances.append(result.second);
+    }
+
+    return boost::python::make_tuple(points, chances);
+}
+
+std::vector<Geometry2d::Point> KickEval_origins(
+    const boost::python::list& origins) {
+    std::vector<Geometry2d::Point> ptVec;
+    for (int i = 0; i < len(origins); i++) {
+        ptVec.push_back(boost::python::extract<Geometry2d::Point>(origins[i]));
+    }
+    return ptVec;
+}
+
+boost::python::tuple KickEval_eval_pts_to_seg(
+    KickEvaluator* self, const boost::python::list& origins,
+    const Geometry2d::Segment* target) {
+    if (target == nullptr) throw NullArgumentException{"target"};
+
+    return KickEval_batch_tuple(
+        self->eval_pts_to_seg(KickEval_origins(origins), *target));
+}
+
+boost::python::tuple KickEval_eval_pts_to_opp_goal(
+    KickEvaluator* self, const boost::python::list& origins) {
+    return KickEval_batch_tuple(
+        self->eval_pts_to_opp_goal(KickEval_origins(origins)));
+}
+
+boost::python::tuple KickEval_eval_pts_to_our_goal(
+    KickEvaluator* self, const boost::python::list& origins) {
+    return KickEval_batch_tuple(
+        self->eval_pts_to_our_goal(KickEval_origins(origins)));
+}
+
 void KickEval_add_excluded_robot(KickEvaluator* self, Robot* robot) {
     self->excluded_robots.push_back(robot);
 }
 
+void PassPosEval_add_excluded_robot(PassPositionEvaluator* self,
+                                    Robot* robot) {
+    self->excluded_robots.push_back(robot);
+}
+
+float PassPosEval_eval_single_point(PassPositionEvaluator* self,
+                                    const Geometry2d::Point* kickPoint,
+                                    const Geometry2d::Point* receivePoint) {
+    if (kickPoint == nullptr) throw NullArgumentException{"kick_point"};
+    if (receivePoint == nullptr) throw NullArgumentException{"receive_point"};
+
+    return self->eval_single_point(*kickPoint, *receivePoint);
+}
+
+// Returns the heatmap as a list of columns, like
+// visualization.overlay.display_visualization_points takes
+boost::python::list PassPosEval_eval_field(PassPositionEvaluator* self,
+                                           const Geometry2d::Point* kickPoint,
+                                           int numWidth, int numLength) {
+    if (kickPoint == nullptr) throw NullArgumentException{"kick_point"};
+
+    boost::python::list columns;
+    auto heatmap = self->eval_field(*kickPoint, numWidth, numLength);
+    for (const auto& column : heatmap) {
+        boost::python::list lst;
+        for (float value : column) {
+            lst.append(value);
+        }
+        columns.append(lst);
+    }
+
+    return columns;
+}
+
+Geometry2d::Point PassPosEval_field_max_point(
+    const boost::python::list& columns) {
+    std::vector<std::vector<float>> heatmap;
+    for (int x = 0; x < len(columns); x++) {
+        boost::python::list column =
+            boost::python::extract<boost::python::list>(columns[x]);
+        heatmap.emplace_back();
+        for (int y = 0; y < len(column); y++) {
+            heatmap.back().push_back(boost::python::extract<float>(column[y]));
+        }
+    }
+
+    return PassPositionEvaluator::field_max_point(heatmap);
+}
+
+/**
+ * @param start A Point to start the search at, or a list of Points to start a
+ *     search at each of in parallel
+ * @param nelderMeadArgs The NelderMead2DConfig parameters after the start
+ *     point, in order
+ * @param timeBudget Seconds after which the searches stop, or zero for no
+ *     limit
+ */
+boost::python::tuple PassPosEval_eval_best_receive_point(
+    PassPositionEvaluator* self, const Geometry2d::Point* kickPoint,
+    const boost::python::object& start,
+    const boost::python::tuple& nelderMeadArgs, double timeBudget) {
+    if (kickPoint == nullptr) throw NullArgumentException{"kick_point"};
+    if (start.is_none()) throw NullArgumentException{"start"};
+
+    using boost::python::extract;
+    const auto& args = nelderMeadArgs;
+    const Geometry2d::Point step = extract<Geometry2d::Point>(args[0]);
+    const Geometry2d::Point minDist = extract<Geometry2d::Point>(args[1]);
+
+    std::pair<Geometry2d::Point, float> result;
+    extract<Geometry2d::Point> startPoint(start);
+    if (startPoint.check() && timeBudget == 0) {
+        result = self->eval_best_receive_point(
+            *kickPoint, startPoint(), step, minDist, extract<float>(args[2]),
+            extract<float>(args[3]), extract<float>(args[4]),
+            extract<float>(args[5]), extract<int>(args[6]),
+            extract<float>(args[7]), extract<float>(args[8]));
+    } else {
+        std::vector<Geometry2d::Point> starts;
+        if (startPoint.check()) {
+            starts.push_back(startPoint());
+        } else {
+            for (int i = 0; i < len(start); i++) {
+                starts.push_back(extract<Geometry2d::Point>(start[i]));
+            }
+        }
+
+        result = self->eval_best_receive_point(
+            *kickPoint, starts, RJ::Seconds(timeBudget), step, minDist,
+            extract<float>(args[2]), extract<float>(args[3]),
+            extract<float>(args[4]), extract<float>(args[5]),
+            extract<int>(args[6]), extract<float>(args[7]),
+            extract<float>(args[8]));
+    }
+
+    return boost::python::make_tuple(result.first, result.second);
+}
+
+boost::python::tuple PassPosEval_eval_best_receive_point_no_budget(
+    PassPositionEvaluator* self, const Geometry2d::Point* kickPoint,
+    const boost::python::object& start,
+    const boost::python::tuple& nelderMeadArgs) {
+    return PassPosEval_eval_best_receive_point(self, kickPoint, start,
+                                               nelderMeadArgs, 0);
+}
+
+template <size_t N>
+boost::python::tuple PassPosEval_weights_tuple(const std::array<float, N>& w) {
+    boost::python::list lst;
+    for (float weight : w) {
+        lst.append(weight);
+    }
+    return boost::python::tuple{lst};
+}
+
+template <size_t N>
+void PassPosEval_assign_weights(std::array<float, N>& w,
+                                const boost::python::object& values) {
+    if (len(values) != N) {
+        PyErr_SetString(PyExc_ValueError, "Wrong number of weights");
+        boost::python::throw_error_already_set();
+    }
+    for (size_t i = 0; i < N; i++) {
+        w[i] = boost::python::extract<float>(values[i]);
+    }
+}
+
+boost::python::tuple PassPosEval_get_field_weights(
+    const PassPositionEvaluator* self) {
+    return PassPosEval_weights_tuple(self->field_weights);
+}
+
+void PassPosEval_set_field_weights(PassPositionEvaluator* self,
+                                   const boost::python::object& values) {
+    PassPosEval_assign_weights(self->field_weights, values);
+}
+
+boost::python::tuple PassPosEval_get_weights(
+    const PassPositionEvaluator* self) {
+    return PassPosEval_weights_tuple(self->weights);
+}
+
+void PassPosEval_set_weights(PassPositionEvaluator* self,
+                             const boost::python::object& values) {
+    PassPosEval_assign_weights(self->weights, values);
+}
+
+std::optional<int> optional_int(const boost::python::object& value) {
+    if (value.is_none()) return std::nullopt;
+    return boost::python::extract<int>(value)();
+}
+
+/**
+ * Assigns robots to a list of role_assignment.RoleRequirements.  Only the
+ * requirements' cost_funcs are called back in python.
+ *
+ * Returns a tuple of ([(robot index, role index)], total cost, fail reason).
+ */
+boost::python::tuple Gameplay_assign_roles(
+    const boost::python::list& robots, const boost::python::list& reqs,
+    const boost::python::object& forbiddenBallToucher) {
+    std::vector<OurRobot*> robotVec;
+    for (int i = 0; i < len(robots); i++) {
+        OurRobot* robot = boost::python::extract<OurRobot*>(robots[i]);
+        if (robot == nullptr) throw NullArgumentException("robots");
+        robotVec.push_back(robot);
+    }
+
+    std::vector<Gameplay::RoleRequirements> roles;
+    for (int i = 0; i < len(reqs); i++) {
+        const boost::python::object req = reqs[i];
+        Gameplay::RoleRequirements role;
+
+        const boost::python::object shape = req.attr("destination_shape");
+        boost::python::extract<Geometry2d::Point> point(shape);
+        boost::python::extract<Geometry2d::Segment> segment(shape);
+        if (point.check()) {
+            role.destinationPoint = point();
+        } else if (segment.check()) {
+            role.destinationSegment = segment();
+        }
+
+        role.positionCostMultiplier =
+            boost::python::extract<double>(req.attr("position_cost_multiplier"));
+        role.hasBall = bool(req.attr("has_ball"));
+        role.chipperPreferenceWeight = boost::python::extract<double>(
+            req.attr("chipper_preference_weight"));
+        role.requiredShellID = optional_int(req.attr("required_shell_id"));
+        role.previousShellID = optional_int(req.attr("previous_shell_id"));
+        role.prohibitedShellID = optional_int(req.attr("prohibited_shell_id"));
+        role.requireKicking = bool(req.attr("require_kicking"));
+        role.requireChipping = bool(req.attr("require_chipping"));
+        role.robotChangeCost =
+            boost::python::extract<double>(req.attr("robot_change_cost"));
+
+        const boost::python::object costFunc = req.attr("cost_func");
+        if (!costFunc.is_none()) {
+            // Called with the robot's original python object, in case the
+            // function keeps track of robots by identity
+            role.costFunc = [costFunc, robots, robotVec](OurRobot* robot) {
+                const int index =
+                    std::find(robotVec.begin(), robotVec.end(), robot) -
+                    robotVec.begin();
+                const boost::python::object pyRobot = robots[index];
+                return boost::python::extract<double>(costFunc(pyRobot))();
+            };
+        }
+
+        roles.push_back(std::move(role));
+    }
+
+    Gameplay::RoleAssignments result;
+    try {
+        result = Gameplay::assignRoles(robotVec, roles,
+                                       optional_int(forbiddenBallToucher));
+    } catch (const std::domain_error& e) {
+        PyErr_SetString(PyExc_ArithmeticError, e.what());
+        boost::python::throw_error_already_set();
+    }
+
+    boost::python::list assignments;
+    for (const auto& assignment : result.assignments) {
+        assignments.append(
+            boost::python::make_tuple(assignment.first, assignment.second));
+    }
+
+    return boost::python::make_tuple(assignments, result.totalCost,
+                                     result.failReason);
+}
+
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(Point_overloads, normalized, 0, 1)
 
 boost::shared_ptr<PythonFunctionWrapper> PythonFunctionWrapper_constructor(
@@ -687,6 +1031,7 @@ BOOST_PYTHON_MODULE(robocup) {
 
     def("fix_angle_radians", &fixAngleRadians);
     def("get_trapezoidal_time", &Trapezoidal::getTime);
+    def("assign_roles", &Gameplay_assign_roles);
 
     class_<Geometry2d::Point, Geometry2d::Point*>("Point", init<float, float>())
         .def(init<const Geometry2d::Point&>())
@@ -927,7 +1272,7 @@ BOOST_PYTHON_MODULE(robocup) {
     class_<DebugDrawer, DebugDrawer*>("DebugDrawer", init<Context*>())
         .def("draw_circle", &DebugDrawer_draw_circle)
         .def("draw_text", &DebugDrawer_draw_text)
-        .def("draw_shape", &DebugDrawer::drawShape)
+        .def("draw_shape", &DebugDrawer_draw_shape)
         .def("draw_line", &DebugDrawer_draw_line)
         .def("draw_line", &DebugDrawer_draw_segment)
         .def("draw_segment", &DebugDrawer_draw_segment)
@@ -1001,7 +1346,9 @@ BOOST_PYTHON_MODULE(robocup) {
         .def("eval_pt_to_robot", &WinEval_eval_pt_to_robot)
         .def("eval_pt_to_opp_goal", &WinEval_eval_pt_to_opp_goal)
         .def("eval_pt_to_our_goal", &WinEval_eval_pt_to_our_goal)
-        .def("eval_pt_to_seg", &WinEval_eval_pt_to_seg);
+        .def("eval_pt_to_seg", &WinEval_eval_pt_to_seg)
+        .def("eval_pts_to_seg", &WinEval_eval_pts_to_seg)
+        .def("eval_pts_to_segs", &WinEval_eval_pts_to_segs);
 
     class_<KickEvaluator>("KickEvaluator", init<SystemState*>())
         .def_readwrite("excluded_robots", &KickEvaluator::excluded_robots)
@@ -1012,7 +1359,27 @@ BOOST_PYTHON_MODULE(robocup) {
         .def("eval_pt_to_robot", &KickEval_eval_pt_to_robot)
         .def("eval_pt_to_opp_goal", &KickEval_eval_pt_to_opp_goal)
         .def("eval_pt_to_our_goal", &KickEval_eval_pt_to_our_goal)
-        .def("eval_pt_to_seg", &KickEval_eval_pt_to_seg);
+        .def("eval_pt_to_seg", &KickEval_eval_pt_to_seg)
+        .def("eval_pts_to_opp_goal", &KickEval_eval_pts_to_opp_goal)
+        .def("eval_pts_to_our_goal", &KickEval_eval_pts_to_our_goal)
+        .def("eval_pts_to_seg", &KickEval_eval_pts_to_seg);
+
+    class_<PassPositionEvaluator>("PassPositionEvaluator", init<Context*>())
+        .def_readwrite("excluded_robots",
+                       &PassPositionEvaluator::excluded_robots)
+        .def_readwrite("min_pass_dist", &PassPositionEvaluator::min_pass_dist)
+        .add_property("field_weights", &PassPosEval_get_field_weights,
+                      &PassPosEval_set_field_weights)
+        .add_property("weights", &PassPosEval_get_weights,
+                      &PassPosEval_set_weights)
+        .def("add_excluded_robot", &PassPosEval_add_excluded_robot)
+        .def("eval_single_point", &PassPosEval_eval_single_point)
+        .def("eval_field", &PassPosEval_eval_field)
+        .def("eval_best_receive_point",
+             &PassPosEval_eval_best_receive_point_no_budget)
+        .def("eval_best_receive_point", &PassPosEval_eval_best_receive_point)
+        .def("field_max_point", &PassPosEval_field_max_point)
+        .staticmethod("field_max_point");
 
     class_<PythonFunctionWrapper>("PythonFunctionWrapper", no_init)
         .def("__init__", make_constructor(&PythonFunctionWrapper_constructor));
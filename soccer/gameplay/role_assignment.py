@@ -1,8 +1,6 @@
-import munkres
 import evaluation.double_touch
 import robocup
 import logging
-import math
 
 # TODO arbitrary cost lambda property
 
@@ -26,7 +24,9 @@ class RoleRequirements:
 
         # A lambda function property that allows customization of cost
         # Has exactly one parameter, which is a robot
-        self.cost_func = lambda r: 0
+        # None means no extra cost, which saves a call back into python for
+        # every robot
+        self.cost_func = None
 
     def __str__(self):
         props = []
@@ -191,14 +191,10 @@ class ImpossibleAssignmentError(RuntimeError):
     pass
 
 
-# the munkres library doesn't like infinity, so we use this instead
+# the cost of a robot that doesn't meet a role's requirements
+# (Gameplay::RoleMaxWeight)
 MaxWeight = 10000000
 
-# The munkres library works in ints, so multiply everything by 1000
-# In theory it should work with floats, but the types are getting messed up
-# This creates a fixed point type situation
-IntScale = 1000
-
 # a default weight for preferring a chipper
 # this is tunable
 PreferChipper = 2.5
@@ -206,6 +202,8 @@ PreferChipper = 2.5
 
 # uses the munkres/hungarian algorithm to find the optimal role assignments
 # works by building a cost matrix for reach robot, role pair, then choosing the assignments to minimize total cost
+# The cost matrix and solver are in c++ (robocup.assign_roles()), which only
+# calls back into python for each role's cost_func
 # If no restraint-satisfying mass assignment exists, throws an ImpossibleAssignmentError
 #
 # role_reqs is a tree structure containing RoleRequirements
@@ -213,8 +211,6 @@ PreferChipper = 2.5
 # returns a tree with the same structure as @role_reqs, but the leaf nodes have (RoleRequirements, OurRobot) tuples instead of just RoleRequirements objects
 def assign_roles(robots, role_reqs):
 
-    fail_reason = ""
-
     # check for empty request set
     if len(role_reqs) == 0:
         return {}
@@ -277,68 +273,11 @@ def assign_roles(robots, role_reqs):
     if len(robots) == 0:
         return {}
 
-    # build the cost matrix
-    cost_matrix = []
-    for robot in robots:
-        cost_row = []
-        for req in role_reqs_list:
-            cost = 0
-
-            if req.required_shell_id is not None and req.required_shell_id != robot.shell_id(
-            ):
-                cost = MaxWeight
-                fail_reason += (
-                    "Robot {}: Required ID {} does not match {}\n".format(
-                        robot.shell_id(), req.required_shell_id,
-                        robot.shell_id()))
-            elif req.has_ball and not robot.has_ball():
-                cost = MaxWeight
-                fail_reason += "Robot {}: does not have ball\n".format(
-                    robot.shell_id())
-            elif req.require_kicking and (
-                    robot.shell_id() == evaluation.double_touch.tracker()
-                    .forbidden_ball_toucher() or not robot.kicker_works() or
-                    not robot.ball_sense_works()):
-                cost = MaxWeight
-                fail_reason += (
-                    "Robot {}: does not have a fully working kicking setup"
-                    " (or double touched)\n"
-                        .format(robot.shell_id()))
-            elif req.require_chipping and (
-                    robot.shell_id() == evaluation.double_touch.tracker()
-                    .forbidden_ball_toucher() or not robot.has_chipper() or
-                    not robot.ball_sense_works()):
-                cost = MaxWeight
-                fail_reason += ("Robot {}: does not have a chipper"
-                                " (or double touched)\n"
-                                .format(robot.shell_id()))
-            else:
-                if req.prohibited_shell_id is not None and req.prohibited_shell_id == robot.shell_id():
-                    cost = MaxWeight
-                if req.destination_shape is not None:
-                    cost += req.position_cost_multiplier * req.destination_shape.dist_to(robot.pos)
-                if req.previous_shell_id is not None and req.previous_shell_id != robot.shell_id():
-                    cost += req.robot_change_cost
-                if not robot.has_chipper():
-                    cost += req.chipper_preference_weight
-                cost += req.cost_func(robot)
-
-                cost *= IntScale
-
-            # the munkres library freezes when given NaN values, causing our
-            # whole program to hang and have to be restarted.  We check for it
-            # here and raise an exception if there's a NaN.
-            if (math.isnan(cost)):
-                raise ArithmeticError(
-                    "NaN value encountered when building role assignment cost matrix"
-                )
-
-            cost_row.append(cost)
-        cost_matrix.append(cost_row)
-
-    # solve
-    solver = munkres.Munkres()
-    indexes = solver.compute(cost_matrix)
+    # build the cost matrix and solve
+    # raises an ArithmeticError if a cost is NaN
+    indexes, total, fail_reason = robocup.assign_roles(
+        list(robots), role_reqs_list,
+        evaluation.double_touch.tracker().forbidden_ball_toucher())
 
     results = {}
 
@@ -353,11 +292,7 @@ def assign_roles(robots, role_reqs):
         parent[tree_path[-1]] = (role_reqs, robot)
 
     # build assignments mapping
-    assignments = {}
-    total = 0
     for row, col in indexes:
-        total += cost_matrix[row][col] / IntScale
-
         bot = robots[row]
         reqs = role_reqs_list[col]
 
@@ -24,6 +24,8 @@ class AdvanceZoneMidfielder(composite_behavior.CompositeBehavior):
     # Initial arguements for the nelder mead optimization in passing positioning
     NELDER_MEAD_ARGS = (robocup.Point(0.75, 1), robocup.Point(0.01, 0.01), 1,
                         1.1, 0.5, 0.9, 100, 1, 0.1)
+    # Seconds the alternative point search may take each frame
+    SEARCH_TIME_BUDGET = 0.005
 
     class State(enum.Enum):
         # getting ready to recieve a pass from another robot
@@ -57,6 +59,9 @@ class AdvanceZoneMidfielder(composite_behavior.CompositeBehavior):
 
         self.kick = False
 
+        # alternative point from the last frame, to restart the search from
+        self.alt_point = None
+
         self.priorities = [1, 2]
 
         self.names = ['best', 'alternative']
@@ -77,12 +82,21 @@ class AdvanceZoneMidfielder(composite_behavior.CompositeBehavior):
         # gets the best position to travel to for ball reception
         best_point = self.passing_point
 
-        # sets the second point
+        # sets the second point, searching from the passing point and from
+        # last frame's alternative point
+        starts = [self.passing_point]
+        if self.alt_point is not None:
+            starts.append(self.alt_point)
+
         alt_point, value2 = evaluation.passing_positioning.eval_best_receive_point(
                 self.passing_point,
-                main.our_robots(), AdvanceZoneMidfielder.FIELD_POS_WEIGHTS,
-                AdvanceZoneMidfielder.NELDER_MEAD_ARGS,
-                AdvanceZoneMidfielder.PASSING_WEIGHTS)
+                main.our_robots(),
+                field_weights=AdvanceZoneMidfielder.FIELD_POS_WEIGHTS,
+                nelder_mead_args=AdvanceZoneMidfielder.NELDER_MEAD_ARGS,
+                weights=AdvanceZoneMidfielder.PASSING_WEIGHTS,
+                start=starts,
+                time_budget=AdvanceZoneMidfielder.SEARCH_TIME_BUDGET)
+        self.alt_point = alt_point
 
         # check for futile position i.e the alternate position is in the way of a shot from best position
         if self.in_shot_triangle(best_point, alt_point):
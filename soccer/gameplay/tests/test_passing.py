@@ -123,3 +123,19 @@ class TestPassing(unittest.TestCase):
         self.assertEqual(
             self.eval_pass(0, 0, 0, passing_dest, [their_bot1]), self.success,
             "fail excluded_robots")
+
+    def test_eval_passes_matches_eval_pass(self):
+        their_bot1 = self.their_robots[0]
+        self.set_bot_pos(their_bot1, 0, self.center_y / 2)
+
+        from_points = [robocup.Point(x, 0)
+                       for x in (self.left_side, 0, self.right_side)]
+        to_points = [robocup.Point(0, self.center_y),
+                     robocup.Point(self.right_side, self.length),
+                     robocup.Point(0, self.botRadius * 2)]
+        chances = evaluation.passing.eval_passes(from_points, to_points)
+        self.assertEqual(len(chances), len(from_points))
+        for from_point, to_point, chance in zip(from_points, to_points,
+                                                chances):
+            self.assertEqual(
+                chance, evaluation.passing.eval_pass(from_point, to_point))
@@ -49,3 +49,24 @@ class TestRoleAssignment(unittest.TestCase):
         req_tree = {'role1': req1, 'role2': req2}
         self.assertRaises(role_assignment.ImpossibleAssignmentError,
                           role_assignment.assign_roles, [bot1], req_tree)
+
+    def test_cost_func(self):
+        """A role's cost_func is added to the built-in costs"""
+
+        bot1 = robocup.OurRobot(self.context, 1)
+        bot1.set_pos_for_testing(robocup.Point(1, 6))
+
+        bot2 = robocup.OurRobot(self.context, 2)
+        bot2.set_pos_for_testing(robocup.Point(2, 3))
+
+        req1 = role_assignment.RoleRequirements()
+        req1.destination_shape = robocup.Point(1, 7)
+        req1.cost_func = lambda r: 100 if r == bot1 else 0
+
+        req2 = role_assignment.RoleRequirements()
+        req2.destination_shape = robocup.Point(3, 4)
+
+        req_tree = {'role1': req1, 'role2': req2}
+        assignments = role_assignment.assign_roles([bot1, bot2], req_tree)
+        self.assertEqual(assignments['role1'][1], bot2)
+        self.assertEqual(assignments['role2'][1], bot1)
@@ -107,3 +107,16 @@ class TestShooting(unittest.TestCase):
         self.assertGreater(self.eval_shot(0, shooting_pos), self.failure)
         self.assertEqual(
             self.eval_shot(0, shooting_pos, [their_bot1]), self.success)
+
+    def test_eval_shots_matches_eval_shot(self):
+        their_bot1 = self.their_robots[0]
+        self.set_bot_pos(their_bot1, 0, 3 * self.length / 4 + self.botRadius * 3)
+
+        points = [robocup.Point(x, y)
+                  for x in (-self.width / 4, 0, self.width / 4)
+                  for y in (self.length / 2 + self.botRadius,
+                            3 * self.length / 4)]
+        chances = evaluation.shooting.eval_shots(points)
+        self.assertEqual(len(chances), len(points))
+        for pt, chance in zip(points, chances):
+            self.assertEqual(chance, evaluation.shooting.eval_shot(pt))
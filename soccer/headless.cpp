@@ -0,0 +1,227 @@
+#include <gameplay/GameplayModule.hpp>
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <iostream>
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QString>
+
+#include <Trace.hpp>
+#include "Configuration.hpp"
+#include "Processor.hpp"
+
+using namespace std;
+
+//  we use this to catch Ctrl+C and kill the program
+void signal_handler(int signum) { exit(signum); }
+
+// Where to save the trace on exit, if anywhere
+string traceFile;
+
+void writeTrace() {
+    if (!traceFile.empty() && Trace::writeJson(traceFile)) {
+        printf("Saved trace to %s\n", traceFile.c_str());
+    }
+}
+
+void usage(const char* prog) {
+    fprintf(stderr, "usage: %s [options...]\n", prog);
+    fprintf(stderr, "Runs soccer without a window or input devices.\n");
+    fprintf(stderr, "\t-y:             run as the yellow team\n");
+    fprintf(stderr, "\t-b:             run as the blue team\n");
+    fprintf(stderr, "\t-c <file>:      specify the configuration file\n");
+    fprintf(stderr,
+            "\t-s <seed>:      set random seed (hexadecimal, default 0)\n");
+    fprintf(stderr,
+            "\t-pbk <file>:    playbook file name as contained in "
+            "'soccer/gameplay/playbooks/'\n");
+    fprintf(stderr,
+            "\t-replay <file>: run over the vision and referee input in "
+            "<file>\n\t                as fast as possible, then exit\n");
+    fprintf(stderr,
+            "\t-trace <file>:  save a Chrome trace of the last few seconds "
+            "to <file>\n\t                on exit\n");
+    fprintf(stderr,
+            "\t-latency <file>: save vision to radio latency histograms to "
+            "<file>\n\t                as CSV when done\n");
+    fprintf(stderr, "\t-sim:           use simulator\n");
+    fprintf(stderr, "\t-nolog:         don't write log files\n");
+    fprintf(stderr, "\t-noref:         don't use external referee commands\n");
+    fprintf(stderr,
+            "\t-defend:        specify half of field to defend (plus or "
+            "minus)\n");
+    fprintf(stderr,
+            "\t-vision         specify the vision channel (1,2, or full)\n");
+    exit(0);
+}
+
+int main(int argc, char* argv[]) {
+    //  register our signal handler
+    signal(SIGINT, signal_handler);
+
+    QCoreApplication app(argc, argv);
+
+    // The seed is fixed unless one is given so runs can be reproduced
+    long int seed = 0;
+    bool blueTeam = true;
+    QString cfgFile;
+    bool sim = false;
+    bool log = true;
+    string playbookFile;
+    bool noref = false;
+    bool defendPlus = false;
+    string replayLogFile;
+    string latencyFile;
+    Processor::VisionChannel visionChannel = Processor::VisionChannel::full;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* var = argv[i];
+
+        if (strcmp(var, "--help") == 0) {
+            usage(argv[0]);
+        } else if (strcmp(var, "-y") == 0) {
+            blueTeam = false;
+        } else if (strcmp(var, "-b") == 0) {
+            blueTeam = true;
+        } else if (strcmp(var, "-sim") == 0) {
+            sim = true;
+        } else if (strcmp(var, "-nolog") == 0) {
+            log = false;
+        } else if (strcmp(var, "-c") == 0) {
+            if (i + 1 >= argc) {
+                printf("no config file specified after -c\n");
+                usage(argv[0]);
+            }
+
+            i++;
+            cfgFile = argv[i];
+        } else if (strcmp(var, "-s") == 0) {
+            if (i + 1 >= argc) {
+                printf("no seed specified after -s\n");
+                usage(argv[0]);
+            }
+
+            i++;
+            seed = strtol(argv[i], nullptr, 16);
+        } else if (strcmp(var, "-pbk") == 0) {
+            if (i + 1 >= argc) {
+                printf("no playbook file specified after -pbk\n");
+                usage(argv[0]);
+            }
+
+            playbookFile = argv[++i];
+        } else if (strcmp(var, "-replay") == 0) {
+            if (i + 1 >= argc) {
+                printf("no log file specified after -replay\n");
+                usage(argv[0]);
+            }
+
+            replayLogFile = argv[++i];
+        } else if (strcmp(var, "-trace") == 0) {
+            if (i + 1 >= argc) {
+                printf("no trace file specified after -trace\n");
+                usage(argv[0]);
+            }
+
+            traceFile = argv[++i];
+        } else if (strcmp(var, "-latency") == 0) {
+            if (i + 1 >= argc) {
+                printf("no latency file specified after -latency\n");
+                usage(argv[0]);
+            }
+
+            latencyFile = argv[++i];
+        } else if (strcmp(var, "-noref") == 0) {
+            noref = true;
+        } else if (strcmp(var, "-defend") == 0) {
+            if (i + 1 >= argc) {
+                printf("Field half not specified after -defend\n");
+                usage(argv[0]);
+            }
+            i++;
+            if (strcmp(argv[i], "plus") == 0) {
+                defendPlus = true;
+            } else if (strcmp(argv[i], "minus") != 0) {
+                printf("Invalid option for defendX\n");
+                usage(argv[0]);
+            }
+        } else if (strcmp(var, "-vision") == 0) {
+            if (i + 1 >= argc) {
+                printf("No vision channel specified after -vision\n");
+                usage(argv[0]);
+            }
+            i++;
+            if (strcmp(argv[i], "1") == 0) {
+                visionChannel = Processor::VisionChannel::primary;
+            } else if (strcmp(argv[i], "2") == 0) {
+                visionChannel = Processor::VisionChannel::secondary;
+            } else if (strcmp(argv[i], "full") != 0) {
+                printf("Invalid option for vision channel\n");
+                usage(argv[0]);
+            }
+        } else {
+            printf("Not a valid flag: %s\n", argv[i]);
+            usage(argv[0]);
+        }
+    }
+
+    // Also runs when exiting on Ctrl+C
+    atexit(writeTrace);
+
+    printf("seed %016lx\n", seed);
+    srand48(seed);
+
+    // Default config file name
+    if (cfgFile.isNull()) {
+        cfgFile = ApplicationRunDirectory().filePath(sim ? "soccer-sim.cfg"
+                                                         : "soccer-real.cfg");
+    }
+
+    std::shared_ptr<Configuration> config =
+        Configuration::FromRegisteredConfigurables();
+
+    auto processor = std::make_unique<Processor>(
+        sim, defendPlus, visionChannel, blueTeam, "", replayLogFile);
+    processor->refereeModule()->useExternalReferee(!noref);
+
+    QString error;
+    if (!config->load(cfgFile, error)) {
+        fprintf(stderr, "Can't read initial configuration %s:\n%s\n",
+                (const char*)cfgFile.toLatin1(),
+                (const char*)error.toLatin1());
+    }
+
+    if (!ApplicationRunDirectory().exists("./logs")) {
+        cerr << "No ./run/logs/ directory - not writing log file" << endl;
+    } else if (!log) {
+        cerr << "Not writing log file" << endl;
+    } else {
+        QString logFile =
+            ApplicationRunDirectory().filePath("./logs/") +
+            QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss") +
+            (replayLogFile.empty() ? ".log" : "-replay.log");
+        if (!processor->openLog(logFile)) {
+            printf("Failed to open %s: %m\n", (const char*)logFile.toLatin1());
+        }
+    }
+
+    if (playbookFile.size() > 0)
+        processor->gameplayModule()->loadPlaybook(playbookFile);
+
+    // A replay stops by itself at the end of the log.  Otherwise this runs
+    // until interrupted.
+    processor->start();
+    processor->wait();
+    processor->closeLog();
+
+    if (!latencyFile.empty()) {
+        processor->saveVisionLatency(latencyFile);
+    }
+
+    return 0;
+}
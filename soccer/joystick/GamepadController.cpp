@@ -1,4 +1,5 @@
 #include "GamepadController.hpp"
+#include <Constants.hpp>
 #include <algorithm>
 
 using namespace std;
@@ -14,8 +15,22 @@ const float TRIGGER_CUTOFF = 0.9;
 std::vector<int> GamepadController::controllersInUse = {};
 int GamepadController::joystickRemoved = -1;
 
+std::vector<Joystick*> GamepadController::createControllers() {
+    controllersInUse.clear();
+    joystickRemoved = -1;
+
+    std::vector<Joystick*> controllers;
+    for (size_t i = 0; i < Robots_Per_Team; i++) {
+        controllers.push_back(new GamepadController());
+    }
+    return controllers;
+}
+
 GamepadController::GamepadController()
-    : _controller(nullptr), _lastDribblerTime(), _lastKickerTime() {
+    : _controller(nullptr),
+      _lastDribblerTime(),
+      _lastKickerTime(),
+      _announcedRemoval(false) {
     // initialize using the SDL joystick
     if (SDL_Init(SDL_INIT_GAMECONTROLLER) != 0) {
         cerr << "ERROR: SDL could not initialize game controller system! SDL "
@@ -90,6 +105,7 @@ void GamepadController::closeJoystick() {
         controllersInUse.erase(index);
     }
     joystickRemoved = controllerId;
+    _announcedRemoval = true;
     controllerId = -1;
 
     robotId = -1;
@@ -108,6 +124,11 @@ void GamepadController::update() {
 
     RJ::Time now = RJ::now();
 
+    if (_announcedRemoval) {
+        joystickRemoved = -1;
+        _announcedRemoval = false;
+    }
+
     if (connected) {
         // Check if dc
         if (joystickRemoved >= 0 && controllerId > joystickRemoved) {
@@ -18,7 +18,14 @@ public:
 
     bool valid() const override;
 
+    /// Creates a controller for each robot that can be driven at once,
+    /// starting over with controller assignment
+    static std::vector<Joystick*> createControllers();
+
     static std::vector<int> controllersInUse;
+
+    // Id of a controller that was just disconnected, so the others can
+    // renumber themselves, or -1
     static int joystickRemoved;
 
 private:
@@ -33,4 +40,8 @@ private:
     void closeJoystick();
     bool connected;
     int controllerId;
+
+    // True if this controller set joystickRemoved and should clear it once
+    // every other controller has had an update to see it
+    bool _announcedRemoval;
 };
@@ -1,4 +1,5 @@
 #include <gameplay/GameplayModule.hpp>
+#include <joystick/GamepadController.hpp>
 #include <ui/StyleSheetManager.hpp>
 
 #include <assert.h>
@@ -180,6 +181,7 @@ int main(int argc, char* argv[]) {
     auto processor =
         std::make_unique<Processor>(sim, defendPlus, visionChannel, blueTeam, readLogFile);
     processor->refereeModule()->useExternalReferee(!noref);
+    processor->setJoysticks(GamepadController::createControllers());
 
     // Load config file
     QString error;
@@ -1,6 +1,8 @@
 #include "MotionControlNode.hpp"
 #include "Robot.hpp"
 
+#include <Trace.hpp>
+
 MotionControlNode::MotionControlNode(Context* context)
     : _context(context), _controllers(Num_Shells, std::nullopt) {
     _controllers.reserve(Num_Shells);
@@ -10,6 +12,7 @@ MotionControlNode::MotionControlNode(Context* context)
 }
 
 void MotionControlNode::run() {
+    TRACE_SCOPE("MotionControlNode::run");
     bool force_stop = _context->game_state.state == GameState::State::Halt;
     for (auto& maybe_controller : _controllers) {
         if (!maybe_controller) {
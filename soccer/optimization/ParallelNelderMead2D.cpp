@@ -0,0 +1,111 @@
+#include "ParallelNelderMead2D.hpp"
+#include <ThreadPool.hpp>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+
+ParallelNelderMead2D::ParallelNelderMead2D(ParallelNelderMead2DConfig& config)
+    : config(config) {
+    cachedF = [this](Geometry2d::Point p) { return evaluate(p); };
+
+    // NelderMead2D keeps a reference to its config, so these can't move once
+    // the simplices start
+    const NelderMead2DConfig& nm = config.nmConfig;
+    simplexConfigs.reserve(config.starts.size());
+    for (Geometry2d::Point start : config.starts) {
+        simplexConfigs.emplace_back(
+            cachedF, start, nm.step, nm.minDist, nm.reflectionCoeff,
+            nm.expansionCoeff, nm.contractionCoeff, nm.shrinkCoeff,
+            nm.maxIterations, nm.maxValue, nm.maxThresh);
+    }
+
+    results.assign(config.starts.size(),
+                   std::make_pair(-INFINITY, Geometry2d::Point()));
+}
+
+/**
+ * Executes every simplex until it converges or runs out of time
+ */
+void ParallelNelderMead2D::execute() {
+    // The calling thread runs one of the tasks
+    ThreadPool& pool = ThreadPool::evaluation();
+
+    const bool limitTime = config.timeBudget > RJ::Seconds(0);
+    const RJ::Time deadline =
+        RJ::now() +
+        std::chrono::duration_cast<RJ::Time::duration>(config.timeBudget);
+
+    // Each task runs every tasks'th simplex
+    const size_t count = simplexConfigs.size();
+    const size_t tasks = std::min(pool.size(), count);
+    pool.parallelFor(tasks, [&](size_t task) {
+        for (size_t i = task; i < count; i += tasks) {
+            // Same as NelderMead2D::execute(), but checks the time between
+            // steps.  Simplices are built even past the deadline so every
+            // start point is still evaluated.
+            NelderMead2D nm(simplexConfigs[i]);
+            while (nm.continueExecution()) {
+                if (limitTime && RJ::now() >= deadline) {
+                    break;
+                }
+                nm.singleStep();
+            }
+
+            results[i] = std::make_pair(nm.getValue(), nm.getPoint());
+        }
+    });
+}
+
+/**
+ * @return the XY coordinate of the best max found by any simplex
+ */
+Geometry2d::Point ParallelNelderMead2D::getPoint() const {
+    auto best = std::max_element(
+        results.begin(), results.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+    return best == results.end() ? Geometry2d::Point() : best->second;
+}
+
+/**
+ * @return the best max value found by any simplex
+ */
+float ParallelNelderMead2D::getValue() const {
+    auto best = std::max_element(
+        results.begin(), results.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+    return best == results.end() ? -INFINITY : best->first;
+}
+
+float ParallelNelderMead2D::evaluate(Geometry2d::Point p) {
+    const std::pair<int64_t, int64_t> cell(
+        std::llround(p.x() / config.cacheResolution),
+        std::llround(p.y() / config.cacheResolution));
+
+    std::promise<float> promise;
+    std::shared_future<float> pending;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = cache.find(cell);
+        if (it != cache.end()) {
+            pending = it->second;
+        } else {
+            cache.emplace(cell, promise.get_future().share());
+        }
+    }
+
+    // Another simplex got here first, and may still be evaluating it
+    if (pending.valid()) {
+        return pending.get();
+    }
+
+    // Evaluated without the lock, so other cells can be evaluated meanwhile
+    evaluations++;
+    try {
+        const float value = config.nmConfig.f(p);
+        promise.set_value(value);
+        return value;
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+}
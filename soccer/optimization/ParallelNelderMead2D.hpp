@@ -0,0 +1,82 @@
+#pragma once
+
+#include "NelderMead2D.hpp"
+#include "ParallelNelderMead2DConfig.hpp"
+#include <Geometry2d/Point.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Runs a Nelder-Mead 2D simplex from each of several start points at once on
+ * a shared thread pool, and keeps the best result
+ *
+ * Every evaluation goes through a cache shared by all the simplices, so a
+ * point is only evaluated once even when several simplices reach it at the
+ * same time.
+ *
+ * Use Example:
+ * ParallelNelderMead2D pnm(& [ParallelNelderMead2DConfig]);
+ * pnm.execute();
+ * pnm.getPoint();
+ */
+class ParallelNelderMead2D {
+public:
+    ParallelNelderMead2D(ParallelNelderMead2DConfig& config);
+
+    /**
+     * Executes every simplex until it converges or runs out of time
+     */
+    void execute();
+
+    /**
+     * @return the XY coordinate of the best max found by any simplex
+     */
+    Geometry2d::Point getPoint() const;
+
+    /**
+     * @return the best max value found by any simplex, or -infinity if there
+     *     were no starts
+     */
+    float getValue() const;
+
+    /**
+     * @return the number of times the objective was called
+     */
+    int getEvaluations() const { return evaluations; }
+
+private:
+    ParallelNelderMead2DConfig& config;
+
+    // Calls config.nmConfig.f at most once for each cache cell
+    float evaluate(Geometry2d::Point p);
+
+    std::function<float(Geometry2d::Point)> cachedF;
+
+    // One for each simplex, since each has its own start
+    std::vector<NelderMead2DConfig> simplexConfigs;
+
+    // Best value and point of each simplex
+    std::vector<std::pair<float, Geometry2d::Point>> results;
+
+    struct CellHash {
+        size_t operator()(const std::pair<int64_t, int64_t>& cell) const {
+            return std::hash<int64_t>()(cell.first) * 31 +
+                   std::hash<int64_t>()(cell.second);
+        }
+    };
+
+    // Values of evaluated cells.  A cell's future is added before it's
+    // evaluated, so other simplices wait for it instead of evaluating again.
+    std::unordered_map<std::pair<int64_t, int64_t>, std::shared_future<float>,
+                       CellHash>
+        cache;
+    std::mutex cacheMutex;
+
+    std::atomic<int> evaluations{0};
+};
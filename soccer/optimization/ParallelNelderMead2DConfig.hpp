@@ -0,0 +1,38 @@
+#pragma once
+
+#include "NelderMead2DConfig.hpp"
+#include <Geometry2d/Point.hpp>
+#include <time.hpp>
+#include <vector>
+
+/**
+ * Config data for a Parallel Nelder-Mead 2D optimizer
+ */
+class ParallelNelderMead2DConfig {
+public:
+    /**
+     * Creates a Parallel Nelder-Mead 2D config
+     *
+     * @param nmConfig settings shared by every simplex.  Its start is
+     *          replaced by each of @starts.  f must be safe to call from
+     *          several threads at once.
+     * @param starts starting point of each simplex
+     * @param timeBudget time after which every simplex stops, or zero for
+     *          no limit
+     * @param cacheResolution points closer than this in both X and Y share
+     *          one evaluation
+     */
+    ParallelNelderMead2DConfig(NelderMead2DConfig nmConfig,
+                               std::vector<Geometry2d::Point> starts,
+                               RJ::Seconds timeBudget = RJ::Seconds(0),
+                               double cacheResolution = 0.0001)
+        : nmConfig(nmConfig),
+          starts(std::move(starts)),
+          timeBudget(timeBudget),
+          cacheResolution(cacheResolution) {}
+
+    NelderMead2DConfig nmConfig;
+    std::vector<Geometry2d::Point> starts;
+    RJ::Seconds timeBudget;
+    double cacheResolution;
+};
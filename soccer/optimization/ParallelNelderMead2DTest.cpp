@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "NelderMead2D.hpp"
+#include "NelderMead2DConfig.hpp"
+#include "ParallelNelderMead2D.hpp"
+#include "ParallelNelderMead2DConfig.hpp"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace Geometry2d;
+
+// A low hill at (-2, -2) and a high one at (2, 2)
+static float twoHills(Point p) {
+    return std::exp(-(p - Point(-2, -2)).magsq()) +
+           2 * std::exp(-(p - Point(2, 2)).magsq());
+}
+
+TEST(ParallelNelderMead2D, finds_highest_start) {
+    std::function<float(Point)> f = &twoHills;
+    NelderMead2DConfig nmConfig(f, Point(0, 0), Point(0.5, 0.5),
+                                Point(0.001, 0.001), 1, 2, .5, .5, 1000, 0, 0);
+
+    // A single simplex started near the low hill stays on it
+    nmConfig.start = Point(-1.5, -1.5);
+    NelderMead2D nm(nmConfig);
+    nm.execute();
+    EXPECT_NEAR(nm.getValue(), 1, 0.01);
+
+    ParallelNelderMead2DConfig config(
+        nmConfig, {Point(-1.5, -1.5), Point(1.5, 1.5), Point(-1, 2)});
+    ParallelNelderMead2D pnm(config);
+    pnm.execute();
+
+    EXPECT_NEAR(pnm.getValue(), 2, 0.01);
+    EXPECT_NEAR(pnm.getPoint().x(), 2, 0.01);
+    EXPECT_NEAR(pnm.getPoint().y(), 2, 0.01);
+}
+
+TEST(ParallelNelderMead2D, matches_single) {
+    std::function<float(Point)> f = &twoHills;
+    NelderMead2DConfig nmConfig(f, Point(1, 1), Point(0.5, 0.5),
+                                Point(0.001, 0.001), 1, 2, .5, .5, 1000, 0, 0);
+    NelderMead2D nm(nmConfig);
+    nm.execute();
+
+    ParallelNelderMead2DConfig config(nmConfig, {Point(1, 1)});
+    ParallelNelderMead2D pnm(config);
+    pnm.execute();
+
+    EXPECT_NEAR(nm.getValue(), pnm.getValue(), 0.001);
+    EXPECT_NEAR(nm.getPoint().x(), pnm.getPoint().x(), 0.001);
+    EXPECT_NEAR(nm.getPoint().y(), pnm.getPoint().y(), 0.001);
+}
+
+TEST(ParallelNelderMead2D, shares_evaluations) {
+    std::atomic<int> calls{0};
+    std::function<float(Point)> f = [&calls](Point p) {
+        calls++;
+        return twoHills(p);
+    };
+    NelderMead2DConfig nmConfig(f, Point(0, 0), Point(0.5, 0.5),
+                                Point(0.001, 0.001), 1, 2, .5, .5, 1000, 0, 0);
+
+    ParallelNelderMead2DConfig single(nmConfig, {Point(1, 1)});
+    ParallelNelderMead2D pnmSingle(single);
+    pnmSingle.execute();
+    const int singleCalls = calls;
+    EXPECT_EQ(singleCalls, pnmSingle.getEvaluations());
+
+    // Identical simplices only evaluate each point once between them
+    calls = 0;
+    ParallelNelderMead2DConfig repeated(
+        nmConfig, {Point(1, 1), Point(1, 1), Point(1, 1)});
+    ParallelNelderMead2D pnmRepeated(repeated);
+    pnmRepeated.execute();
+    EXPECT_EQ(singleCalls, calls);
+    EXPECT_EQ(pnmSingle.getValue(), pnmRepeated.getValue());
+}
+
+TEST(ParallelNelderMead2D, time_budget) {
+    std::function<float(Point)> f = [](Point p) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return twoHills(p);
+    };
+    NelderMead2DConfig nmConfig(f, Point(0, 0), Point(0.5, 0.5),
+                                Point(1e-9, 1e-9), 1, 2, .5, .5, 100000, 0, 0);
+
+    std::vector<Point> starts;
+    for (int i = 0; i < 16; i++) {
+        starts.emplace_back(-2 + 0.25 * i, 2 - 0.25 * i);
+    }
+    ParallelNelderMead2DConfig config(nmConfig, starts, RJ::Seconds(0.02));
+    ParallelNelderMead2D pnm(config);
+
+    auto start = std::chrono::steady_clock::now();
+    pnm.execute();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_LT(elapsed, std::chrono::milliseconds(200));
+    EXPECT_GT(pnm.getValue(), 0);
+}
+
+// Starts reached after the deadline still report their start value
+TEST(ParallelNelderMead2D, expired_budget) {
+    std::function<float(Point)> f = [](Point p) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return twoHills(p);
+    };
+    NelderMead2DConfig nmConfig(f, Point(0, 0), Point(0.5, 0.5));
+
+    std::vector<Point> starts = {Point(-2, 2), Point(1, 1)};
+    ParallelNelderMead2DConfig config(nmConfig, starts, RJ::Seconds(1e-9));
+    ParallelNelderMead2D pnm(config);
+    pnm.execute();
+
+    EXPECT_GE(pnm.getValue(), twoHills(Point(1, 1)));
+    EXPECT_NE(Point(), pnm.getPoint());
+}
+
+TEST(ParallelNelderMead2D, no_starts) {
+    std::function<float(Point)> f = &twoHills;
+    NelderMead2DConfig nmConfig(f);
+    ParallelNelderMead2DConfig config(nmConfig, {});
+    ParallelNelderMead2D pnm(config);
+    pnm.execute();
+
+    EXPECT_EQ(-INFINITY, pnm.getValue());
+    EXPECT_EQ(0, pnm.getEvaluations());
+}
@@ -9,7 +9,6 @@ DynamicObstacle::DynamicObstacle(const Path* path, float radius)
     : staticPoint(path->start().motion.pos),
       path(path),
       radius(radius),
-      staticObstacle(std::make_shared<Geometry2d::Circle>(
-          path->start().motion.pos, radius)){};
+      staticObstacle(path->start().motion.pos, radius){};
 
 }  // namespace Planning
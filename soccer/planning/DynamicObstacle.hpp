@@ -19,7 +19,7 @@ private:
     const Path* const path;
     const float radius;
     const Geometry2d::Point staticPoint;
-    const std::shared_ptr<Geometry2d::Circle> staticObstacle;
+    const Geometry2d::Circle staticObstacle;
 
 public:
     DynamicObstacle(Geometry2d::Point staticPoint, float radius,
@@ -27,14 +27,13 @@ public:
         : staticPoint(staticPoint),
           path(path),
           radius(radius),
-          staticObstacle(
-              std::make_shared<Geometry2d::Circle>(staticPoint, radius)) {}
+          staticObstacle(staticPoint, radius) {}
 
     DynamicObstacle(Geometry2d::Circle circle)
         : staticPoint(circle.center),
           path(nullptr),
           radius(circle.radius()),
-          staticObstacle(std::make_shared<Geometry2d::Circle>(circle)) {}
+          staticObstacle(circle) {}
 
     DynamicObstacle(const Path* path, float radius);
 
@@ -47,7 +46,7 @@ public:
     // Radius = radius of obstacle
     float getRadius() const { return radius; }
 
-    std::shared_ptr<Geometry2d::Circle> getStaticObstacle() const {
+    const Geometry2d::Circle& getStaticObstacle() const {
         return staticObstacle;
     }
 };
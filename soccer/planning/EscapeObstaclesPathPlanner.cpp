@@ -34,7 +34,7 @@ std::unique_ptr<Path> EscapeObstaclesPathPlanner::run(
     std::optional<Point> optPrevPt;
     if (prevPath) optPrevPt = prevPath->end().motion.pos;
     const Point unblocked = findNonBlockedGoal(
-        startInstant.pos, optPrevPt, obstacles, 300,
+        startInstant.pos, optPrevPt, obstacles, _random, 300,
         [&](const RRT::Tree<Point>& rrt) {
             if (*RRTConfig::EnableRRTDebugDrawing) {
                 DrawRRT(rrt, &planRequest.context->debug_drawer,
@@ -61,10 +61,11 @@ std::unique_ptr<Path> EscapeObstaclesPathPlanner::run(
 
 Point EscapeObstaclesPathPlanner::findNonBlockedGoal(
     Point goal, std::optional<Point> prevGoal, const ShapeSet& obstacles,
-    int maxItr, std::function<void(const RRT::Tree<Point>&)> rrtLogger) {
+    std::mt19937& random, int maxItr,
+    std::function<void(const RRT::Tree<Point>&)> rrtLogger) {
     if (obstacles.hit(goal)) {
         auto stateSpace = make_shared<RoboCupStateSpace>(
-            Field_Dimensions::Current_Dimensions, obstacles);
+            Field_Dimensions::Current_Dimensions, obstacles, random);
         RRT::Tree<Point> rrt(stateSpace, Point::hash, 2);
         rrt.setStartState(goal);
         // note: we don't set goal state because we're not looking for a
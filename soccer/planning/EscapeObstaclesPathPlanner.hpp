@@ -26,10 +26,12 @@ public:
     /// Uses an RRT to find a point near to @pt that isn't blocked by obstacles.
     /// If @prevPt is give, only uses a newly-found point if it is closer to @pt
     /// by a configurable threshold.
+    /// @param random Generator the RRT samples from
     /// @param rrtLogger Optional callback to log the rrt tree after it's built
     static Geometry2d::Point findNonBlockedGoal(
         Geometry2d::Point pt, std::optional<Geometry2d::Point> prevPt,
-        const Geometry2d::ShapeSet& obstacles, int maxItr = 300,
+        const Geometry2d::ShapeSet& obstacles, std::mt19937& random,
+        int maxItr = 300,
         std::function<void(const RRT::Tree<Geometry2d::Point>&)> rrtLogger =
             nullptr);
 
@@ -2,14 +2,46 @@
 #include "RobotConstraints.hpp"
 #include "InterpolatedPath.hpp"
 
+#include <Trace.hpp>
+
+#include <stdlib.h>
+
 using namespace std;
 namespace Planning {
 
+REGISTER_CONFIGURABLE(IndependentMultiRobotPathPlanner);
+
+ConfigBool* IndependentMultiRobotPathPlanner::_parallel;
+ConfigInt* IndependentMultiRobotPathPlanner::_numThreads;
+
+void IndependentMultiRobotPathPlanner::createConfiguration(
+    Configuration* cfg) {
+    _parallel = new ConfigBool(cfg, "PathPlanner/parallel", false);
+    // 0 uses one thread per core
+    _numThreads = new ConfigInt(cfg, "PathPlanner/parallelThreads", 0);
+}
+
+std::unique_ptr<Path> IndependentMultiRobotPathPlanner::planOne(
+    int shell, PlanRequest& request, RJ::Seconds* planTime) {
+    TRACE_SCOPE("IndependentMultiRobotPathPlanner::planOne");
+    const RJ::Time start = RJ::now();
+    std::unique_ptr<Path> path = _planners.at(shell)->run(request);
+    *planTime = RJ::now() - start;
+
+    if (!path) {
+        path = Planning::InterpolatedPath::emptyPath(request.start.pos);
+        debugLog("path was null!! " + to_string(shell) + ":" +
+                 to_string(request.motionCommand->getCommandType()));
+    }
+    return path;
+}
+
 std::map<int, std::unique_ptr<Path>> IndependentMultiRobotPathPlanner::run(
     std::map<int, PlanRequest> requests) {
+    TRACE_SCOPE("IndependentMultiRobotPathPlanner::run");
     std::map<int, std::unique_ptr<Path>> paths;
 
-    std::map<int, shared_ptr<Geometry2d::Circle>> staticRobotObstacles;
+    std::map<int, Geometry2d::Circle> staticRobotObstacles;
     std::vector<int> staticRequests;
     std::vector<int> dynamicRequests;
     for (auto& entry : requests) {
@@ -24,6 +56,9 @@ std::map<int, std::unique_ptr<Path>> IndependentMultiRobotPathPlanner::run(
                 request.motionCommand->getCommandType()) {
             _planners[shell] =
                 PlannerForCommandType(request.motionCommand->getCommandType());
+            // Seeded here, before any parallel planning, so runs with the
+            // same srand48() seed plan the same paths
+            _planners[shell]->seedRandom(lrand48());
             request.prevPath = nullptr;
         }
 
@@ -32,8 +67,8 @@ std::map<int, std::unique_ptr<Path>> IndependentMultiRobotPathPlanner::run(
         } else {
             staticRequests.push_back(shell);
         }
-        staticRobotObstacles[shell] = std::make_shared<Geometry2d::Circle>(
-            request.start.pos, Robot_Radius);
+        staticRobotObstacles[shell] =
+            Geometry2d::Circle(request.start.pos, Robot_Radius);
     }
 
     // Sorts descending so that higher priorities are first
@@ -45,44 +80,96 @@ std::map<int, std::unique_ptr<Path>> IndependentMultiRobotPathPlanner::run(
     std::sort(std::begin(dynamicRequests), std::end(dynamicRequests),
               comparator);
 
-    std::vector<int> inOrderRequests;
-    inOrderRequests.insert(std::end(inOrderRequests),
-                           std::begin(staticRequests),
-                           std::end(staticRequests));
-    inOrderRequests.insert(std::end(inOrderRequests),
-                           std::begin(dynamicRequests),
-                           std::end(dynamicRequests));
+    // Each wave only depends on the paths planned in earlier waves.  When
+    // planning sequentially every robot is its own wave, which preserves the
+    // strict priority ordering.
+    const bool parallel = *_parallel;
+    std::vector<std::vector<int>> waves;
+    if (parallel) {
+        if (!staticRequests.empty()) {
+            waves.push_back(staticRequests);
+        }
+        for (size_t i = 0; i < dynamicRequests.size(); i++) {
+            if (i == 0 || requests.at(dynamicRequests[i]).priority !=
+                              requests.at(dynamicRequests[i - 1]).priority) {
+                waves.emplace_back();
+            }
+            waves.back().push_back(dynamicRequests[i]);
+        }
+    } else {
+        for (int shell : staticRequests) {
+            waves.push_back({shell});
+        }
+        for (int shell : dynamicRequests) {
+            waves.push_back({shell});
+        }
+    }
+
+    if (parallel && !_pool) {
+        _pool = std::make_unique<ThreadPool>(std::max(0, (int)*_numThreads));
+    }
 
+    std::map<int, RJ::Seconds> planTimes;
     vector<DynamicObstacle> ourRobotsObstacles;
-    for (int shell : inOrderRequests) {
-        PlanRequest& request = requests.at(shell);
+    for (const std::vector<int>& wave : waves) {
+        for (int shell : wave) {
+            PlanRequest& request = requests.at(shell);
 
-        if (_planners[shell]->canHandleDynamic()) {
-            std::copy(std::begin(ourRobotsObstacles),
-                      std::end(ourRobotsObstacles),
-                      std::back_inserter(request.dynamicObstacles));
-        } else {
-            for (auto& entry : staticRobotObstacles) {
-                if (entry.first != shell) {
-                    request.obstacles.add(entry.second);
+            if (_planners[shell]->canHandleDynamic()) {
+                std::copy(std::begin(ourRobotsObstacles),
+                          std::end(ourRobotsObstacles),
+                          std::back_inserter(request.dynamicObstacles));
+            } else {
+                for (auto& entry : staticRobotObstacles) {
+                    if (entry.first != shell) {
+                        request.obstacles.add(entry.second);
+                    }
                 }
+                SingleRobotPathPlanner::allDynamicToStatic(
+                    request.obstacles, request.dynamicObstacles);
+                request.dynamicObstacles = std::vector<DynamicObstacle>();
+            }
+
+            planTimes[shell] = RJ::Seconds::zero();
+            paths[shell] = nullptr;
+        }
+
+        // Only the paths and plan times of this wave's robots are written, and
+        // the map nodes were created above, so workers never touch the same
+        // element
+        auto planShell = [&](size_t i) {
+            const int shell = wave[i];
+            paths.at(shell) =
+                planOne(shell, requests.at(shell), &planTimes.at(shell));
+        };
+
+        if (parallel && wave.size() > 1) {
+            _pool->parallelFor(wave.size(), planShell);
+        } else {
+            for (size_t i = 0; i < wave.size(); i++) {
+                planShell(i);
             }
-            SingleRobotPathPlanner::allDynamicToStatic(
-                request.obstacles, request.dynamicObstacles);
-            request.dynamicObstacles = std::vector<DynamicObstacle>();
         }
 
-        std::unique_ptr<Path> path = _planners[shell]->run(request);
-        if (!path) {
-            path = Planning::InterpolatedPath::emptyPath(request.start.pos);
-            debugLog("path was null!! " + to_string(shell) + ":" +
-                     to_string(request.motionCommand->getCommandType()));
+        // Add our generated paths to our list of our Robot Obstacles
+        for (int shell : wave) {
+            ourRobotsObstacles.push_back(
+                DynamicObstacle(requests.at(shell).start.pos, Robot_Radius,
+                                paths[shell].get()));
         }
-        paths[shell] = std::move(path);
+    }
 
-        // Add our generated path to our list of our Robot Obstacles
-        ourRobotsObstacles.push_back(DynamicObstacle(
-            request.start.pos, Robot_Radius, paths[shell].get()));
+    // Report how long each robot took to plan
+    if (!requests.empty()) {
+        Context* context = requests.begin()->second.context;
+        if (context && context->state.logFrame) {
+            for (const auto& entry : planTimes) {
+                Packet::LogFrame::PlannerTiming* timing =
+                    context->state.logFrame->add_planner_timing();
+                timing->set_shell(entry.first);
+                timing->set_duration(RJ::numMicroseconds(entry.second));
+            }
+        }
     }
 
     return paths;
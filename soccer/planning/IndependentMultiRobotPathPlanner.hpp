@@ -1,5 +1,7 @@
 #pragma once
 
+#include <Configuration.hpp>
+#include <ThreadPool.hpp>
 #include "MultiRobotPathPlanner.hpp"
 #include "SingleRobotPathPlanner.hpp"
 
@@ -8,14 +10,33 @@ namespace Planning {
 /// Plans paths for a collection of robots using a SingleRobotPathPlanner for
 /// each.  This planner doesn't take other robots' paths into account when
 /// planning, which means that occasionally the planned paths will collide.
+///
+/// When PathPlanner/parallel is enabled, robots are planned on a worker pool
+/// in priority waves: every planner that can't handle dynamic obstacles runs
+/// in the first wave, followed by one wave per distinct priority of the
+/// remaining robots.  Each wave sees the paths of all earlier waves as
+/// DynamicObstacles, so lower-priority robots still avoid higher-priority
+/// ones, but robots with equal priority no longer see each other.
 class IndependentMultiRobotPathPlanner : public MultiRobotPathPlanner {
 public:
     virtual std::map<int, std::unique_ptr<Path>> run(
         std::map<int, PlanRequest> requests) override;
 
+    static void createConfiguration(Configuration* cfg);
+
 private:
+    /// Plans a single robot and records how long it took in @planTime
+    std::unique_ptr<Path> planOne(int shell, PlanRequest& request,
+                                  RJ::Seconds* planTime);
+
     /// Map of shell id -> planner
     std::map<int, std::unique_ptr<SingleRobotPathPlanner>> _planners;
+
+    /// Created on first use of parallel planning
+    std::unique_ptr<ThreadPool> _pool;
+
+    static ConfigBool* _parallel;
+    static ConfigInt* _numThreads;
 };
 
 }  // namespace Planning
@@ -5,6 +5,7 @@
 #include "SystemState.hpp"
 #include "Utils.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 using namespace std;
@@ -86,17 +87,18 @@ bool InterpolatedPath::hit(const Geometry2d::ShapeSet& obstacles,
 
     // This code disregards obstacles which the robot starts in. This allows the
     // robot to move out a obstacle if it is already in one.
-    std::set<std::shared_ptr<Shape>> startHitSet =
+    const std::vector<uint32_t> startHitSet =
         obstacles.hitSet(waypoints[start].pose.position());
 
     for (size_t i = start; i < waypoints.size() - 1; i++) {
-        std::set<std::shared_ptr<Shape>> newHitSet = obstacles.hitSet(Segment(
+        const std::vector<uint32_t> newHitSet = obstacles.hitSet(Segment(
             waypoints[i].pose.position(), waypoints[i + 1].pose.position()));
         if (!newHitSet.empty()) {
-            for (std::shared_ptr<Shape> hit : newHitSet) {
+            for (uint32_t hit : newHitSet) {
                 // If it hits something, check if the hit was in the original
                 // hitSet
-                if (startHitSet.find(hit) == startHitSet.end()) {
+                if (!std::binary_search(startHitSet.begin(),
+                                        startHitSet.end(), hit)) {
                     if (hitTime) {
                         *hitTime = waypoints[i].time;
                     }
@@ -200,6 +202,25 @@ void InterpolatedPath::draw(DebugDrawer* const debug_drawer,
     }
 }
 
+size_t InterpolatedPath::segmentEnd(RJ::Seconds t) const {
+    // Paths are usually evaluated at increasing times, so try the segment used
+    // last time and the one after it before searching the whole path
+    const size_t hint = _cursor.load();
+    for (size_t i = hint; i < hint + 2 && i < waypoints.size(); i++) {
+        if (i > 0 && waypoints[i - 1].time < t && t <= waypoints[i].time) {
+            _cursor.store(i);
+            return i;
+        }
+    }
+
+    const auto it = std::lower_bound(
+        waypoints.begin(), waypoints.end(), t,
+        [](const Entry& entry, RJ::Seconds t) { return entry.time < t; });
+    const size_t i = it - waypoints.begin();
+    _cursor.store(i);
+    return i;
+}
+
 std::optional<RobotInstant> InterpolatedPath::eval(RJ::Seconds t) const {
     if (waypoints.size() < 2) {
         return std::nullopt;
@@ -214,22 +235,11 @@ std::optional<RobotInstant> InterpolatedPath::eval(RJ::Seconds t) const {
 
     // Find the waypoints on either side of the query time such that
     // prev_it->time < t <= next_it->time
-    std::vector<Entry>::const_iterator prev_it = waypoints.begin();
-    std::vector<Entry>::const_iterator next_it = waypoints.begin();
-    while (next_it != waypoints.end()) {
-        if (next_it->time >= t) {
-            break;
-        }
-
-        prev_it = next_it;
-        next_it++;
-    }
-
-    assert(prev_it != waypoints.end());
-    assert(next_it != waypoints.end());
+    const auto next_it = waypoints.begin() + segmentEnd(t);
+    const auto prev_it = next_it - 1;
 
-    Entry prev_entry = *prev_it;
-    Entry next_entry = *next_it;
+    const Entry& prev_entry = *prev_it;
+    const Entry& next_entry = *next_it;
 
     RJ::Seconds dt = next_entry.time - prev_entry.time;
     if (dt == RJ::Seconds(0)) {
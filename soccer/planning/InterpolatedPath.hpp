@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <optional>
 
 #include <Configuration.hpp>
@@ -150,6 +151,31 @@ public:
 
 protected:
     virtual std::optional<RobotInstant> eval(RJ::Seconds t) const override;
+
+private:
+    /// Returns the index of the first waypoint at or after @t, which must be
+    /// after the first waypoint and no later than the last
+    size_t segmentEnd(RJ::Seconds t) const;
+
+    /// Remembers the segment eval() last used, so evaluating a path in order
+    /// doesn't have to search for each segment.  Paths are evaluated by
+    /// several planner threads at once, so it is atomic.  It is only a hint
+    /// and is checked before it is used.
+    struct Cursor {
+        Cursor() = default;
+        Cursor(const Cursor& other) : index(other.load()) {}
+        Cursor& operator=(const Cursor& other) {
+            store(other.load());
+            return *this;
+        }
+
+        size_t load() const { return index.load(std::memory_order_relaxed); }
+        void store(size_t i) { index.store(i, std::memory_order_relaxed); }
+
+        std::atomic<size_t> index{0};
+    };
+
+    mutable Cursor _cursor;
 };
 
 }  // namespace Planning
@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+#include <Geometry2d/Circle.hpp>
+#include <planning/InterpolatedPath.hpp>
+
+#include <cmath>
+
+using namespace Geometry2d;
+
+namespace Planning {
+
+namespace {
+
+/// A path weaving across the field with @count waypoints, 50ms apart, the
+/// spacing the RRT planner produces
+InterpolatedPath makePath(int count) {
+    InterpolatedPath path;
+    for (int i = 0; i < count; i++) {
+        const float y = 9.0f * i / count;
+        const Point pos(std::sin(y) * 2, y);
+        const Point vel(std::cos(y) * 2, 1);
+        path.waypoints.emplace_back(Pose(pos, 0), Twist(vel, 0),
+                                    RJ::Seconds(0.05 * i));
+    }
+    return path;
+}
+
+}  // namespace
+
+// Evaluates at times spread over the whole path, in order, like the motion
+// controller and the path drawing code do
+static void BM_InterpolatedPathEvaluate(benchmark::State& state) {
+    const InterpolatedPath path = makePath(state.range(0));
+    const RJ::Seconds duration = path.getDuration();
+    constexpr int Steps = 256;
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(path.evaluate(duration * (i++ % Steps) / Steps));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InterpolatedPathEvaluate)
+    ->ArgName("waypoints")
+    ->Arg(10)
+    ->Arg(50)
+    ->Arg(200);
+
+static void BM_InterpolatedPathHit(benchmark::State& state) {
+    const InterpolatedPath path = makePath(state.range(0));
+
+    // Obstacles near, but not on, the path so the whole path is checked
+    ShapeSet obstacles;
+    for (int i = 0; i < 12; i++) {
+        obstacles.add(
+            std::make_shared<Circle>(Point(-2.8f, 0.75f * i), Robot_Radius));
+    }
+    obstacles.buildIndex();
+
+    RJ::Seconds hitTime;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(path.hit(obstacles, 0s, &hitTime));
+    }
+}
+BENCHMARK(BM_InterpolatedPathHit)
+    ->ArgName("waypoints")
+    ->Arg(10)
+    ->Arg(50)
+    ->Arg(200);
+
+// Checks a path against the paths of five other robots that never come close,
+// as the multi-robot planner does for each robot
+static void BM_InterpolatedPathPathsIntersect(benchmark::State& state) {
+    const InterpolatedPath path = makePath(state.range(0));
+
+    std::vector<std::unique_ptr<InterpolatedPath>> others;
+    std::vector<DynamicObstacle> obstacles;
+    for (int i = 0; i < 5; i++) {
+        auto other =
+            std::make_unique<InterpolatedPath>(makePath(state.range(0)));
+        for (auto& entry : other->waypoints) {
+            entry.pose = Pose(entry.pose.position() + Point(0.5f * (i + 1), 0),
+                              0);
+        }
+        other->setStartTime(path.startTime());
+        obstacles.emplace_back(other.get(), Robot_Radius);
+        others.push_back(std::move(other));
+    }
+
+    Point hitLocation;
+    RJ::Seconds hitTime;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(path.pathsIntersect(
+            obstacles, path.startTime(), &hitLocation, &hitTime));
+    }
+}
+BENCHMARK(BM_InterpolatedPathPathsIntersect)
+    ->ArgName("waypoints")
+    ->Arg(10)
+    ->Arg(50)
+    ->Arg(200);
+
+}  // namespace Planning
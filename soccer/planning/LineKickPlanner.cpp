@@ -62,8 +62,7 @@ std::unique_ptr<Path> LineKickPlanner::run(PlanRequest& planRequest) {
 
     auto ballObstacles = obstacles;
     const RJ::Time curTime = RJ::now();
-    ballObstacles.add(
-        make_shared<Circle>(ball.predict(curTime).pos, ballAvoidDistance));
+    ballObstacles.add(Circle(ball.predict(curTime).pos, ballAvoidDistance));
     unique_ptr<Path> prevPath;
     if (prevAnglePath && prevAnglePath->path) {
         prevPath = std::move(prevAnglePath->path);
@@ -1,10 +1,16 @@
 #include "Path.hpp"
+#include "InterpolatedPath.hpp"
 #include <protobuf/LogFrame.pb.h>
 #include "DebugDrawer.hpp"
 #include "DynamicObstacle.hpp"
 #include "Geometry2d/ShapeSet.hpp"
 #include "SystemState.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
 using namespace std;
 using namespace Geometry2d;
 namespace Planning {
@@ -58,49 +64,285 @@ std::unique_ptr<ConstPathIterator> Path::iterator(RJ::Time startTime,
         std::make_unique<ConstPathIterator>(this, startTime, deltaT));
 }
 
+namespace {
+
+/// Cubic Bezier curve of positions.  The Hermite segments between
+/// InterpolatedPath waypoints are converted to these for collision checking.
+struct Bezier {
+    std::array<Point, 4> p;
+
+    /// Evaluates the curve's blossom, which gives the control points of any
+    /// part of the curve
+    Point blossom(double u1, double u2, double u3) const {
+        const Point q0 = p[0] * (1 - u1) + p[1] * u1;
+        const Point q1 = p[1] * (1 - u1) + p[2] * u1;
+        const Point q2 = p[2] * (1 - u1) + p[3] * u1;
+        const Point r0 = q0 * (1 - u2) + q1 * u2;
+        const Point r1 = q1 * (1 - u2) + q2 * u2;
+        return r0 * (1 - u3) + r1 * u3;
+    }
+
+    Point at(double s) const { return blossom(s, s, s); }
+
+    /// Returns the part of the curve from @s0 to @s1 as a curve over [0, 1]
+    Bezier sub(double s0, double s1) const {
+        return {{blossom(s0, s0, s0), blossom(s0, s0, s1),
+                 blossom(s0, s1, s1), blossom(s1, s1, s1)}};
+    }
+
+    Bezier operator-(const Bezier& other) const {
+        return {{p[0] - other.p[0], p[1] - other.p[1], p[2] - other.p[2],
+                 p[3] - other.p[3]}};
+    }
+};
+
+/// Box around the control points of a curve, which contains the curve
+struct Box {
+    explicit Box(const Bezier& curve)
+        : minX(curve.p[0].x()),
+          maxX(minX),
+          minY(curve.p[0].y()),
+          maxY(minY) {
+        for (const Point& pt : curve.p) {
+            minX = std::min(minX, pt.x());
+            maxX = std::max(maxX, pt.x());
+            minY = std::min(minY, pt.y());
+            maxY = std::max(maxY, pt.y());
+        }
+    }
+
+    /// Returns true if the boxes are within @distance of each other
+    bool near(const Box& other, double distance) const {
+        return minX - distance < other.maxX && other.minX < maxX + distance &&
+               minY - distance < other.maxY && other.minY < maxY + distance;
+    }
+
+    /// Lower bound on the distance from the origin to the curve
+    double distanceFromOrigin() const {
+        return std::hypot(std::max({minX, -maxX, 0.0}),
+                          std::max({minY, -maxY, 0.0}));
+    }
+
+    double minX;
+    double maxX;
+    double minY;
+    double maxY;
+};
+
+/// The curve a path follows from time @start to @end, in seconds into the path
+/// being checked
+struct Piece {
+    Piece(double start, double end, const Bezier& curve)
+        : start(start), end(end), curve(curve), box(curve) {}
+
+    double start;
+    double end;
+    Bezier curve;
+    Box box;
+
+    /// Returns the curve from @t0 to @t1, which must be within the piece
+    Bezier sub(double t0, double t1) const {
+        if (end - start <= 0 || !std::isfinite(end - start)) {
+            return curve;
+        }
+        return curve.sub((t0 - start) / (end - start),
+                         (t1 - start) / (end - start));
+    }
+};
+
+/// Sets @pieces to the pieces of @path on a time axis where @path starts at
+/// @offset and is evaluated @rate times faster than real time.  The path stays
+/// at its first and last waypoints before and after it, like
+/// ConstPathIterator does.
+void pathPieces(const InterpolatedPath& path, double offset, double rate,
+                vector<Piece>* pieces) {
+    const auto& waypoints = path.waypoints;
+    const double inf = std::numeric_limits<double>::infinity();
+    auto stay = [](Point pos) { return Bezier{{pos, pos, pos, pos}}; };
+    auto timeOf = [&](size_t i) {
+        return RJ::numSeconds(waypoints[i].time) / rate + offset;
+    };
+
+    pieces->clear();
+    pieces->emplace_back(-inf, timeOf(0),
+                         stay(waypoints.front().pose.position()));
+    for (size_t i = 0; i + 1 < waypoints.size(); ++i) {
+        const auto& prev = waypoints[i];
+        const auto& next = waypoints[i + 1];
+        const double dt = RJ::numSeconds(next.time - prev.time);
+        if (dt <= 0) {
+            continue;
+        }
+
+        // Hermite to Bezier, with the tangents scaled to the segment like
+        // InterpolatedPath::eval() does
+        const Point p0 = prev.pose.position();
+        const Point p1 = next.pose.position();
+        pieces->emplace_back(timeOf(i), timeOf(i + 1),
+                             Bezier{{p0, p0 + prev.vel.linear() * (dt / 3),
+                                     p1 - next.vel.linear() * (dt / 3), p1}});
+    }
+    pieces->emplace_back(timeOf(waypoints.size() - 1), inf,
+                         stay(waypoints.back().pose.position()));
+}
+
+/**
+ * Finds the first time in [@t0, @t1] when the curve @d, which is the distance
+ * between two paths over that interval, comes within @radius of zero.
+ *
+ * The interval is split in half until the control points of @d show that it
+ * stays out of @radius or the interval is shorter than the resolution.
+ */
+bool firstApproach(const Bezier& d, double t0, double t1, double radius,
+                   double* hitTime) {
+    constexpr double Resolution = 1e-3;
+
+    if (Box(d).distanceFromOrigin() >= radius) {
+        return false;
+    }
+
+    if (d.p[0].magsq() < radius * radius || t1 - t0 < Resolution) {
+        *hitTime = t0;
+        return true;
+    }
+
+    const double mid = (t0 + t1) / 2;
+    return firstApproach(d.sub(0, 0.5), t0, mid, radius, hitTime) ||
+           firstApproach(d.sub(0.5, 1), mid, t1, radius, hitTime);
+}
+
+/// Finds the first time in [@start, @end] when @a and @b come within @radius
+/// of each other
+bool firstApproach(const vector<Piece>& a, const vector<Piece>& b,
+                   double start, double end, double radius, double* hitTime,
+                   Point* hitLocation) {
+    // Walk both paths together, one interval between consecutive piece
+    // boundaries at a time
+    size_t i = 0;
+    size_t j = 0;
+    double t0 = start;
+    while (t0 < end) {
+        while (a[i].end <= t0) {
+            i++;
+        }
+        while (b[j].end <= t0) {
+            j++;
+        }
+        const double t1 = std::min({a[i].end, b[j].end, end});
+
+        // Whole pieces whose boxes are far apart can't come close
+        if (a[i].box.near(b[j].box, radius)) {
+            const Bezier curveB = b[j].sub(t0, t1);
+            if (firstApproach(a[i].sub(t0, t1) - curveB, t0, t1, radius,
+                              hitTime)) {
+                if (hitLocation) {
+                    *hitLocation = curveB.at((*hitTime - t0) / (t1 - t0));
+                }
+                return true;
+            }
+        }
+
+        t0 = t1;
+    }
+    return false;
+}
+
+}  // namespace
+
+const InterpolatedPath* Path::positionPath(const Path* path, double* rate) {
+    *rate = 1;
+    while (const auto* anglePath =
+               dynamic_cast<const AngleFunctionPath*>(path)) {
+        *rate *= path->evalRate;
+        path = anglePath->path.get();
+    }
+
+    const auto* interpolated = dynamic_cast<const InterpolatedPath*>(path);
+    if (!interpolated || interpolated->waypoints.empty()) {
+        return nullptr;
+    }
+    *rate *= path->evalRate;
+    return interpolated;
+}
+
 bool Path::pathsIntersect(const std::vector<DynamicObstacle>& obstacles,
                           RJ::Time startTime, Geometry2d::Point* hitLocation,
                           RJ::Seconds* hitTime) const {
     const RJ::Seconds deltaT = RJ::Seconds(0.05);
+    const RJ::Seconds start = startTime - this->startTime();
+
+    // Paths made of waypoints are checked exactly.  Other paths are sampled
+    // every deltaT.
+    double rate;
+    const InterpolatedPath* interpolated = positionPath(this, &rate);
+    vector<Piece> pieces;
+    vector<Piece> obsPieces;
+    if (interpolated) {
+        pathPieces(*interpolated, 0, rate, &pieces);
+    }
+
+    // The earliest hit of any obstacle
+    bool hitAny = false;
+    RJ::Seconds firstHitTime = getDuration();
+    Point firstHitLocation;
 
-    auto thisPathIterator = iterator(startTime, deltaT);
-    vector<std::pair<unique_ptr<ConstPathIterator>, float>> pathIterators;
     for (const auto& obs : obstacles) {
-        if (obs.hasPath()) {
-            pathIterators.emplace_back(
-                obs.getPath()->iterator(startTime, deltaT), obs.getRadius());
-        } else {
+        if (!obs.hasPath()) {
             ShapeSet set;
             set.add(obs.getStaticObstacle());
-            if (hit(set, startTime - this->startTime(), hitTime)) {
+            if (hit(set, start, hitTime)) {
                 return true;
             }
+            continue;
         }
-    }
 
-    RJ::Seconds time = startTime - this->startTime();
-    for (; time < getDuration(); time += deltaT) {
-        auto current = **thisPathIterator;
-        for (auto& pair : pathIterators) {
-            auto& it = pair.first;
-            assert(it != nullptr);
-            auto hitRadius = pair.second + Robot_Radius;
-            auto robotInstant = (**it);
-            if (current.motion.pos.distTo(robotInstant.motion.pos) <
-                hitRadius) {
-                if (hitTime) {
-                    *hitTime = time;
-                }
-                if (hitLocation) {
-                    *hitLocation = std::move(robotInstant.motion.pos);
-                }
-                return true;
+        const Path* path = obs.getPath();
+        const auto hitRadius = obs.getRadius() + Robot_Radius;
+
+        double obsRate;
+        const InterpolatedPath* obsInterpolated = positionPath(path, &obsRate);
+        if (interpolated && obsInterpolated) {
+            pathPieces(*obsInterpolated,
+                       RJ::numSeconds(path->startTime() - this->startTime()),
+                       obsRate, &obsPieces);
+
+            double t;
+            Point location;
+            if (firstApproach(pieces, obsPieces, RJ::numSeconds(start),
+                              RJ::numSeconds(firstHitTime), hitRadius, &t,
+                              &location)) {
+                hitAny = true;
+                firstHitTime = RJ::Seconds(t);
+                firstHitLocation = location;
             }
-            it->operator++();
+            continue;
+        }
+
+        auto thisPathIterator = iterator(startTime, deltaT);
+        auto it = path->iterator(startTime, deltaT);
+        for (RJ::Seconds time = start; time < firstHitTime; time += deltaT) {
+            const auto robotInstant = **it;
+            if ((**thisPathIterator).motion.pos.distTo(
+                    robotInstant.motion.pos) < hitRadius) {
+                hitAny = true;
+                firstHitTime = time;
+                firstHitLocation = robotInstant.motion.pos;
+                break;
+            }
+            ++*it;
+            ++*thisPathIterator;
         }
-        thisPathIterator->operator++();
     }
-    return false;
+
+    if (hitAny) {
+        if (hitTime) {
+            *hitTime = firstHitTime;
+        }
+        if (hitLocation) {
+            *hitLocation = firstHitLocation;
+        }
+    }
+    return hitAny;
 }
 
 void Path::slow(float multiplier, RJ::Seconds timeInto) {
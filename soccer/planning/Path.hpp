@@ -17,6 +17,7 @@ class SystemState;
 namespace Planning {
 
 class ConstPathIterator;
+class InterpolatedPath;
 /**
  * @brief Abstract class representing a motion path
  */
@@ -130,6 +131,12 @@ public:
 protected:
     virtual std::optional<RobotInstant> eval(RJ::Seconds t) const = 0;
 
+    /// Returns the InterpolatedPath that determines where @path goes and sets
+    /// @rate to how much faster than real time it is evaluated, or returns
+    /// null if there isn't one
+    static const InterpolatedPath* positionPath(const Path* path,
+                                                double* rate);
+
     double evalRate = 1.0;
     RJ::Time _startTime;
     std::optional<QString> _debugText;
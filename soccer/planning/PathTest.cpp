@@ -89,6 +89,46 @@ TEST(InterpolatedPath, evaluate) {
     ASSERT_FALSE(out);
 }
 
+// Evaluating out of order must give exactly the same results as evaluating
+// in order, which is what the segment lookup is optimized for
+TEST(InterpolatedPath, evaluateOrder) {
+    InterpolatedPath path;
+    for (int i = 0; i < 100; i++) {
+        path.waypoints.emplace_back(Pose(Point(i % 7, i * 0.1), 0),
+                                    Twist(Point(1, i % 3), 0),
+                                    RJ::Seconds(0.05 * i));
+    }
+
+    vector<RJ::Seconds> times;
+    for (RJ::Seconds t = 0s; t <= path.getDuration(); t += 7ms) {
+        times.push_back(t);
+    }
+    // Exactly on waypoints
+    times.push_back(RJ::Seconds(0.05 * 10));
+    times.push_back(RJ::Seconds(0.05 * 99));
+
+    vector<RobotInstant> inOrder;
+    for (RJ::Seconds t : times) {
+        auto pt = path.evaluate(t);
+        ASSERT_TRUE(pt);
+        inOrder.push_back(*pt);
+    }
+
+    auto expectSame = [&](size_t i) {
+        auto pt = path.evaluate(times[i]);
+        ASSERT_TRUE(pt);
+        EXPECT_EQ(pt->motion.pos, inOrder[i].motion.pos);
+        EXPECT_EQ(pt->motion.vel, inOrder[i].motion.vel);
+    };
+
+    for (size_t i = times.size(); i-- > 0;) {
+        expectSame(i);
+    }
+    for (size_t i = 0; i < times.size(); i++) {
+        expectSame((i * 37) % times.size());
+    }
+}
+
 TEST(InterpolatedPath, subPath1) {
     InterpolatedPath path;
     path.waypoints.emplace_back(Pose(1, 1, 0), Twist(0, 0, 0), 0s);
@@ -169,6 +209,71 @@ TEST(InterpolatedPath, subpath2) {
     }
 }
 
+// Two robots crossing fast enough that checking every 50ms would miss them
+TEST(Path, pathsIntersectFastCrossing) {
+    const RJ::Time start = RJ::now();
+
+    InterpolatedPath path;
+    path.waypoints.emplace_back(Pose(-4, 0, 0), Twist(8, 0, 0), 0s);
+    path.waypoints.emplace_back(Pose(4, 0, 0), Twist(8, 0, 0), 1s);
+    path.setStartTime(start);
+
+    InterpolatedPath other;
+    other.waypoints.emplace_back(Pose(0, -4, 0), Twist(0, 8, 0), 0s);
+    other.waypoints.emplace_back(Pose(0, 4, 0), Twist(0, 8, 0), 1s);
+    other.setStartTime(start + 25ms);
+
+    RJ::Seconds hitTime;
+    Point hitLocation;
+    ASSERT_TRUE(path.pathsIntersect({DynamicObstacle(&other, Robot_Radius)},
+                                    start, &hitLocation, &hitTime));
+
+    // The closest approach is 0.14m apart at 0.5125s
+    EXPECT_GT(hitTime, 0.48s);
+    EXPECT_LT(hitTime, 0.5125s);
+    EXPECT_LT(path.evaluate(hitTime)->motion.pos.distTo(hitLocation),
+              2 * Robot_Radius + 0.01);
+    EXPECT_NEAR(hitLocation.y(), 8 * (RJ::numSeconds(hitTime) - 0.525), 0.01);
+
+    // 200ms later they miss each other
+    other.setStartTime(start + 200ms);
+    EXPECT_FALSE(path.pathsIntersect(
+        {DynamicObstacle(&other, Robot_Radius)}, start, nullptr, nullptr));
+}
+
+// The first hit between curved paths should match dense sampling
+TEST(Path, pathsIntersectCurved) {
+    const RJ::Time start = RJ::now();
+
+    InterpolatedPath path;
+    path.waypoints.emplace_back(Pose(0, 0, 0), Twist(0, 2, 0), 0s);
+    path.waypoints.emplace_back(Pose(1, 2, 0), Twist(2, 0, 0), 1s);
+    path.waypoints.emplace_back(Pose(3, 2, 0), Twist(0, -1, 0), 2s);
+    path.setStartTime(start);
+
+    InterpolatedPath other;
+    other.waypoints.emplace_back(Pose(2, 0, 0), Twist(-1, 1, 0), 0s);
+    other.waypoints.emplace_back(Pose(0.5, 2.5, 0), Twist(-1, 0, 0), 1.5s);
+    other.setStartTime(start + 100ms);
+
+    RJ::Seconds hitTime;
+    ASSERT_TRUE(path.pathsIntersect({DynamicObstacle(&other, Robot_Radius)},
+                                    start, nullptr, &hitTime));
+
+    RJ::Seconds sampled = -1s;
+    for (RJ::Seconds t = 0s; t < path.getDuration(); t += 0.1ms) {
+        auto a = path.evaluate(t);
+        auto b = other.evaluate(t - 100ms);
+        const Point otherPos = b ? b->motion.pos : other.end().motion.pos;
+        if (a->motion.pos.distTo(otherPos) < 2 * Robot_Radius) {
+            sampled = t;
+            break;
+        }
+    }
+    ASSERT_GE(sampled, 0s);
+    EXPECT_NEAR(RJ::numSeconds(hitTime), RJ::numSeconds(sampled), 2e-3);
+}
+
 TEST(CompositePath, CompositeSubPath) {
     // Create a test path
     InterpolatedPath path;
@@ -32,7 +32,8 @@ struct PlanRequest {
           prevPath(std::move(prevPath)),
           obstacles(obs),
           dynamicObstacles(dObs),
-          shellID(shellID) {}
+          shellID(shellID),
+          priority(priority) {}
 
     Context* context;         /**< Allows debug drawing, position info */
     MotionInstant start;      /**< Starting state of the robot */
@@ -125,6 +125,10 @@ std::unique_ptr<Path> RRTPlanner::run(PlanRequest& planRequest) {
     vector<DynamicObstacle> actualDynamic;
     splitDynamic(obstacles, actualDynamic, dynamicObstacles);
 
+    // Every collision check below (and every RRT iteration) queries this set,
+    // so bucket it once up front
+    obstacles.buildIndex();
+
     // Simple case: no path
     if (start.pos == goal.pos) {
         auto path = make_unique<InterpolatedPath>();
@@ -139,7 +143,7 @@ std::unique_ptr<Path> RRTPlanner::run(PlanRequest& planRequest) {
     std::optional<Point> prevGoal;
     if (prevPath) prevGoal = prevPath->end().motion.pos;
     goal.pos = EscapeObstaclesPathPlanner::findNonBlockedGoal(
-        goal.pos, prevGoal, obstacles);
+        goal.pos, prevGoal, obstacles, _random);
 
     string debugOut;
 
@@ -294,6 +298,11 @@ std::unique_ptr<InterpolatedPath> RRTPlanner::generateRRTPath(
     ShapeSet obstacles = origional;
     unique_ptr<InterpolatedPath> lastPath;
     for (int i = 0; i < tries; i++) {
+        // Adding a dynamic obstacle hit below drops the index
+        if (!obstacles.hasIndex()) {
+            obstacles.buildIndex();
+        }
+
         // Run bi-directional RRT to generate a path.
         auto points = runRRT(start, goal, motionConstraints, obstacles, context,
                              shellID, biasWayPoints);
@@ -318,8 +327,7 @@ std::unique_ptr<InterpolatedPath> RRTPlanner::generateRRTPath(
         bool hit = path->pathsIntersect(dyObs, path->startTime(), &hitLocation,
                                         &hitTime);
         if (hit) {
-            obstacles.add(
-                make_shared<Circle>(hitLocation, Robot_Radius * 1.5f));
+            obstacles.add(Circle(hitLocation, Robot_Radius * 1.5f));
             lastPath = std::move(path);
         } else {
             return std::move(path);
@@ -352,7 +360,7 @@ vector<Point> RRTPlanner::runRRTHelper(
     // Initialize bi-directional RRT
 
     auto stateSpace = make_shared<RoboCupStateSpace>(
-        Field_Dimensions::Current_Dimensions, obstacles);
+        Field_Dimensions::Current_Dimensions, obstacles, _random);
     RRT::BiRRT<Point> biRRT(stateSpace, Point::hash, 2);
     reusePathTries++;
     biRRT.setStartState(start.pos);
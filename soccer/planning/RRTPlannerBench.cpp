@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include <Context.hpp>
+#include <Geometry2d/Circle.hpp>
+#include <Geometry2d/Rect.hpp>
+#include "RRTPlanner.hpp"
+
+#include <random>
+
+using namespace Geometry2d;
+
+namespace Planning {
+
+namespace {
+
+/// Opponent-sized circles spread between the start and goal, plus both goal
+/// zones, like the obstacles a robot crossing the field has to avoid
+ShapeSet makeObstacleField(int count) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> x(-2.5f, 2.5f);
+    std::uniform_real_distribution<float> y(2.0f, 7.0f);
+
+    ShapeSet obstacles;
+    for (int i = 0; i < count; i++) {
+        obstacles.add(
+            std::make_shared<Circle>(Point(x(rng), y(rng)), Robot_Radius * 2));
+    }
+    obstacles.add(std::make_shared<Rect>(
+        Field_Dimensions::Current_Dimensions.OurGoalZoneShape()));
+    obstacles.add(std::make_shared<Rect>(
+        Field_Dimensions::Current_Dimensions.TheirGoalZoneShape()));
+    return obstacles;
+}
+
+}  // namespace
+
+// Plans from scratch across the field each iteration (no previous path to
+// reuse), with an increasing number of obstacles in the way
+static void BM_RRTPlannerRun(benchmark::State& state) {
+    Context context;
+    RRTPlanner planner(100, 250);
+    const ShapeSet obstacles = makeObstacleField(state.range(0));
+
+    // Same seed every run for repeatable trees
+    planner.seedRandom(0);
+    for (auto _ : state) {
+        PlanRequest request(
+            &context, MotionInstant(Point(0, 1), Point(0, 0)),
+            std::make_unique<PathTargetCommand>(MotionInstant(Point(0, 8))),
+            RobotConstraints(), nullptr, obstacles, {}, 0);
+        benchmark::DoNotOptimize(planner.run(request));
+    }
+}
+BENCHMARK(BM_RRTPlannerRun)
+    ->ArgName("obstacles")
+    ->Arg(0)
+    ->Arg(6)
+    ->Arg(12)
+    ->Arg(24)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace Planning
@@ -3,20 +3,26 @@
 #include <Geometry2d/Point.hpp>
 #include <rrt/2dplane/PlaneStateSpace.hpp>
 
+#include <random>
+
 namespace Planning {
 
 /**
  * Represents the robocup field for path-planning purposes.
+ *
+ * Random states are drawn from @random, which must outlive the state space.
  */
 class RoboCupStateSpace : public RRT::StateSpace<Geometry2d::Point> {
 public:
     RoboCupStateSpace(const Field_Dimensions& dims,
-                      const Geometry2d::ShapeSet& obstacles)
-        : _fieldDimensions(dims), _obstacles(obstacles) {}
+                      const Geometry2d::ShapeSet& obstacles,
+                      std::mt19937& random)
+        : _fieldDimensions(dims), _obstacles(obstacles), _random(random) {}
 
     Geometry2d::Point randomState() const {
-        double x = _fieldDimensions.FloorWidth() * (drand48() - 0.5f);
-        double y = _fieldDimensions.FloorLength() * drand48() -
+        std::uniform_real_distribution<double> unit(0, 1);
+        double x = _fieldDimensions.FloorWidth() * (unit(_random) - 0.5f);
+        double y = _fieldDimensions.FloorLength() * unit(_random) -
                    _fieldDimensions.Border();
         return Geometry2d::Point(x, y);
     }
@@ -53,16 +59,17 @@ public:
         // Ensure that @to doesn't hit any obstacles that @from doesn't. This
         // allows the RRT to start inside an obstacle, but prevents it from
         // entering a new obstacle.
-        for (const auto& shape : _obstacles.shapes()) {
-            if (shape->hit(Geometry2d::Segment(from, to)) && !shape->hit(from))
-                return false;
-        }
-        return true;
+        const Geometry2d::Segment segment(from, to);
+        return !_obstacles.anyCandidate(
+            segment, [&](const Geometry2d::Shape& shape) {
+                return shape.hit(segment) && !shape.hit(from);
+            });
     }
 
 private:
     const Geometry2d::ShapeSet& _obstacles;
     const Field_Dimensions _fieldDimensions;
+    std::mt19937& _random;
 };
 
 }  // namespace Planning
@@ -77,8 +77,7 @@ std::unique_ptr<Path> SettlePathPlanner::run(PlanRequest& planRequest) {
 
     // Obstacle list with circle around ball
     ShapeSet obstaclesWBall = obstacles;
-    obstaclesWBall.add(
-        make_shared<Circle>(ball.pos, Robot_Radius + Ball_Radius));
+    obstaclesWBall.add(Circle(ball.pos, Robot_Radius + Ball_Radius));
 
     // Previous RRT path from last iteration
     std::unique_ptr<Path>& prevPath = planRequest.prevPath;
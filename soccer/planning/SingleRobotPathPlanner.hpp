@@ -1,6 +1,7 @@
 #pragma once
 
 #include <optional>
+#include <random>
 
 #include <Configuration.hpp>
 #include <planning/MotionCommand.hpp>
@@ -64,10 +65,17 @@ public:
 
     virtual bool canHandleDynamic() { return handlesDynamic; }
 
+    /// Seeds the random number generator used by this planner's RRTs
+    void seedRandom(unsigned seed) { _random.seed(seed); }
+
 protected:
     SingleRobotPathPlanner(bool handlesDynamic)
         : handlesDynamic(handlesDynamic) {}
 
+    /// Each planner has its own generator so that robots can be planned in
+    /// parallel, and so each robot's plans only depend on its own seed
+    std::mt19937 _random;
+
 private:
     static ConfigDouble* _goalPosChangeThreshold;
     static ConfigDouble* _goalVelChangeThreshold;
@@ -1,5 +1,6 @@
 #include "TrapezoidalPath.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 using namespace Geometry2d;
@@ -42,17 +43,18 @@ std::optional<RobotInstant> TrapezoidalPath::eval(RJ::Seconds time) const {
 
 bool TrapezoidalPath::hit(const Geometry2d::ShapeSet& obstacles,
                           RJ::Seconds initialTime, RJ::Seconds* hitTime) const {
-    std::set<std::shared_ptr<Shape>> startHitSet = obstacles.hitSet(_startPos);
+    const std::vector<uint32_t> startHitSet = obstacles.hitSet(_startPos);
     for (RJ::Seconds t = initialTime; t < _duration; t += RJ::Seconds(0.1)) {
         auto instant = evaluate(t);
         if (instant) {
-            for (auto& shape : obstacles.shapes()) {
+            for (uint32_t id = 0; id < obstacles.size(); id++) {
                 // If the shape is in the original hitSet, it is ignored
-                if (startHitSet.find(shape) != startHitSet.end()) {
+                if (std::binary_search(startHitSet.begin(), startHitSet.end(),
+                                       id)) {
                     continue;
                 }
 
-                if (shape->hit(instant->motion.pos)) {
+                if (obstacles.hit(id, instant->motion.pos)) {
                     if (hitTime) {
                         *hitTime = t;
                     }
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Radio.hpp"
+
+/**
+ * @brief A radio that drops everything sent to it and never receives anything
+ *
+ * @details Used when replaying a log, where there are no robots to talk to.
+ */
+class NullRadio : public Radio {
+public:
+    virtual bool isOpen() const override { return true; }
+    virtual void send(Packet::RadioTx& radioTx) override {}
+    virtual void receive() override {}
+    virtual void switchTeam(bool blueTeam) override {}
+};
@@ -1,6 +1,7 @@
 #include "MainWindow.hpp"
 #include <Network.hpp>
 #include <Robot.hpp>
+#include <Trace.hpp>
 #include <Utils.hpp>
 #include <gameplay/GameplayModule.hpp>
 #include <joystick/GamepadController.hpp>
@@ -58,6 +59,7 @@ MainWindow::MainWindow(Processor* processor, QWidget* parent)
       _longHistory(10000),
       _processor(processor) {
     qRegisterMetaType<QVector<int>>("QVector<int>");
+    Trace::setThreadName("GUI");
     _ui.setupUi(this);
     _ui.fieldView->history(&_history);
 
@@ -300,6 +302,7 @@ void MainWindow::updateFromRefPacket(bool haveExternalReferee) {
 }
 
 void MainWindow::updateViews() {
+    TRACE_SCOPE("MainWindow::updateViews");
     int manual = _processor->manualID();
     if ((manual >= 0 || _ui.manualID->isEnabled()) &&
         !_processor->joystickValid()) {
@@ -364,11 +367,12 @@ void MainWindow::updateViews() {
 
         // TODO: Use constants here instead of magic numbers
         _logMemory->setText(
-            QString("Log: %1/%2 %3 kiB")
+            QString("Log: %1/%2 %3 kiB %4 dropped")
                 .arg(QString::number(_processor->logger().size()),
                      QString::number(_processor->logger().capacity()),
                      QString::number((_processor->logger().spaceUsed() + 512) /
-                                     1024)));
+                                     1024),
+                     QString::number(_processor->logger().droppedFrames())));
     }
 
     auto value = _ui.logHistoryLocation->value();
@@ -503,6 +507,12 @@ void MainWindow::updateViews() {
         if (_ui.behaviorTree->toPlainText() != behaviorStr) {
             _ui.behaviorTree->setPlainText(behaviorStr);
         }
+
+        // Only fill in the timing breakdown while it can be seen
+        if (_ui.tabWidget->currentWidget() == _ui.timingTab) {
+            updateTiming(currentFrame->timing());
+            updateVisionLatency();
+        }
     }
 
     _ui.refStage->setText(NewRefereeModuleEnums::stringFromStage(
@@ -790,6 +800,62 @@ void MainWindow::updateViews() {
     updateTimer.start(20);
 }
 
+void MainWindow::updateTiming(const Packet::LogFrame::Timing& timing) {
+    // One row per stage, then the total
+    const int rows = timing.stages_size() + (timing.has_total() ? 1 : 0);
+    while (_ui.stageTiming->topLevelItemCount() > rows) {
+        delete _ui.stageTiming->takeTopLevelItem(rows);
+    }
+    while (_ui.stageTiming->topLevelItemCount() < rows) {
+        _ui.stageTiming->addTopLevelItem(new QTreeWidgetItem());
+    }
+
+    for (int i = 0; i < rows; i++) {
+        const LogFrame::StageTiming& stage =
+            i < timing.stages_size() ? timing.stages(i) : timing.total();
+        const uint64_t values[] = {stage.last(), stage.min(), stage.mean(),
+                                   stage.p99(), stage.max()};
+
+        QTreeWidgetItem* item = _ui.stageTiming->topLevelItem(i);
+        item->setText(0, QString::fromStdString(stage.stage()));
+        for (int col = 0; col < 5; col++) {
+            item->setText(col + 1,
+                          QString::number(values[col] / 1000.0, 'f', 2));
+            item->setTextAlignment(col + 1, Qt::AlignRight | Qt::AlignVCenter);
+        }
+    }
+}
+
+void MainWindow::updateVisionLatency() {
+    const Processor::VisionLatency& latency = _processor->visionLatency();
+    const std::pair<const char*, const LatencyHistogram*> rows[] = {
+        {"Capture to receive", &latency.captureToReceive},
+        {"Receive to filter", &latency.receiveToFilter},
+        {"Filter to command", &latency.filterToCommand},
+        {"Total", &latency.total}};
+
+    while (_ui.visionLatency->topLevelItemCount() < 4) {
+        _ui.visionLatency->addTopLevelItem(new QTreeWidgetItem());
+    }
+
+    for (int i = 0; i < 4; i++) {
+        const LatencyHistogram& histogram = *rows[i].second;
+        const int64_t values[] = {
+            histogram.percentile(50), histogram.percentile(90),
+            histogram.percentile(99), histogram.max()};
+
+        QTreeWidgetItem* item = _ui.visionLatency->topLevelItem(i);
+        item->setText(0, rows[i].first);
+        item->setText(1, QString::number(histogram.count()));
+        item->setTextAlignment(1, Qt::AlignRight | Qt::AlignVCenter);
+        for (int col = 0; col < 4; col++) {
+            item->setText(col + 2,
+                          QString::number(values[col] / 1000.0, 'f', 2));
+            item->setTextAlignment(col + 2, Qt::AlignRight | Qt::AlignVCenter);
+        }
+    }
+}
+
 void MainWindow::updateStatus() {
     // Guidelines:
     //    Status_Fail is used for severe, usually external, errors such as
@@ -1257,6 +1323,35 @@ void MainWindow::on_actionStart_Logging_triggered() {
     }
 }
 
+void MainWindow::on_actionSave_Vision_Latency_triggered() {
+    if (!QDir("logs").exists()) {
+        QDir().mkdir("logs");
+    }
+
+    QString latencyFile =
+        QString("logs/") +
+        QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss.latency.csv");
+
+    if (_processor->saveVisionLatency(latencyFile.toStdString())) {
+        printf("Saved vision latency to %s\n",
+               (const char*)latencyFile.toLatin1());
+    }
+}
+
+void MainWindow::on_actionSave_Trace_triggered() {
+    if (!QDir("logs").exists()) {
+        QDir().mkdir("logs");
+    }
+
+    QString traceFile =
+        QString("logs/") +
+        QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss.trace.json");
+
+    if (Trace::writeJson(traceFile.toStdString())) {
+        printf("Saved trace to %s\n", (const char*)traceFile.toLatin1());
+    }
+}
+
 // Gameplay commands
 
 void MainWindow::on_actionSeed_triggered() {
@@ -1350,7 +1445,7 @@ void MainWindow::on_actionUse_Field_Oriented_Controls_toggled(bool value) {
 
 void MainWindow::on_actionUse_Multiple_Joysticks_toggled(bool value) {
     _processor->multipleManual(value);
-    _processor->setupJoysticks();
+    _processor->setJoysticks(GamepadController::createControllers());
 }
 
 void MainWindow::on_goalieID_currentIndexChanged(int value) {
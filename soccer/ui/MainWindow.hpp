@@ -141,6 +141,8 @@ private Q_SLOTS:
     /// Debug menu commands
     void on_actionRestartUpdateTimer_triggered();
     void on_actionStart_Logging_triggered();
+    void on_actionSave_Trace_triggered();
+    void on_actionSave_Vision_Latency_triggered();
 
     /// Gameplay menu
     void on_actionSeed_triggered();
@@ -192,6 +194,8 @@ Q_SIGNALS:
 
 private:
     void updateStatus();
+    void updateTiming(const Packet::LogFrame::Timing& timing);
+    void updateVisionLatency();
     void updateFromRefPacket(bool haveExternalReferee);
     static std::string formatLabelBold(Side side, std::string label);
 
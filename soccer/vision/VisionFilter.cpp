@@ -1,118 +1,233 @@
 #include "VisionFilter.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include <Constants.hpp>
 #include <Robot.hpp>
+#include <Trace.hpp>
 
 #include "vision/util/VisionFilterConfig.hpp"
 
-VisionFilter::VisionFilter() {
+VisionFilter::VisionFilter(bool threaded)
+    : lastTick(RJ::now()), frameQueue(FrameQueueCapacity) {
     threadEnd.store(false, std::memory_order::memory_order_seq_cst);
-    
+
     // Have to be careful so the entire initialization list
     // is created before the thread starts
-    worker = std::thread(&VisionFilter::updateLoop, this);
+    if (threaded) {
+        worker = std::thread(&VisionFilter::updateLoop, this);
+    }
 }
 
 VisionFilter::~VisionFilter() {
     // Signal end of thread
-    threadEnd.store(true, std::memory_order::memory_order_seq_cst);
+    {
+        std::lock_guard<std::mutex> lock(wakeLock);
+        threadEnd.store(true, std::memory_order::memory_order_seq_cst);
+    }
+    wake.notify_one();
 
     // Wait for it to die
-    worker.join();
+    if (worker.joinable()) {
+        worker.join();
+    }
 }
 
-void VisionFilter::addFrames(const std::vector<CameraFrame>& frames) {
-    std::lock_guard<std::mutex> lock(frameLock);
-    frameBuffer.insert(frameBuffer.end(), frames.begin(), frames.end());
+void VisionFilter::addFrames(std::vector<CameraFrame> frames) {
+    for (CameraFrame& frame : frames) {
+        if (!frameQueue.tryPush(std::move(frame))) {
+            std::cout << "WARNING : Vision filter frame queue is full, dropping frame" << std::endl;
+        }
+    }
+
+    if (!worker.joinable()) {
+        const RJ::Time now = RJ::now();
+        if (now - lastTick >= RJ::Seconds(*VisionFilterConfig::vision_loop_dt)) {
+            update(now, true);
+        }
+        return;
+    }
+
+    if (*VisionFilterConfig::event_driven) {
+        // Taking the lock makes sure the worker is either waiting or will see
+        // the new frames before it waits
+        { std::lock_guard<std::mutex> lock(wakeLock); }
+        wake.notify_one();
+    }
 }
 
-void VisionFilter::fillBallState(SystemState& state) {
-    std::lock_guard<std::mutex> lock(worldLock);
-    const WorldBall& wb = world.getWorldBall();
+void VisionFilter::fillStates(SystemState& state, bool usBlue) {
+    // Read once, so the ball and robots come from the same update
+    const Snapshot& snapshot = snapshots.read();
+    filledFrame = snapshot.newestFrame;
 
-    if (wb.getIsValid()) {
+    fillBallState(state, snapshot);
+    fillRobotState(state, snapshot, usBlue);
+}
+
+void VisionFilter::fillBallState(SystemState& state,
+                                 const Snapshot& snapshot) {
+    const Ball& ball = snapshot.ball;
+
+    if (ball.valid) {
         state.ball.valid = true;
-        state.ball.pos = wb.getPos();
-        state.ball.vel = wb.getVel();
-        state.ball.time = wb.getTime();
+        state.ball.pos = ball.pos;
+        state.ball.vel = ball.vel;
+        state.ball.time = ball.time;
+
+        // The worker doesn't predict between frames in event driven mode, so
+        // bring the estimate up to date here
+        if (*VisionFilterConfig::event_driven && state.time > ball.time) {
+            Planning::MotionInstant instant = ball.predict(state.time);
+            state.ball.pos = instant.pos;
+            state.ball.vel = instant.vel;
+            state.ball.time = state.time;
+        }
     } else {
         state.ball.valid = false;
     }
 }
 
-void VisionFilter::fillRobotState(SystemState& state, bool usBlue) {
-    std::lock_guard<std::mutex> lock(worldLock);
-    const auto& ourWorldRobot = usBlue ? world.getRobotsBlue() : world.getRobotsYellow();
-    const auto& oppWorldRobot = usBlue ? world.getRobotsYellow() : world.getRobotsBlue();
+void VisionFilter::fillRobotState(SystemState& state,
+                                  const Snapshot& snapshot, bool usBlue) {    const auto& ourRobots = usBlue ? snapshot.robotsBlue : snapshot.robotsYellow;
+    const auto& oppRobots = usBlue ? snapshot.robotsYellow : snapshot.robotsBlue;
+
+    // See fillBallState
+    const bool extrapolate = *VisionFilterConfig::event_driven;
+    auto robotState = [&](const RobotState& robot) {
+        RobotState robot_state = robot;
+        if (extrapolate && robot.visible && state.time > robot.timestamp) {
+            RJ::Seconds dt = state.time - robot.timestamp;
+            robot_state.pose = robot.pose + robot.velocity.deltaFixed(dt.count());
+            robot_state.timestamp = state.time;
+        }
+        return robot_state;
+    };
 
     // Fill our robots
     for (int i = 0; i < Num_Shells; i++) {
-        OurRobot* robot = state.self.at(i);
-        const WorldRobot& wr = ourWorldRobot.at(i);
-
-        RobotState robot_state;
-        robot_state.visible = wr.getIsValid();
-        robot_state.velocity_valid = wr.getIsValid();
-
-        if (wr.getIsValid()) {
-            robot_state.pose = Geometry2d::Pose(wr.getPos(), wr.getTheta());
-            robot_state.velocity =
-                Geometry2d::Twist(wr.getVel(), wr.getOmega());
-            robot_state.timestamp = wr.getTime();
-        }
-
-        robot->mutable_state() = robot_state;
+        state.self.at(i)->mutable_state() = robotState(ourRobots.at(i));
     }
 
     // Fill opp robots
     for (int i = 0; i < Num_Shells; i++) {
-        OpponentRobot* robot = state.opp.at(i);
-        const WorldRobot& wr = oppWorldRobot.at(i);
-
-        RobotState robot_state;
-        robot_state.visible = wr.getIsValid();
-        robot_state.velocity_valid = wr.getIsValid();
-
-        if (wr.getIsValid()) {
-            robot_state.pose = Geometry2d::Pose(wr.getPos(), wr.getTheta());
-            robot_state.velocity =
-                Geometry2d::Twist(wr.getVel(), wr.getOmega());
-            robot_state.timestamp = wr.getTime();
+        state.opp.at(i)->mutable_state() = robotState(oppRobots.at(i));
+    }
+}
+
+void VisionFilter::publishSnapshot() {
+    Snapshot& snapshot = snapshots.back();
+
+    const WorldBall& wb = world.getWorldBall();
+    snapshot.ball.valid = wb.getIsValid();
+    if (wb.getIsValid()) {
+        snapshot.ball.pos = wb.getPos();
+        snapshot.ball.vel = wb.getVel();
+        snapshot.ball.time = wb.getTime();
+    }
+
+    auto fillRobots = [](const std::vector<WorldRobot>& worldRobots,
+                         std::array<RobotState, Num_Shells>& robots) {
+        for (int i = 0; i < Num_Shells; i++) {
+            const WorldRobot& wr = worldRobots.at(i);
+
+            RobotState robot_state;
+            robot_state.visible = wr.getIsValid();
+            robot_state.velocity_valid = wr.getIsValid();
+
+            if (wr.getIsValid()) {
+                robot_state.pose = Geometry2d::Pose(wr.getPos(), wr.getTheta());
+                robot_state.velocity =
+                    Geometry2d::Twist(wr.getVel(), wr.getOmega());
+                robot_state.timestamp = wr.getTime();
+            }
+
+            robots.at(i) = robot_state;
         }
+    };
+
+    fillRobots(world.getRobotsYellow(), snapshot.robotsYellow);
+    fillRobots(world.getRobotsBlue(), snapshot.robotsBlue);
+
+    snapshot.newestFrame = newestFrame;
 
-        robot->mutable_state() = robot_state;
+    snapshots.publish();
+}
+
+bool VisionFilter::waitForUpdate(RJ::Time lastTick) {
+    const RJ::Seconds dt(*VisionFilterConfig::vision_loop_dt);
+    std::unique_lock<std::mutex> lock(wakeLock);
+
+    if (*VisionFilterConfig::event_driven) {
+        wake.wait_until(lock, lastTick + dt * MaxIdleTicks, [this]() {
+            return threadEnd.load() || !frameQueue.empty();
+        });
     }
+
+    // The filters assume updates are exactly loop_dt apart, so frames that
+    // arrive less than a tick after the last update wait for the next one
+    wake.wait_until(lock, lastTick + dt, [this]() { return threadEnd.load(); });
+
+    return !threadEnd.load();
 }
 
-void VisionFilter::updateLoop() {
-    while (!threadEnd.load(std::memory_order::memory_order_seq_cst)) {
-        RJ::Time start = RJ::now();
-
-        {
-            // Do update with whatever is in frame buffer
-            std::lock_guard<std::mutex> lock1(frameLock);
-            {
-                std::lock_guard<std::mutex> lock2(worldLock);
-
-                if (frameBuffer.size() > 0) {
-                    world.updateWithCameraFrame(RJ::now(), frameBuffer);
-                    frameBuffer.clear();
-                } else {
-                    world.updateWithoutCameraFrame(RJ::now());
-                }
-            }
+void VisionFilter::update(RJ::Time now, bool onTickGrid) {
+    TRACE_SCOPE("VisionFilter::update");
+    const RJ::Seconds dt(*VisionFilterConfig::vision_loop_dt);
+
+    if (onTickGrid) {
+        // Number of loop_dt ticks since the last update
+        int ticks = std::max(1, static_cast<int>((now - lastTick) / dt));
+
+        // Predict through the ticks that passed without frames so the
+        // filters stay on the same time base
+        for (int i = 1; i < std::min(ticks, MaxCatchUpTicks); i++) {
+            world.updateWithoutCameraFrame(lastTick + dt * i);
         }
+        lastTick = lastTick + dt * ticks;
+    } else {
+        lastTick = now;
+    }
 
-        // Wait for the correct loop timings
-        RJ::Seconds diff = RJ::now() - start;
-        RJ::Seconds sleepLeft = RJ::Seconds(*VisionFilterConfig::vision_loop_dt) - diff;
+    // Do update with whatever is in the frame queue
+    while (auto frame = frameQueue.tryPop()) {
+        frameBuffer.push_back(std::move(*frame));
+    }
+
+    if (frameBuffer.size() > 0) {
+        const CameraFrame& newest = *std::max_element(
+            frameBuffer.begin(), frameBuffer.end(),
+            [](const CameraFrame& a, const CameraFrame& b) {
+                return a.tCapture < b.tCapture;
+            });
+
+        world.updateWithCameraFrame(now, frameBuffer);
+
+        if (newest.tCapture > newestFrame.captured) {
+            newestFrame.captured = newest.tCapture;
+            newestFrame.received = newest.tReceived;
+            newestFrame.filtered = RJ::now();
+        }
+        frameBuffer.clear();
+    } else {
+        world.updateWithoutCameraFrame(now);
+    }
 
-        if (diff > RJ::Seconds(0)) {
-            std::this_thread::sleep_for(sleepLeft);
-        } else {
+    publishSnapshot();
+}
+
+void VisionFilter::updateLoop() {
+    Trace::setThreadName("VisionFilter");
+    lastTick = RJ::now();
+
+    while (waitForUpdate(lastTick)) {
+        const RJ::Time now = RJ::now();
+
+        update(now, *VisionFilterConfig::event_driven);
+
+        if (RJ::now() - now > RJ::Seconds(*VisionFilterConfig::vision_loop_dt)) {
             std::cout << "WARNING : Filter is not running fast enough" << std::endl;
         }
     }
-}
\ No newline at end of file
+}
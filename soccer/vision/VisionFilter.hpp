@@ -1,12 +1,17 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <condition_variable>
 #include <mutex>
 #include <vector>
-#include <vector>
 #include <thread>
 
+#include <Constants.hpp>
+#include <SpscQueue.hpp>
 #include <SystemState.hpp>
+#include <TripleBuffer.hpp>
+#include <WorldState.hpp>
 
 #include "vision/camera/CameraFrame.hpp"
 #include "vision/camera/World.hpp"
@@ -15,18 +20,41 @@
  * Uses a seperate thread to filter the vision measurements into
  * a smoother velocity/position estimate for both the ball and robots.
  *
- * Add vision frames directly into the filter call the fill states functions
- * to push the newest estimates directly into the system state.
+ * Add vision frames directly into the filter call fillStates() to push the
+ * newest estimates directly into the system state.
  * 
  * Note: There may be a 1 frame delay between the measurements being added
  * and the measurements being included in the filter estimate.
+ *
+ * The caller and the worker never wait on each other.  Frames are handed to the
+ * worker through a lock-free queue, and after each update the worker publishes
+ * a small snapshot of the estimates through a triple buffer, which
+ * fillStates() reads.  addFrames() and fillStates() must be called from the
+ * same thread.
+ *
+ * By default the worker updates every VisionFilter/loop_dt.  With
+ * VisionFilter/event_driven set, it sleeps until frames arrive and updates
+ * right away.  Between frames, fillStates() extrapolates the last
+ * estimate to SystemState::time instead of the worker predicting every loop.
+ *
+ * Without a worker, addFrames() runs the update itself on the same loop_dt
+ * grid, using RJ::now().  The estimates then only depend on the frames and
+ * the clock, which makes replay with an RJ::VirtualClock reproducible.
  */
 class VisionFilter {
 public:
+    /// When a camera frame was captured, received and filtered
+    struct FrameTiming {
+        RJ::Time captured;
+        RJ::Time received;
+        RJ::Time filtered;
+    };
+
     /**
-     * Starts a worker thread to do the vision processing
+     * @param threaded If true, starts a worker thread to do the vision
+     *        processing.  Otherwise it is done in addFrames().
      */
-    VisionFilter();
+    explicit VisionFilter(bool threaded = true);
     ~VisionFilter();
 
     /**
@@ -34,33 +62,102 @@ public:
      *
      * @param frames List of new frames
      */
-    void addFrames(const std::vector<CameraFrame>& frames);
+    void addFrames(std::vector<CameraFrame> frames);
 
     /**
-     * Fills system state with the ball pos/vel
+     * Fills system state with the ball and robots pos/vel, all from the same
+     * snapshot of the estimates
      *
      * @param state Current system state pointer
+     * @param usBlue True if we are blue
      */
-    void fillBallState(SystemState& state);
+    void fillStates(SystemState& state, bool usBlue);
 
     /**
-     * Fills system state with the robots pos/vel
-     *
-     * @param state Current system state pointer
-     * @param usBlue True if we are blue
+     * Timing of the newest frame behind the estimates used by the last call
+     * to fillStates().  All times are RJ::Time() until a frame has been
+     * filtered.
      */
-    void fillRobotState(SystemState& state, bool usBlue);
+    const FrameTiming& filledFrameTiming() const { return filledFrame; }
 
 private:
+    /**
+     * The estimates fillStates() needs, without the kalman filters behind
+     * them
+     */
+    struct Snapshot {
+        Ball ball;
+        std::array<RobotState, Num_Shells> robotsYellow;
+        std::array<RobotState, Num_Shells> robotsBlue;
+        FrameTiming newestFrame;
+    };
+
+    /**
+     * Fills system state with the ball pos/vel from @snapshot
+     */
+    static void fillBallState(SystemState& state, const Snapshot& snapshot);
+
+    /**
+     * Fills system state with the robots pos/vel from @snapshot
+     */
+    static void fillRobotState(SystemState& state, const Snapshot& snapshot,
+                               bool usBlue);
+
+    // Maximum number of frames waiting for the worker.
+    // About a second of frames from four cameras.
+    static constexpr size_t FrameQueueCapacity = 256;
+
+    // In event driven mode, the longest the worker sleeps without frames, in
+    // loop_dt ticks.  Filters still have to be predicted while nothing is
+    // seen so they time out.
+    static constexpr int MaxIdleTicks = 10;
+
+    // Most prediction passes run to catch up after sleeping.  A longer gap
+    // has already timed out every filter.
+    static constexpr int MaxCatchUpTicks = 100;
+
     void updateLoop();
 
+    /**
+     * Waits until the next update is due
+     *
+     * @param lastTick Time of the last update
+     * @return False if the thread should end
+     */
+    bool waitForUpdate(RJ::Time lastTick);
+
+    /**
+     * Runs the filters with the queued frames and publishes the result
+     *
+     * @param now Time of the update
+     * @param onTickGrid If true, first predicts through the loop_dt ticks
+     *        since the last update and keeps lastTick on that grid
+     */
+    void update(RJ::Time now, bool onTickGrid);
+
+    /**
+     * Copies the estimates from world into the next snapshot and publishes it
+     */
+    void publishSnapshot();
+
     std::thread worker;
 
-    std::mutex worldLock;
+    // Only used by the thread running updates
     World world;
+    std::vector<CameraFrame> frameBuffer;
+    RJ::Time lastTick;
+    FrameTiming newestFrame;
 
     std::atomic_bool threadEnd;
 
-    std::mutex frameLock;
-    std::vector<CameraFrame> frameBuffer;
+    // Wakes the worker for new frames or shutdown.  Only held while checking
+    // for those, never during an update.
+    std::mutex wakeLock;
+    std::condition_variable wake;
+
+    SpscQueue<CameraFrame> frameQueue;
+    TripleBuffer<Snapshot> snapshots;
+
+    // Only used by the thread calling fillStates()
+    FrameTiming filledFrame;
 };
\ No newline at end of file
@@ -19,18 +19,21 @@ public:
      * @param cameraBalls Unsorted list of ball detections
      * @param cameraRobotsYellow Unsorted list of yellow team robot detections
      * @param cameraRobotsBlue Unsorted list of blue team robot detections
+     * @param tReceived Time the frame's packet was received, if known
      */
     CameraFrame(RJ::Time tCapture,
                 int cameraID,
                 std::vector<CameraBall> cameraBalls,
                 std::vector<CameraRobot> cameraRobotsYellow,
-                std::vector<CameraRobot> cameraRobotsBlue)
-                : tCapture(tCapture), cameraID(cameraID),
+                std::vector<CameraRobot> cameraRobotsBlue,
+                RJ::Time tReceived = RJ::Time())
+                : tCapture(tCapture), tReceived(tReceived), cameraID(cameraID),
                   cameraBalls(cameraBalls),
                   cameraRobotsYellow(cameraRobotsYellow),
                   cameraRobotsBlue(cameraRobotsBlue) {}
 
     RJ::Time tCapture;
+    RJ::Time tReceived;
     int cameraID;
     std::vector<CameraBall> cameraBalls;
     std::vector<CameraRobot> cameraRobotsYellow;
@@ -27,62 +27,122 @@
  * x_k1_k1 is X_(k-1, k-1)
  * x_k_k is X_(k, k)
  * etc
+ *
+ * All matrices are sized at compile time so that predict / update
+ * never touch the heap. The innovation covariance is solved with a
+ * Cholesky decomposition instead of an explicit inverse.
+ *
+ * @tparam StateDim The size of the state vector
+ * @tparam ObsDim The size of the observation vector
  */
+template <int StateDim, int ObsDim>
 class KalmanFilter {
 public:
+    using StateVector = Eigen::Matrix<double, StateDim, 1>;
+    using ObsVector = Eigen::Matrix<double, ObsDim, 1>;
+    using InputVector = Eigen::Matrix<double, 1, 1>;
+
+    using StateMatrix = Eigen::Matrix<double, StateDim, StateDim>;
+    using ObsMatrix = Eigen::Matrix<double, ObsDim, ObsDim>;
+    using InputMatrix = Eigen::Matrix<double, StateDim, 1>;
+    using ObsModelMatrix = Eigen::Matrix<double, ObsDim, StateDim>;
+    using GainMatrix = Eigen::Matrix<double, StateDim, ObsDim>;
+
     /**
-     * Creates a general kalman filter with the given sizes
+     * Creates a general kalman filter with every matrix zeroed
      * Use a child class to setup the specific state matricies
      * Assumes 1 input
-     *
-     * @param stateSize The size of the state vector
-     * @param observationSize The size of the observation vector
      */
-    KalmanFilter(unsigned int stateSize, unsigned int observationSize) :
-        x_k1_k1(stateSize), x_k_k1(stateSize), x_k_k(stateSize),
-        u_k(1), z_k(observationSize),
-        y_k_k1(observationSize), y_k_k(observationSize),
-        P_k1_k1(stateSize, stateSize), P_k_k1(stateSize, stateSize), P_k_k(stateSize, stateSize),
-        S_k(observationSize, observationSize), K_k(stateSize, observationSize),
-        F_k(stateSize, stateSize), B_k(stateSize, 1), H_k(observationSize, stateSize),
-        Q_k(stateSize, stateSize), R_k(observationSize, observationSize),
-        I(Eigen::MatrixXd::Identity(stateSize, stateSize)) {}
+    KalmanFilter()
+        : x_k1_k1(StateVector::Zero()), x_k_k1(StateVector::Zero()),
+          x_k_k(StateVector::Zero()), u_k(InputVector::Zero()),
+          z_k(ObsVector::Zero()), y_k_k1(ObsVector::Zero()),
+          y_k_k(ObsVector::Zero()), P_k1_k1(StateMatrix::Zero()),
+          P_k_k1(StateMatrix::Zero()), P_k_k(StateMatrix::Zero()),
+          S_k(ObsMatrix::Zero()), K_k(GainMatrix::Zero()),
+          F_k(StateMatrix::Zero()), B_k(InputMatrix::Zero()),
+          H_k(ObsModelMatrix::Zero()), Q_k(StateMatrix::Zero()),
+          R_k(ObsMatrix::Zero()), I(StateMatrix::Identity()) {}
 
     /**
      * Predicts without update
      */
-    void predict();
+    void predict() {
+        x_k1_k1 = x_k_k;
+        P_k1_k1 = P_k_k;
+
+        // Predict
+        x_k_k1.noalias() = F_k * x_k1_k1 + B_k * u_k;
+        P_k_k1.noalias() = F_k * P_k1_k1 * F_k.transpose();
+        P_k_k1 += Q_k;
+
+        x_k_k = x_k_k1;
+        P_k_k = P_k_k1;
+    }
 
     /**
      * Predicts with update
      * z_k must be set with the observation
      */
-    void predictWithUpdate();
+    void predictWithUpdate() {
+        x_k1_k1 = x_k_k;
+        P_k1_k1 = P_k_k;
+
+        // Predict
+        x_k_k1.noalias() = F_k * x_k1_k1 + B_k * u_k;
+        P_k_k1.noalias() = F_k * P_k1_k1 * F_k.transpose();
+        P_k_k1 += Q_k;
+
+        // Update
+        y_k_k1.noalias() = z_k - H_k * x_k_k1;
+
+        S_k.noalias() = H_k * P_k_k1 * H_k.transpose();
+        S_k += R_k;
+
+        // K = P * H^T * S^-1
+        // Both P and S are symmetric, so K^T = S^-1 * H * P
+        // S is positive definite so a Cholesky solve is both cheaper and
+        // more stable than the explicit inverse
+        const Eigen::Matrix<double, ObsDim, StateDim> HP = H_k * P_k_k1;
+        K_k = S_k.llt().solve(HP).transpose();
+
+        x_k_k.noalias() = x_k_k1 + K_k * y_k_k1;
+
+        // Joseph form to keep P symmetric positive definite
+        const StateMatrix IKH = I - K_k * H_k;
+        P_k_k.noalias() = IKH * P_k_k1 * IKH.transpose();
+        P_k_k.noalias() += K_k * R_k * K_k.transpose();
+
+        y_k_k.noalias() = z_k - H_k * x_k_k;
+    }
 
 protected:
-    Eigen::VectorXd x_k1_k1;
-    Eigen::VectorXd x_k_k1;
-    Eigen::VectorXd x_k_k;
+    StateVector x_k1_k1;
+    StateVector x_k_k1;
+    StateVector x_k_k;
+
+    InputVector u_k;
+    ObsVector z_k;
 
-    Eigen::VectorXd u_k;
-    Eigen::VectorXd z_k;
+    ObsVector y_k_k1;
+    ObsVector y_k_k;
 
-    Eigen::VectorXd y_k_k1;
-    Eigen::VectorXd y_k_k;
+    StateMatrix P_k1_k1;
+    StateMatrix P_k_k1;
+    StateMatrix P_k_k;
 
-    Eigen::MatrixXd P_k1_k1;
-    Eigen::MatrixXd P_k_k1;
-    Eigen::MatrixXd P_k_k;
+    ObsMatrix S_k;
+    GainMatrix K_k;
 
-    Eigen::MatrixXd S_k;
-    Eigen::MatrixXd K_k;
+    StateMatrix F_k;
+    InputMatrix B_k;
+    ObsModelMatrix H_k;
 
-    Eigen::MatrixXd F_k;
-    Eigen::MatrixXd B_k;
-    Eigen::MatrixXd H_k;
+    StateMatrix Q_k;
+    ObsMatrix R_k;
 
-    Eigen::MatrixXd Q_k;
-    Eigen::MatrixXd R_k;
+    StateMatrix I;
 
-    Eigen::MatrixXd I;
-};
\ No newline at end of file
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
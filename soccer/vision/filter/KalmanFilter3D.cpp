@@ -18,11 +18,11 @@ void KalmanFilter3D::createConfiguration(Configuration* cfg) {
     orientation_scale = new ConfigDouble(cfg, "VisionFilter/Robot/orientation_scale", 1);
 }
 
-KalmanFilter3D::KalmanFilter3D() : KalmanFilter(1,1) {}
+KalmanFilter3D::KalmanFilter3D() : KalmanFilter() {}
 
 KalmanFilter3D::KalmanFilter3D(Geometry2d::Pose initPose,
                                Geometry2d::Twist initTwist)
-    : KalmanFilter(6, 3) {
+    : KalmanFilter() {
     // States are X pos, X vel, Y pos, Y vel, theta, omega
     x_k1_k1 << initPose.position().x(), initTwist.linear().x(),
         initPose.position().y(), initTwist.linear().y(), initPose.heading(),
@@ -104,7 +104,7 @@ void KalmanFilter3D::predictWithUpdate(Geometry2d::Pose observation) {
     z_k << observation.position().x(), observation.position().y(),
         observation.heading();
 
-    KalmanFilter::predictWithUpdate();
+    KalmanFilter<6, 3>::predictWithUpdate();
 }
 
 
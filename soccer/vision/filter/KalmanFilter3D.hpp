@@ -5,7 +5,7 @@
 #include <Geometry2d/Pose.hpp>
 #include "KalmanFilter.hpp"
 
-class KalmanFilter3D : public KalmanFilter {
+class KalmanFilter3D : public KalmanFilter<6, 3> {
 public:
     /**
      * Creates a kalman filter with all the parameters set to 0 (F_k etc)
@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+#include <Constants.hpp>
+#include "vision/ball/KalmanBall.hpp"
+#include "vision/ball/WorldBall.hpp"
+#include "vision/camera/CameraFrame.hpp"
+#include "vision/camera/World.hpp"
+#include "vision/robot/KalmanRobot.hpp"
+#include "vision/robot/WorldRobot.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Vision runs at 60Hz per camera
+const RJ::Seconds FramePeriod(1.0 / 60);
+
+/// Ball and robot positions at frame @n, moving smoothly with a little
+/// measurement noise, so the filters stay healthy and never reset
+Geometry2d::Point ballPos(int n, std::mt19937& rng) {
+    std::normal_distribution<double> noise(0, 0.002);
+    const double t = n / 60.0;
+    return Geometry2d::Point(2 * std::sin(t) + noise(rng),
+                             4.5 + 3 * std::cos(t) + noise(rng));
+}
+
+Geometry2d::Pose robotPose(int n, int id, std::mt19937& rng) {
+    std::normal_distribution<double> noise(0, 0.002);
+    const double t = n / 60.0 + id;
+    return Geometry2d::Pose(
+        Geometry2d::Point(0.5 * id - 1.5 + 0.3 * std::sin(t) + noise(rng),
+                          1 + id + 0.3 * std::cos(t) + noise(rng)),
+        t);
+}
+
+}  // namespace
+
+static void BM_KalmanBallPredict(benchmark::State& state) {
+    RJ::Time t = RJ::now();
+    std::mt19937 rng(0);
+    KalmanBall ball(0, t, CameraBall(t, ballPos(0, rng)), WorldBall());
+    for (auto _ : state) {
+        t = t + FramePeriod;
+        ball.predict(t);
+    }
+}
+BENCHMARK(BM_KalmanBallPredict);
+
+static void BM_KalmanBallPredictAndUpdate(benchmark::State& state) {
+    RJ::Time t = RJ::now();
+    std::mt19937 rng(0);
+    KalmanBall ball(0, t, CameraBall(t, ballPos(0, rng)), WorldBall());
+    int n = 0;
+    for (auto _ : state) {
+        t = t + FramePeriod;
+        ball.predictAndUpdate(t, CameraBall(t, ballPos(++n, rng)));
+    }
+}
+BENCHMARK(BM_KalmanBallPredictAndUpdate);
+
+static void BM_KalmanRobotPredict(benchmark::State& state) {
+    RJ::Time t = RJ::now();
+    std::mt19937 rng(0);
+    KalmanRobot robot(0, t, CameraRobot(t, robotPose(0, 0, rng), 0),
+                      WorldRobot());
+    for (auto _ : state) {
+        t = t + FramePeriod;
+        robot.predict(t);
+    }
+}
+BENCHMARK(BM_KalmanRobotPredict);
+
+static void BM_KalmanRobotPredictAndUpdate(benchmark::State& state) {
+    RJ::Time t = RJ::now();
+    std::mt19937 rng(0);
+    KalmanRobot robot(0, t, CameraRobot(t, robotPose(0, 0, rng), 0),
+                      WorldRobot());
+    int n = 0;
+    for (auto _ : state) {
+        t = t + FramePeriod;
+        robot.predictAndUpdate(t, CameraRobot(t, robotPose(++n, 0, rng), 0));
+    }
+}
+BENCHMARK(BM_KalmanRobotPredictAndUpdate);
+
+// One filter iteration with a frame from each of range(0) cameras, each seeing
+// the ball and a full team of each color.  The cameras overlap completely,
+// which is the worst case for merging their estimates.
+static void BM_WorldUpdateWithCameraFrame(benchmark::State& state) {
+    const int cameras = state.range(0);
+    std::mt19937 rng(0);
+
+    RJ::Time t = RJ::now();
+    World world;
+    std::vector<CameraFrame> frames;
+    int n = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        t = t + FramePeriod;
+        n++;
+        frames.clear();
+        for (int cam = 0; cam < cameras; cam++) {
+            std::vector<CameraRobot> yellow, blue;
+            for (int id = 0; id < (int)Robots_Per_Team; id++) {
+                yellow.emplace_back(t, robotPose(n, id, rng), id);
+                Geometry2d::Pose pose = robotPose(n, id, rng);
+                pose.position().x() *= -1;
+                blue.emplace_back(t, pose, id);
+            }
+            frames.emplace_back(t, cam,
+                                std::vector<CameraBall>{
+                                    CameraBall(t, ballPos(n, rng))},
+                                yellow, blue);
+        }
+        state.ResumeTiming();
+
+        world.updateWithCameraFrame(t, frames);
+    }
+}
+BENCHMARK(BM_WorldUpdateWithCameraFrame)
+    ->ArgName("cameras")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Unit(benchmark::kMicrosecond);
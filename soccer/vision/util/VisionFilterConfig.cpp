@@ -3,6 +3,7 @@
 REGISTER_CONFIGURABLE(VisionFilterConfig)
 
 ConfigDouble* VisionFilterConfig::vision_loop_dt;
+ConfigBool* VisionFilterConfig::event_driven;
 
 ConfigInt* VisionFilterConfig::max_num_cameras;
 
@@ -17,6 +18,7 @@ ConfigInt* VisionFilterConfig::fast_kick_detector_history_length;
 
 void VisionFilterConfig::createConfiguration(Configuration* cfg) {
     vision_loop_dt = new ConfigDouble(cfg, "VisionFilter/loop_dt", 1.0 / 100.0);
+    event_driven = new ConfigBool(cfg, "VisionFilter/event_driven", false);
 
     max_num_cameras = new ConfigInt(cfg, "VisionFilter/max_num_cameras", 12);
 
@@ -15,6 +15,9 @@ public:
     // 1/freq of the vision loop
     static ConfigDouble* vision_loop_dt;
 
+    // Update as soon as frames arrive instead of polling every loop_dt
+    static ConfigBool* event_driven;
+
     // Max number of cameras possible on the field
     static ConfigInt* max_num_cameras;
 